@@ -10,10 +10,15 @@
 
 #include "Game_Scene.hpp"
 #include "Menu_Scene.hpp"
+#include "atlases/game_atlas.hpp"
+#include "atlases/pause_atlas.hpp"
 
+#include <cmath>
 #include <cstdlib>
+#include <basics/Allocation_Tracker>
 #include <basics/Canvas>
 #include <basics/Director>
+#include <basics/fnv>
 
 using namespace basics;
 using namespace std;
@@ -23,6 +28,8 @@ namespace example {
     // ---------------------------------------------------------------------------------------------
     bool Game_Scene::initialize () {
         //state = LOADING;
+        // La semilla la proporciona el Director para que una sesión grabada se pueda repetir:
+        srand (director.make_random_seed ());
         for(auto & button : buttons){
             button.isPressed = false;
         }
@@ -60,8 +67,13 @@ namespace example {
 
     // ---------------------------------------------------------------------------------------------
     void Game_Scene::update (float time) {
+        // Mientras se juega no se debe reservar memoria. Los menús de pausa y de fin de partida sí
+        // lo hacen al crear la escena a la que se pasa:
+        BASICS_ASSERT_NO_ALLOCATIONS (state == RUNNING ? "Game_Scene::update" : nullptr);
+
         if (!suspended) switch (state) {
-                case LOADING:       load_textures();        break;
+                case LOADING:       loadingTime += time;
+                                    load_textures();        break;
                 case RUNNING:
                 case PAUSED:
                 case OVER :         run_simulation(time);   break;
@@ -78,18 +90,52 @@ namespace example {
             }
 
             if (canvas) {
-                canvas->clear ();
-                switch (state) {
-                    case LOADING:   render_loading (*canvas);   break;
-                    case RUNNING:   render_playfield (*canvas); break;
-                    case PAUSED:    render_pause (*canvas);     break;
-                    case OVER:      render_over (*canvas);      break;
-                    case ERROR:                                 break;
-                }
+                BASICS_ASSERT_NO_ALLOCATIONS (state != LOADING ? "Game_Scene::render" : nullptr);
+                draw (*canvas);
             }
         }
     }
 
+    // ---------------------------------------------------------------------------------------------
+    void Game_Scene::record (Display_List & display_list) {
+        if (!suspended) {
+            display_list.set_size ({ canvas_width, canvas_height });
+            draw (display_list);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    /**
+     * Dibuja el fotograma según el estado de la escena, tanto en el canvas del contexto gráfico
+     * como en la lista que reproduce el hilo de render.
+     */
+    void Game_Scene::draw (Canvas & canvas) {
+        canvas.clear ();
+        switch (state) {
+            case LOADING:   render_loading (canvas);   break;
+            case RUNNING:   render_playfield (canvas); break;
+            case PAUSED:    render_pause (canvas);     break;
+            case OVER:      render_over (canvas);      break;
+            case ERROR:                                break;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    uint32_t Game_Scene::get_checksum () {
+        uint32_t checksum = fnv32 (&state, sizeof(state));
+        checksum = fnv32 (&speedY,  sizeof(speedY),  checksum);
+        checksum = fnv32 (&iSRight, sizeof(iSRight), checksum);
+        // Mientras se cargan los atlas los sprites todavía no tienen posición:
+        if (state == LOADING) return checksum;
+        for (const auto & sprite : sprites) {
+            checksum = fnv32 (&sprite.position, sizeof(sprite.position), checksum);
+        }
+        for (const auto & platform : platforms) {
+            checksum = fnv32 (&platform.position, sizeof(platform.position), checksum);
+        }
+        return checksum;
+    }
+
     // ---------------------------------------------------------------------------------------------
     /**
      * Este método se encarga de comprobar sobre que opción ha pulsado el jugador
@@ -129,15 +175,22 @@ namespace example {
 
     // ---------------------------------------------------------------------------------------------
     /**
-     * Este método carga las texturas del atlas del menú
+     * Este método pide los atlas del juego y del menú al cargador del Director, que los lee y
+     * decodifica en otros hilos, y pasa al juego en cuanto están los dos.
      */
     void Game_Scene::load_textures () {
         if(state == LOADING) {
-            Graphics_Context::Accessor context = director.lock_graphics_context();
-            if (context) {
-                atlas.reset(new Atlas("game-scene/game.sprites", context));
-                menuAtlas.reset(new Atlas("game-scene/pause.sprites", context));
-                state = atlas->good() ? (menuAtlas->good() ? RUNNING : ERROR) : ERROR;
+            if (!atlasRequest.valid()) {
+                Asset_Loader & loader = director.get_asset_loader();
+                atlasRequest     = loader.load_atlas("game-scene/game.atlas");
+                menuAtlasRequest = loader.load_atlas("game-scene/pause.atlas");
+            }
+            if (atlasRequest.is_ready() && menuAtlasRequest.is_ready()) {
+                atlas     = atlasRequest.get();
+                menuAtlas = menuAtlasRequest.get();
+                // Los sprites se toman con los índices generados a partir de los .sprites, que
+                // solo son válidos si los atlas cargados son los mismos:
+                state = atlas && game_atlas::matches(*atlas) && menuAtlas && pause_atlas::matches(*menuAtlas) ? RUNNING : ERROR;
                 if (state == RUNNING) {
                     create_sprites();
 
@@ -152,15 +205,15 @@ namespace example {
      */
     void Game_Scene::create_sprites () {
 
-        sprites[BACKGROUND].slice       = atlas->get_slice(ID(background));
-        sprites[TOP].slice              = atlas->get_slice(ID(top));
-        sprites[DOWN].slice             = atlas->get_slice(ID(down));
-        sprites[PLATFORM].slice         = atlas->get_slice(ID(platform));
-        sprites[CHARACTER].slice        = atlas->get_slice(ID(character));
+        sprites[BACKGROUND].slice       = &(*atlas)[game_atlas::background];
+        sprites[TOP].slice              = &(*atlas)[game_atlas::top];
+        sprites[DOWN].slice             = &(*atlas)[game_atlas::down];
+        sprites[PLATFORM].slice         = &(*atlas)[game_atlas::platform];
+        sprites[CHARACTER].slice        = &(*atlas)[game_atlas::character];
 
-        buttons[LEFT].slice             = atlas->get_slice(ID(left));
-        buttons[RIGHT].slice            = atlas->get_slice(ID(right));
-        buttons[PAUSE].slice            = atlas->get_slice(ID(pause));
+        buttons[LEFT].slice             = &(*atlas)[game_atlas::left];
+        buttons[RIGHT].slice            = &(*atlas)[game_atlas::right];
+        buttons[PAUSE].slice            = &(*atlas)[game_atlas::pause];
 
 
         sprites[TOP].position           = Point2f(sprites[TOP].slice->width/2, canvas_height-sprites[TOP].slice->height/2);
@@ -169,14 +222,18 @@ namespace example {
         sprites[PLATFORM].position      = Point2f(0, 0);
         sprites[CHARACTER].position     = Point2f(500, 800);
 
+        for(auto & sprite : sprites) sprite.previous = sprite.position;
+
         buttons[LEFT].position          = Point2f(buttons[LEFT].slice->width, buttons[LEFT].slice->height/1.5f);
         buttons[RIGHT].position         = Point2f(canvas_width-buttons[RIGHT].slice->width, buttons[RIGHT].slice->height/1.5f);
         buttons[PAUSE].position         = Point2f(canvas_width-buttons[RIGHT].slice->width, sprites[TOP].position[1]);
 
-        menuSprites[BACKGROUND_PAUSE].slice     = menuAtlas->get_slice(ID(background));
-        menuButtons[PLAY].slice                 = menuAtlas->get_slice(ID(resume));
-        menuButtons[MENU].slice                 = menuAtlas->get_slice(ID(menu));
-        menuSprites[TITLE].slice                = menuAtlas->get_slice(ID(title_pause));
+        menuSprites[BACKGROUND_PAUSE].slice     = &(*menuAtlas)[pause_atlas::background];
+        menuButtons[PLAY].slice                 = &(*menuAtlas)[pause_atlas::resume];
+        menuButtons[MENU].slice                 = &(*menuAtlas)[pause_atlas::menu];
+        menuSprites[TITLE].slice                = &(*menuAtlas)[pause_atlas::title_pause];
+        playAgainSlice                          = &(*menuAtlas)[pause_atlas::play_again];
+        titleOverSlice                          = &(*menuAtlas)[pause_atlas::title_over];
 
         menuSprites[BACKGROUND_PAUSE].position  = Point2f(canvas_width/2, canvas_height/2);
         menuButtons [PLAY].position             = Point2f(canvas_width/2, canvas_height/2);
@@ -211,6 +268,10 @@ namespace example {
      * @param time
      */
     void Game_Scene::update_user (float time) {
+        BASICS_ASSERT_NO_ALLOCATIONS ("Game_Scene::update_user");
+        // Se guardan las posiciones del paso anterior para interpolar entre ellas al dibujar:
+        sprites[CHARACTER].previous = sprites[CHARACTER].position;
+        for(auto & platform : platforms) platform.previous = platform.position;
         sprites[CHARACTER].position[1] += speedY*time + 0.5f*gravity*time*time;
         speedY += gravity;
         if(speedY<0 &&
@@ -234,9 +295,11 @@ namespace example {
 
         if(sprites[CHARACTER].position[0] < 0){
             sprites[CHARACTER].position[0] = canvas_width;
+            sprites[CHARACTER].previous[0] = canvas_width;    // Aparece en el otro lado sin desplazarse
         }
         if(sprites[CHARACTER].position[0] > canvas_width){
             sprites[CHARACTER].position[0] = 0.f;
+            sprites[CHARACTER].previous[0] = 0.f;
         }
 
         if(sprites[CHARACTER].position[1] < sprites[DOWN].position[1]+sprites[DOWN].slice->height/2){
@@ -271,20 +334,24 @@ namespace example {
 
     // ---------------------------------------------------------------------------------------------
     /**
-     * Este método es el encargado de renderizar el Loading durante la carga de los sprites.
+     * Este método es el encargado de renderizar el Loading durante la carga de los sprites. Como
+     * los atlas aún no están disponibles, se dibuja una barra que se llena con cada atlas cargado
+     * y un bloque que la recorre mientras tanto.
      * @param canvas
      */
     void Game_Scene::render_loading (Canvas & canvas) {
         if(state == LOADING){
-            const Atlas::Slice * slice = atlas->get_slice(ID(loading));
-            if (slice) {
-                canvas.fill_rectangle
-                        (
-                                { canvas_width * .5f, canvas_height * .5f },
-                                { slice->width, slice->height},
-                                slice
-                        );
-            }
+            float width  = canvas_width * .6f;
+            float height = 24.f;
+            float left   = (canvas_width  - width ) * .5f;
+            float bottom = (canvas_height - height) * .5f;
+            float loaded = float(atlasRequest.is_ready()) + float(menuAtlasRequest.is_ready());
+            float cycle  = loadingTime - std::floor(loadingTime);
+
+            canvas.set_color (1, 1, 1);
+            canvas.draw_rectangle ({ left, bottom }, { width, height });
+            canvas.fill_rectangle ({ left, bottom }, { width * loaded * .5f, height });
+            canvas.fill_rectangle ({ left + (width - height) * cycle, bottom - height * 2.f }, { height, height });
         }
 
     }
@@ -296,14 +363,20 @@ namespace example {
      * @param canvas
      */
     void Game_Scene::render_playfield (Canvas & canvas) {
+        BASICS_ASSERT_NO_ALLOCATIONS ("Game_Scene::render_playfield");
         canvas.clear();
         if(state == RUNNING){
+            // La física avanza en pasos fijos, por lo que los elementos que se mueven se dibujan
+            // entre su posición anterior y la actual para que no salten:
+            float alpha = get_interpolation ();
+
             canvas.fill_rectangle ({ sprites[BACKGROUND].position[0], sprites[BACKGROUND].position[1] },
                                    { sprites[BACKGROUND].slice->width, sprites[BACKGROUND].slice->height },
                                    sprites[BACKGROUND].slice);
             for(auto & platform : platforms){
-                if(platform.position[1]<sprites[TOP].position[1]){
-                    canvas.fill_rectangle ({ platform.position[0], platform.position[1] },
+                Point2f position = platform.interpolate (alpha);
+                if(position[1]<sprites[TOP].position[1]){
+                    canvas.fill_rectangle ({ position[0], position[1] },
                                            { platform.slice->width, platform.slice->height },
                                            platform.slice);
                 }
@@ -311,12 +384,13 @@ namespace example {
             }
             for(auto & element : sprites){
                 if(element.slice && element.slice!=sprites[PLATFORM].slice && element.slice!=sprites[BACKGROUND].slice){
+                    Point2f position = element.interpolate (alpha);
                     if(element.slice != sprites[CHARACTER].slice || (element.slice == sprites[CHARACTER].slice && iSRight)){
-                        canvas.fill_rectangle ({ element.position[0], element.position[1] },
+                        canvas.fill_rectangle ({ position[0], position[1] },
                                                { element.slice->width, element.slice->height },
                                                element.slice);
                     }else if(element.slice == sprites[CHARACTER].slice && !iSRight){
-                        canvas.fill_rectangle ({ element.position[0], element.position[1] },
+                        canvas.fill_rectangle ({ position[0], position[1] },
                                                { element.slice->width, element.slice->height },
                                                element.slice, FLIP_HORIZONTAL);
                     }
@@ -358,8 +432,8 @@ namespace example {
      * @param canvas
      */
     void Game_Scene::render_over(Canvas & canvas){
-        menuButtons[PLAY].slice     = menuAtlas->get_slice(ID(play_again));
-        menuSprites[TITLE].slice    = menuAtlas->get_slice(ID(title_over));
+        menuButtons[PLAY].slice     = playAgainSlice;
+        menuSprites[TITLE].slice    = titleOverSlice;
         render_pause(canvas);
     }
 
@@ -374,6 +448,7 @@ namespace example {
             platforms[index].slice = tempSlice;
             platforms[index].position[0] = 3 + rand()%(canvas_width - 3);
             platforms[index].position[1] = sprites[DOWN].slice->height + rand()%(tempN - (int)sprites[DOWN].slice->height);
+            platforms[index].previous    = platforms[index].position;
         }
     }
 
@@ -413,6 +488,7 @@ namespace example {
     void Game_Scene::refresh_platforms(Element & platform) {
         platform.position[0] = 3 + rand()%(canvas_width - 3);
         platform.position[1] = sprites[TOP].position[1] + rand()%(canvas_height+1-(int)sprites[TOP].position[1]);
+        platform.previous    = platform.position;  // Aparece arriba sin recorrer la pantalla
     }
 
 }
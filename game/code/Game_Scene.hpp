@@ -15,12 +15,14 @@
 #include <memory>
 #include <basics/Canvas>
 #include <basics/Scene>
+#include <basics/Asset_Loader>
 #include <basics/Atlas>
 #include <basics/Timer>
 
 namespace example {
 
     using basics::Canvas;
+    using basics::Display_List;
     using basics::Atlas;
     using basics::Point2f;
     using basics::Timer;
@@ -28,8 +30,12 @@ namespace example {
     class Game_Scene : public basics::Scene {
 
         typedef basics::Graphics_Context::Accessor Context; ///< Contexto de la escena
-        std::unique_ptr< Atlas > atlas;                     ///< Atlas de sprites del juego
-        std::unique_ptr< Atlas > menuAtlas;                 ///< Atlas de botones de los menus
+        std::shared_ptr< Atlas > atlas;                     ///< Atlas de sprites del juego
+        std::shared_ptr< Atlas > menuAtlas;                 ///< Atlas de botones de los menus
+
+        basics::Asset_Loader::Atlas_Handle atlasRequest;    ///< Carga en curso del atlas del juego
+        basics::Asset_Loader::Atlas_Handle menuAtlasRequest;///< Carga en curso del atlas de los menus
+        float loadingTime;                                  ///< Segundos que lleva la carga
 
         /**
         * Representa el estado de la escena en su conjunto.
@@ -107,8 +113,18 @@ namespace example {
         public:
             const Atlas::Slice * slice;
             Point2f position;
+            Point2f previous;           ///< Posición tras el paso de simulación anterior.
 
         public:
+            /**
+             * Retorna la posición en la que se debe dibujar: entre la del paso anterior y la actual
+             * según la fracción del siguiente paso que ya ha transcurrido (get_interpolation()).
+             */
+            Point2f interpolate (float alpha) const {
+                return Point2f(previous[0] + (position[0] - previous[0]) * alpha,
+                               previous[1] + (position[1] - previous[1]) * alpha);
+            }
+
             bool intersects (Element & other){
                 float this_left    = this->position[0];
                 float this_bottom  = this->position[1];
@@ -143,6 +159,9 @@ namespace example {
         Element platforms[nPlatforms];          ///< Array de plataformas
         Element menuSprites[nMenu];             ///< Array de sprites en el menu Game-Over/Pausa
 
+        const Atlas::Slice * playAgainSlice;    ///< Botón del menu Game-Over, que sustituye al de continuar
+        const Atlas::Slice * titleOverSlice;    ///< Título del menu Game-Over, que sustituye al de pausa
+
     public:
 
         // -------------------------------------------------------------------------------------
@@ -152,11 +171,14 @@ namespace example {
         Game_Scene(){
             state = LOADING;
             suspended = true;
+            loadingTime = 0.f;
             canvas_width  = 720;
             canvas_height =  1280;
             speedY = 500;
             iSRight = true;
-            srand (unsigned(time(nullptr)));
+            playAgainSlice = nullptr;
+            titleOverSlice = nullptr;
+            set_update_rate (60);     // La física avanza en pasos fijos sea cual sea la tasa de frames
         };
 
         // -------------------------------------------------------------------------------------
@@ -212,6 +234,26 @@ namespace example {
          */
         void render (Context & context) override;
 
+        // -------------------------------------------------------------------------------------
+        /**
+         * La escena se puede dibujar desde el hilo de render del director: en ese caso, en lugar
+         * de render() se invoca record() para que registre en la lista lo mismo que dibujaría.
+         */
+        bool is_recordable () const override
+        {
+            return true;
+        }
+
+        // -------------------------------------------------------------------------------------
+        void record (Display_List & display_list) override;
+
+        // -------------------------------------------------------------------------------------
+        /**
+         * Resume en un número el estado de la simulación para comprobar que una sesión repetida
+         * se comporta igual que la original.
+         */
+        uint32_t get_checksum () override;
+
     private:
 
         // -------------------------------------------------------------------------------------
@@ -227,6 +269,8 @@ namespace example {
         // -------------------------------------------------------------------------------------
         void update_menu();
         // -------------------------------------------------------------------------------------
+        void draw (Canvas & canvas);
+        // -------------------------------------------------------------------------------------
         void render_loading (Canvas & canvas);
         // -------------------------------------------------------------------------------------
         void render_playfield (Canvas & canvas);
@@ -11,6 +11,7 @@
 
 #include "Menu_Scene.hpp"
 #include "Game_Scene.hpp"
+#include "atlases/menu_atlas.hpp"
 
 #include <basics/Director>
 #include <basics/Canvas>
@@ -115,8 +116,8 @@ namespace example {
         if(state == LOADING){
             Graphics_Context::Accessor context = director.lock_graphics_context();
             if (context) {
-                atlas.reset(new Atlas("menu-scene/menu.sprites", context));
-                state = atlas->good() ? RUNNING : ERROR;
+                atlas = director.get_asset_cache().load_atlas("menu-scene/menu.atlas", context);
+                state = atlas && menu_atlas::matches(*atlas) ? RUNNING : ERROR;
                 if(state == RUNNING){
                     create_sprites();
                 }
@@ -129,14 +130,14 @@ namespace example {
      * Este método se encarga de crear los sprites y botones y asignarles una posicion en el canvas
      */
     void Menu_Scene::create_sprites() {
-        sprites[TITLE].slice            = atlas->get_slice(ID(title));
-        sprites[BACKGROUND].slice       = atlas->get_slice(ID(background));
-        sprites[TEXT_HELP].slice        = atlas->get_slice(ID(text_help));
-
-        options[PLAY].slice             = atlas->get_slice(ID(play));
-        options[HELP].slice             = atlas->get_slice(ID(help));
-        options[EXIT].slice             = atlas->get_slice(ID(exit));
-        options[BACK].slice             = atlas->get_slice(ID(back));
+        sprites[TITLE].slice            = &(*atlas)[menu_atlas::title];
+        sprites[BACKGROUND].slice       = &(*atlas)[menu_atlas::background];
+        sprites[TEXT_HELP].slice        = &(*atlas)[menu_atlas::text_help];
+
+        options[PLAY].slice             = &(*atlas)[menu_atlas::play];
+        options[HELP].slice             = &(*atlas)[menu_atlas::help];
+        options[EXIT].slice             = &(*atlas)[menu_atlas::exit];
+        options[BACK].slice             = &(*atlas)[menu_atlas::back];
 
         sprites[TITLE].position         = Point2f(canvas_width/2, canvas_height-sprites[TITLE].slice->height*2.f);
         sprites[BACKGROUND].position    = Point2f(canvas_width/2, canvas_height/2);
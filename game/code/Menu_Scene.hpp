@@ -88,7 +88,7 @@ namespace example {
         Option options[nOptions];               ///< Array de botones que se mostrarán en el menú.
         Element sprites[nSprites];              ///< Array de Sprites simples
 
-        std::unique_ptr< Atlas > atlas;         ///< Atlas de sprites
+        std::shared_ptr< Atlas > atlas;         ///< Atlas de sprites
 
     public:
 
@@ -0,0 +1,185 @@
+/*
+ * PLATFORM FIELD SCENE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include "Platform_Field_Scene.hpp"
+#include "atlases/game_atlas.hpp"
+#include <algorithm>
+#include <functional>
+
+using namespace basics;
+using namespace std;
+
+namespace example
+{
+
+    constexpr float    Platform_Field_Scene::gravity;
+    constexpr float    Platform_Field_Scene::jump_speed;
+    constexpr unsigned Platform_Field_Scene::cell_size;
+
+    // ---------------------------------------------------------------------------------------------
+    void Platform_Field_Scene::spawn (unsigned count) {
+        const Atlas::Slice * platform  = &(*atlas)[game_atlas::platform];
+        const Atlas::Slice * character = &(*atlas)[game_atlas::character];
+
+        platforms.resize (count / 2);
+        jumpers  .resize (count - count / 2);
+
+        for (Body & body : platforms) {
+            body.slice    = platform;
+            body.position = { random_between (0.f, float(canvas_width)), random_between (0.f, float(canvas_height)) };
+            body.speed    = { 0.f, 0.f };
+        }
+
+        for (Body & body : jumpers) {
+            body.slice    = character;
+            body.position = { random_between (0.f, float(canvas_width)), random_between (0.f, float(canvas_height)) };
+            body.speed    = { random_between (-200.f, 200.f), 0.f };
+        }
+
+        build_grid ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    void Platform_Field_Scene::simulate (float time) {
+        float width  = float(canvas_width );
+        float height = float(canvas_height);
+
+        for (Body & jumper : jumpers) {
+            jumper.position[0] += jumper.speed[0] * time;
+            jumper.position[1] += jumper.speed[1] * time + 0.5f * gravity * time * time;
+            jumper.speed   [1] += gravity * time;
+
+            // Igual que en Game_Scene, solo se rebota al caer sobre una plataforma:
+
+            if (jumper.speed[1] < 0.f && find_landing (jumper)) {
+                jumper.speed[1] = jump_speed;
+            }
+
+            if (jumper.position[0] < 0.f  ) jumper.position[0] = width;
+            if (jumper.position[0] > width) jumper.position[0] = 0.f;
+
+            if (jumper.position[1] < 0.f) {
+                jumper.position[1] = height;
+                jumper.speed   [1] = 0.f;
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    void Platform_Field_Scene::draw (Canvas & canvas) {
+        for (const Body & platform : platforms) {
+            canvas.fill_rectangle (platform.position, { platform.slice->width, platform.slice->height }, platform.slice);
+        }
+
+        for (const Body & jumper : jumpers) {
+            canvas.fill_rectangle
+            (
+                jumper.position,
+                { jumper.slice->width, jumper.slice->height },
+                jumper.slice,
+                jumper.speed[0] < 0.f ? int(FLIP_HORIZONTAL) : int(CENTER)
+            );
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    /**
+     * Reparte las plataformas entre las celdas de la rejilla que tocan. Como las plataformas no se
+     * mueven, basta con hacerlo una vez por etapa.
+     */
+    void Platform_Field_Scene::build_grid () {
+        grid_columns = (canvas_width  + cell_size - 1) / cell_size;
+        grid_rows    = (canvas_height + cell_size - 1) / cell_size;
+
+        cell_starts.assign (grid_columns * grid_rows + 1, 0);
+        cell_items .clear  ();
+
+        if (collisions != GRID) return;
+
+        auto for_each_cell = [this] (const Body & body, const std::function< void (unsigned) > & action) {
+            float half_width  = body.slice->width  * .5f;
+            float half_height = body.slice->height * .5f;
+            int   first_x = std::max (int((body.position[0] - half_width ) / cell_size), 0);
+            int   last_x  = std::min (int((body.position[0] + half_width ) / cell_size), int(grid_columns) - 1);
+            int   first_y = std::max (int((body.position[1] - half_height) / cell_size), 0);
+            int   last_y  = std::min (int((body.position[1] + half_height) / cell_size), int(grid_rows   ) - 1);
+
+            for (int y = first_y; y <= last_y; ++y) {
+                for (int x = first_x; x <= last_x; ++x) {
+                    action (unsigned(y) * grid_columns + unsigned(x));
+                }
+            }
+        };
+
+        // Primero se cuentan las plataformas de cada celda y después se colocan sus índices:
+
+        for (const Body & platform : platforms) {
+            for_each_cell (platform, [this] (unsigned cell) { cell_starts[cell + 1]++; });
+        }
+
+        for (size_t cell = 1; cell < cell_starts.size (); ++cell) {
+            cell_starts[cell] += cell_starts[cell - 1];
+        }
+
+        std::vector< unsigned > cursors(cell_starts.begin (), cell_starts.end () - 1);
+
+        cell_items.resize (cell_starts.back ());
+
+        for (unsigned index = 0; index < platforms.size (); ++index) {
+            for_each_cell (platforms[index], [this, &cursors, index] (unsigned cell) { cell_items[cursors[cell]++] = index; });
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    bool Platform_Field_Scene::lands_on (const Body & jumper, const Body & platform) const {
+        // Los pies del personaje deben estar dentro de la plataforma (así ambas estrategias de
+        // colisión dan el mismo resultado):
+
+        float distance_x = jumper.position[0] - platform.position[0];
+        float limit_x    = (jumper.slice->width + platform.slice->width) * .5f;
+        float bottom     = jumper.position[1] - jumper.slice->height * .5f;
+        float distance_y = bottom - platform.position[1];
+        float limit_y    = platform.slice->height * .5f;
+
+        return distance_x < limit_x && distance_x > -limit_x && distance_y <= limit_y && distance_y >= -limit_y;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    bool Platform_Field_Scene::find_landing (const Body & jumper) const {
+        if (collisions == BRUTE_FORCE) {
+            for (const Body & platform : platforms) {
+                if (lands_on (jumper, platform)) return true;
+            }
+            return false;
+        }
+
+        // Solo se revisan las celdas que toca la parte inferior del personaje:
+
+        float half_width = jumper.slice->width * .5f;
+        float bottom     = jumper.position[1] - jumper.slice->height * .5f;
+        int   row        = int(bottom / cell_size);
+
+        if (row < 0 || row >= int(grid_rows)) return false;
+
+        int first_x = std::max (int((jumper.position[0] - half_width) / cell_size), 0);
+        int last_x  = std::min (int((jumper.position[0] + half_width) / cell_size), int(grid_columns) - 1);
+
+        for (int x = first_x; x <= last_x; ++x) {
+            unsigned cell = unsigned(row) * grid_columns + unsigned(x);
+
+            for (unsigned item = cell_starts[cell]; item < cell_starts[cell + 1]; ++item) {
+                if (lands_on (jumper, platforms[cell_items[item]])) return true;
+            }
+        }
+
+        return false;
+    }
+
+}
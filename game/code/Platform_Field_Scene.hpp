@@ -0,0 +1,94 @@
+/*
+ * PLATFORM FIELD SCENE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef PLATFORM_FIELD_SCENE_HEADER
+#define PLATFORM_FIELD_SCENE_HEADER
+
+#include <vector>
+#include <basics/Vector>
+#include "Stress_Scene.hpp"
+
+    namespace example {
+
+        using basics::Point2f;
+        using basics::Vector2f;
+
+        /**
+         * Prueba de carga de la simulación: la mitad de las entidades son plataformas fijas y la
+         * otra mitad personajes que caen, rebotan sobre las plataformas como en Game_Scene y se
+         * voltean según la dirección en la que avanzan. Las colisiones se pueden comprobar contra
+         * todas las plataformas o solo contra las de las celdas de una rejilla uniforme.
+         */
+        class Platform_Field_Scene : public Stress_Scene {
+        public:
+
+            enum Collisions {
+                BRUTE_FORCE,                            ///< Cada personaje con cada plataforma.
+                GRID                                    ///< Solo las plataformas de las celdas cercanas.
+            };
+
+        private:
+
+            struct Body {
+                const Atlas::Slice * slice;
+                Point2f  position;                      ///< Centro del sprite.
+                Vector2f speed;
+            };
+
+            static constexpr float    gravity    = -980.f;
+            static constexpr float    jump_speed =  900.f;
+            static constexpr unsigned cell_size  =   64;
+
+        private:
+
+            Collisions          collisions;
+
+            std::vector< Body > platforms;
+            std::vector< Body > jumpers;
+
+            // Rejilla de plataformas: las de la celda i son cell_items[cell_starts[i]..cell_starts[i + 1]):
+
+            unsigned                grid_columns;
+            unsigned                grid_rows;
+            std::vector< unsigned > cell_starts;
+            std::vector< unsigned > cell_items;
+
+        public:
+
+            Platform_Field_Scene(const Options & options, Collisions collisions = GRID)
+            :
+                Stress_Scene(options),
+                collisions  (collisions),
+                grid_columns(0),
+                grid_rows   (0)
+            {
+            }
+
+        protected:
+
+            const char * get_name () const override {
+                return collisions == GRID ? "platform field (grid)" : "platform field (brute force)";
+            }
+
+            void spawn    (unsigned count) override;
+            void simulate (float time) override;
+            void draw     (Canvas & canvas) override;
+
+        private:
+
+            void build_grid ();
+            bool lands_on   (const Body & jumper, const Body & platform) const;
+            bool find_landing (const Body & jumper) const;
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,73 @@
+/*
+ * SPRITE STORM SCENE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include "Sprite_Storm_Scene.hpp"
+#include "atlases/game_atlas.hpp"
+
+using namespace basics;
+using namespace std;
+
+namespace example
+{
+
+    // ---------------------------------------------------------------------------------------------
+    void Sprite_Storm_Scene::spawn (unsigned count) {
+        const Atlas::Slice * slices[] =
+        {
+            &(*atlas)[game_atlas::character],
+            &(*atlas)[game_atlas::platform],
+            &(*atlas)[game_atlas::left],
+            &(*atlas)[game_atlas::right],
+            &(*atlas)[game_atlas::pause],
+        };
+
+        particles.resize (count);
+
+        for (unsigned index = 0; index < count; ++index) {
+            Particle & particle = particles[index];
+
+            particle.slice    = slices[index % (sizeof(slices) / sizeof(slices[0]))];
+            particle.position = { random_between (0.f, float(canvas_width)), random_between (0.f, float(canvas_height)) };
+            particle.speed    = { random_between (-300.f, 300.f), random_between (-300.f, 300.f) };
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    void Sprite_Storm_Scene::simulate (float time) {
+        float width  = float(canvas_width );
+        float height = float(canvas_height);
+
+        for (Particle & particle : particles) {
+            particle.position[0] += particle.speed[0] * time;
+            particle.position[1] += particle.speed[1] * time;
+
+            // Al chocar con un borde se invierte la velocidad, lo que también voltea el sprite:
+
+            if (particle.position[0] < 0.f   ) { particle.position[0] = 0.f;    particle.speed[0] = -particle.speed[0]; }
+            if (particle.position[0] > width ) { particle.position[0] = width;  particle.speed[0] = -particle.speed[0]; }
+            if (particle.position[1] < 0.f   ) { particle.position[1] = 0.f;    particle.speed[1] = -particle.speed[1]; }
+            if (particle.position[1] > height) { particle.position[1] = height; particle.speed[1] = -particle.speed[1]; }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    void Sprite_Storm_Scene::draw (Canvas & canvas) {
+        for (const Particle & particle : particles) {
+            canvas.fill_rectangle
+            (
+                particle.position,
+                { particle.slice->width, particle.slice->height },
+                particle.slice,
+                particle.speed[0] < 0.f ? int(FLIP_HORIZONTAL) : int(CENTER)
+            );
+        }
+    }
+
+}
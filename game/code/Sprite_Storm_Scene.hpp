@@ -0,0 +1,58 @@
+/*
+ * SPRITE STORM SCENE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef SPRITE_STORM_SCENE_HEADER
+#define SPRITE_STORM_SCENE_HEADER
+
+#include <vector>
+#include <basics/Vector>
+#include "Stress_Scene.hpp"
+
+    namespace example {
+
+        using basics::Point2f;
+        using basics::Vector2f;
+
+        /**
+         * Prueba de carga del dibujado: sprites del atlas del juego que se mueven por toda la
+         * pantalla, rebotan en los bordes y se voltean según la dirección en la que avanzan.
+         */
+        class Sprite_Storm_Scene : public Stress_Scene {
+
+            struct Particle {
+                const Atlas::Slice * slice;
+                Point2f  position;
+                Vector2f speed;
+            };
+
+        private:
+
+            std::vector< Particle > particles;
+
+        public:
+
+            Sprite_Storm_Scene(const Options & options) : Stress_Scene(options) {
+            }
+
+        protected:
+
+            const char * get_name () const override {
+                return "sprite storm";
+            }
+
+            void spawn    (unsigned count) override;
+            void simulate (float time) override;
+            void draw     (Canvas & canvas) override;
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,246 @@
+/*
+ * STRESS SCENE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include "Stress_Scene.hpp"
+#include "atlases/game_atlas.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <basics/Director>
+#include <basics/Log>
+#include <basics/Profiler>
+#include <basics/opengles/GL_State>
+
+using namespace basics;
+using namespace std;
+
+namespace example
+{
+
+    Stress_Scene::Stress_Scene(const Options & given_options)
+    :
+        state           (LOADING),
+        suspended       (true),
+        options         (given_options),
+        stage           (0),
+        stage_frame     (0),
+        last_frame_start(0),
+        current         (),
+        canvas_width    (720),
+        canvas_height   (1280)
+    {
+        if (options.entity_counts.empty ()) options.entity_counts.push_back (1000);
+        if (options.measured_frames == 0  ) options.measured_frames = 1;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    bool Stress_Scene::initialize () {
+        state = LOADING;
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    void Stress_Scene::update (float time) {
+        if (!suspended) switch (state) {
+            case LOADING: load (); break;
+            case RUNNING: {
+                uint64_t start = Profiler::now ();
+
+                simulate (time);
+
+                if (stage_frame >= options.warmup_frames) {
+                    current.update_time += double(Profiler::now () - start);
+                }
+                break;
+            }
+            case FINISHED:
+            case ERROR:   break;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    void Stress_Scene::render (Graphics_Context::Accessor & context) {
+        if (suspended || state != RUNNING) return;
+
+        Canvas * canvas = context->get_renderer< Canvas > (ID(canvas));
+
+        if (!canvas) {
+             canvas = Canvas::create (ID(canvas), context, {{ canvas_width, canvas_height }});
+        }
+
+        if (!canvas) return;
+
+        uint64_t start     = Profiler::now ();
+        bool     measuring = stage_frame >= options.warmup_frames;
+
+        // El tiempo de un fotograma se mide desde el inicio del anterior, de modo que incluye la
+        // presentación. Los contadores del canvas y los de GL_State también son los del fotograma
+        // anterior (los de GL_State siempre son 0 con el backend software):
+
+        if (measuring) {
+            const Canvas::Statistics             & statistics    = canvas->get_statistics ();
+            const opengles::GL_State::Statistics & gl_statistics = opengles::GL_State::get_statistics ();
+            double frame_time = double(start - last_frame_start);
+
+            current.frames++;
+            current.frame_time    += frame_time;
+            current.max_frame_time = std::max (current.max_frame_time, frame_time);
+            current.quads         += statistics.quads;
+            current.batches       += statistics.batches;
+            current.draw_calls    += statistics.draw_calls;
+            current.gl_issued_calls += gl_statistics.issued_calls;
+            current.gl_elided_calls += gl_statistics.elided_calls;
+        }
+
+        last_frame_start = start;
+
+        canvas->set_batching (options.batching);
+        canvas->clear ();
+
+        draw (*canvas);
+
+        if (measuring) {
+            current.render_time += double(Profiler::now () - start);
+        }
+
+        if (++stage_frame == options.warmup_frames + options.measured_frames) {
+            end_stage ();
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    void Stress_Scene::load () {
+        Graphics_Context::Accessor context = director.lock_graphics_context ();
+
+        if (context) {
+            atlas = director.get_asset_cache ().load_atlas ("game-scene/game.atlas", context);
+
+            if (atlas && game_atlas::matches (*atlas)) {
+                random.seed (director.make_random_seed ());
+                begin_stage ();
+                state = RUNNING;
+            }
+            else {
+                basics::log.e ("ERROR: the stress test atlas could not be loaded.");
+                state = ERROR;
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    void Stress_Scene::begin_stage () {
+        current          = Stage_Result();
+        current.entities = options.entity_counts[stage];
+        stage_frame      = 0;
+
+        spawn (current.entities);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    void Stress_Scene::end_stage () {
+        double frames = current.frames > 0 ? double(current.frames) : 1.0;
+
+        // Los tiempos se pasan de nanosegundos acumulados a milisegundos por fotograma:
+
+        current.frame_time     = current.frame_time  / frames * 1e-6;
+        current.max_frame_time = current.max_frame_time       * 1e-6;
+        current.update_time    = current.update_time / frames * 1e-6;
+        current.render_time    = current.render_time / frames * 1e-6;
+        current.quads         /= frames;
+        current.batches       /= frames;
+        current.draw_calls    /= frames;
+        current.gl_issued_calls /= frames;
+        current.gl_elided_calls /= frames;
+
+        results.push_back (current);
+
+        char line[200];
+
+        std::snprintf
+        (
+            line, sizeof(line), "%s: %u entities, %.3f ms/frame, %.1f draw calls/frame, %.1f GL calls issued/frame, %.1f elided",
+            get_name (), current.entities, current.frame_time, current.draw_calls, current.gl_issued_calls, current.gl_elided_calls
+        );
+
+        basics::log.i (line);
+
+        if (++stage < options.entity_counts.size ()) {
+            begin_stage ();
+        }
+        else {
+            state = FINISHED;
+            report ();
+            director.stop ();
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+    void Stress_Scene::report () {
+        char line[200];
+
+        std::snprintf (line, sizeof(line), "%s (%s, batching %s):", get_name (), options.backend.c_str (), options.batching ? "on" : "off");
+
+        basics::log.i (line);
+
+        std::snprintf
+        (
+            line, sizeof(line), "  %9s %10s %10s %10s %10s %10s %9s %10s %10s %10s",
+            "entities", "frame ms", "max ms", "update ms", "render ms", "quads", "batches", "draw calls", "GL issued", "GL elided"
+        );
+
+        basics::log.i (line);
+
+        for (const Stage_Result & result : results) {
+            std::snprintf
+            (
+                line, sizeof(line), "  %9u %10.3f %10.3f %10.3f %10.3f %10.0f %9.1f %10.1f %10.1f %10.1f",
+                result.entities, result.frame_time, result.max_frame_time, result.update_time,
+                result.render_time, result.quads, result.batches, result.draw_calls,
+                result.gl_issued_calls, result.gl_elided_calls
+            );
+
+            basics::log.i (line);
+        }
+
+        if (options.report_path.empty ()) return;
+
+        std::FILE * file = std::fopen (options.report_path.c_str (), "wb");
+
+        if (!file) {
+            basics::log.e (("ERROR: failed to write " + options.report_path).c_str ());
+            return;
+        }
+
+        std::fprintf
+        (
+            file, "{\n  \"scene\": \"%s\",\n  \"backend\": \"%s\",\n  \"batching\": %s,\n  \"frames_per_stage\": %u,\n  \"stages\": [\n",
+            get_name (), options.backend.c_str (), options.batching ? "true" : "false", options.measured_frames
+        );
+
+        for (size_t index = 0; index < results.size (); ++index) {
+            const Stage_Result & result = results[index];
+
+            std::fprintf
+            (
+                file,
+                "    {\"entities\":%u,\"frame_ms\":%.4f,\"max_frame_ms\":%.4f,\"update_ms\":%.4f,"
+                "\"render_ms\":%.4f,\"quads\":%.1f,\"batches\":%.1f,\"draw_calls\":%.1f,"
+                "\"gl_issued_calls\":%.1f,\"gl_elided_calls\":%.1f}%s\n",
+                result.entities, result.frame_time, result.max_frame_time, result.update_time,
+                result.render_time, result.quads, result.batches, result.draw_calls,
+                result.gl_issued_calls, result.gl_elided_calls,
+                index + 1 < results.size () ? "," : ""
+            );
+        }
+
+        std::fprintf (file, "  ]\n}\n");
+        std::fclose  (file);
+    }
+
+}
@@ -0,0 +1,164 @@
+/*
+ * STRESS SCENE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef STRESS_SCENE_HEADER
+#define STRESS_SCENE_HEADER
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <basics/Atlas>
+#include <basics/Canvas>
+#include <basics/Scene>
+
+    namespace example {
+
+        using basics::Atlas;
+        using basics::Canvas;
+        using basics::Graphics_Context;
+
+        /**
+         * Escena base de las pruebas de carga. Ejecuta la simulación y el dibujado de un número
+         * creciente de entidades en varias etapas y, al terminar, informa del tiempo por
+         * fotograma y de las llamadas de dibujado de cada etapa para poder ver a partir de qué
+         * número de entidades deja de escalar el motor. Las escenas derivadas solo tienen que
+         * crear, mover y dibujar sus entidades.
+         */
+        class Stress_Scene : public basics::Scene {
+        public:
+
+            /**
+             * Parámetros de la prueba.
+             */
+            struct Options {
+                std::vector< unsigned > entity_counts;  ///< Número de entidades de cada etapa.
+                unsigned    warmup_frames;              ///< Fotogramas de cada etapa que no se miden.
+                unsigned    measured_frames;            ///< Fotogramas de cada etapa que se miden.
+                bool        batching;                   ///< Si el canvas agrupa los quads en lotes.
+                std::string backend;                    ///< Nombre del backend gráfico para el informe.
+                std::string report_path;                ///< Archivo JSON con el resultado (opcional).
+
+                Options() :
+                    entity_counts  { 100, 300, 1000, 3000, 10000, 30000, 100000 },
+                    warmup_frames  (10),
+                    measured_frames(60),
+                    batching       (true),
+                    backend        ("opengles")
+                {
+                }
+            };
+
+            /**
+             * Medidas de una etapa. Los tiempos son medias por fotograma en milisegundos.
+             */
+            struct Stage_Result {
+                unsigned entities;
+                unsigned frames;
+                double   frame_time;                    ///< Tiempo entre el inicio de dos fotogramas.
+                double   max_frame_time;
+                double   update_time;
+                double   render_time;                   ///< Tiempo de envío al canvas, sin presentar.
+                double   quads;
+                double   batches;
+                double   draw_calls;
+                double   gl_issued_calls;               ///< Llamadas a OpenGL enviadas al driver.
+                double   gl_elided_calls;               ///< Llamadas a OpenGL evitadas por GL_State.
+            };
+
+        protected:
+
+            enum State {
+                LOADING,
+                RUNNING,
+                FINISHED,
+                ERROR
+            };
+
+        private:
+
+            State    state;
+            bool     suspended;
+
+            Options  options;
+            unsigned stage;                             ///< Índice de la etapa en curso.
+            unsigned stage_frame;                       ///< Fotogramas transcurridos en la etapa.
+            uint64_t last_frame_start;
+            Stage_Result current;
+
+            std::vector< Stage_Result > results;
+
+        protected:
+
+            unsigned canvas_width;
+            unsigned canvas_height;
+
+            std::shared_ptr< Atlas > atlas;
+            std::minstd_rand         random;
+
+        public:
+
+            Stress_Scene(const Options & options);
+
+            basics::Size2u get_view_size () override {
+                return { canvas_width, canvas_height };
+            }
+
+            bool initialize () override;
+
+            void suspend () override {
+                suspended = true;
+            }
+
+            void resume () override {
+                suspended = false;
+            }
+
+            void update (float time) override;
+            void render (Graphics_Context::Accessor & context) override;
+
+            const std::vector< Stage_Result > & get_results () const {
+                return results;
+            }
+
+        protected:
+
+            /**
+             * Nombre de la prueba para el informe.
+             */
+            virtual const char * get_name () const = 0;
+
+            /**
+             * Sustituye las entidades existentes por el número indicado de entidades nuevas.
+             */
+            virtual void spawn (unsigned count) = 0;
+
+            virtual void simulate (float time) = 0;
+            virtual void draw     (Canvas & canvas) = 0;
+
+            /**
+             * Retorna un número aleatorio entre min y max.
+             */
+            float random_between (float min, float max) {
+                return min + (max - min) * float(random () - random.min ()) / float(random.max () - random.min ());
+            }
+
+        private:
+
+            void load ();
+            void begin_stage ();
+            void end_stage ();
+            void report ();
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,48 @@
+/*
+ * Generado por basics-atlas-compiler a partir de game.sprites. No se debe editar.
+ */
+
+#ifndef GAME_ATLAS_HEADER
+#define GAME_ATLAS_HEADER
+
+    #include <basics/Atlas>
+
+    namespace game_atlas
+    {
+
+        enum Slice_Index : basics::Atlas::Slice_Handle
+        {
+            left,
+            platform,
+            down,
+            background,
+            loading,
+            pause,
+            right,
+            character,
+            top,
+        };
+
+        constexpr unsigned slice_count = 9;
+
+        constexpr basics::Atlas::Slice_Definition slices[slice_count] =
+        {
+            { 0x124aec70u, 1.f, 1.f, 108.f, 108.f },    // left
+            { 0x2a4a32b2u, 318.f, 65.f, 127.f, 36.f },    // platform
+            { 0x3db9b915u, 1.f, 1391.f, 720.f, 154.f },    // down
+            { 0x4babd89du, 1.f, 110.f, 720.f, 1280.f },    // background
+            { 0x68cc88b7u, 318.f, 1.f, 309.f, 63.f },    // loading
+            { 0x7084d38du, 628.f, 1.f, 63.f, 63.f },    // pause
+            { 0x78e32de5u, 110.f, 1.f, 108.f, 108.f },    // right
+            { 0x8b3aa710u, 219.f, 1.f, 98.f, 96.f },    // character
+            { 0xa710dc3cu, 1.f, 1546.f, 720.f, 80.f },    // top
+        };
+
+        inline bool matches (const basics::Atlas & atlas)
+        {
+            return atlas.matches (slices, slice_count);
+        }
+
+    }
+
+#endif
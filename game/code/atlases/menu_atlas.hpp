@@ -0,0 +1,44 @@
+/*
+ * Generado por basics-atlas-compiler a partir de menu.sprites. No se debe editar.
+ */
+
+#ifndef MENU_ATLAS_HEADER
+#define MENU_ATLAS_HEADER
+
+    #include <basics/Atlas>
+
+    namespace menu_atlas
+    {
+
+        enum Slice_Index : basics::Atlas::Slice_Handle
+        {
+            help,
+            background,
+            back,
+            text_help,
+            title,
+            play,
+            exit,
+        };
+
+        constexpr unsigned slice_count = 7;
+
+        constexpr basics::Atlas::Slice_Definition slices[slice_count] =
+        {
+            { 0x3871a3fau, 511.f, 1.f, 254.f, 107.f },    // help
+            { 0x4babd89du, 1.f, 109.f, 720.f, 1280.f },    // background
+            { 0x5bb421a2u, 1.f, 1.f, 254.f, 107.f },    // back
+            { 0x7c6a9d10u, 722.f, 109.f, 720.f, 1280.f },    // text_help
+            { 0x9865b509u, 1.f, 1390.f, 558.f, 150.f },    // title
+            { 0xc2cbd863u, 766.f, 1.f, 254.f, 107.f },    // play
+            { 0xcded1a85u, 256.f, 1.f, 254.f, 107.f },    // exit
+        };
+
+        inline bool matches (const basics::Atlas & atlas)
+        {
+            return atlas.matches (slices, slice_count);
+        }
+
+    }
+
+#endif
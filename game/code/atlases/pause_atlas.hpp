@@ -0,0 +1,42 @@
+/*
+ * Generado por basics-atlas-compiler a partir de pause.sprites. No se debe editar.
+ */
+
+#ifndef PAUSE_ATLAS_HEADER
+#define PAUSE_ATLAS_HEADER
+
+    #include <basics/Atlas>
+
+    namespace pause_atlas
+    {
+
+        enum Slice_Index : basics::Atlas::Slice_Handle
+        {
+            title_over,
+            background,
+            play_again,
+            title_pause,
+            menu,
+            resume,
+        };
+
+        constexpr unsigned slice_count = 6;
+
+        constexpr basics::Atlas::Slice_Definition slices[slice_count] =
+        {
+            { 0x1dcb9f90u, 1.f, 1494.f, 558.f, 238.f },    // title_over
+            { 0x4babd89du, 1.f, 1.f, 720.f, 1280.f },    // background
+            { 0x51b5a448u, 722.f, 217.f, 254.f, 107.f },    // play_again
+            { 0x93e46ba4u, 1.f, 1282.f, 558.f, 211.f },    // title_pause
+            { 0x99e4dd3au, 722.f, 1.f, 254.f, 107.f },    // menu
+            { 0xff39a36au, 722.f, 109.f, 254.f, 107.f },    // resume
+        };
+
+        inline bool matches (const basics::Atlas & atlas)
+        {
+            return atlas.matches (slices, slice_count);
+        }
+
+    }
+
+#endif
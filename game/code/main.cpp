@@ -8,24 +8,269 @@
  * angel.rodriguez@esne.edu
  */
 
+#include <cstdlib>
+#include <cstring>
+#include <basics/Allocation_Tracker>
 #include <basics/Director>
 #include <basics/enable>
 #include <basics/Graphics_Resource_Cache>
+#include <basics/Profiler>
+#include <basics/Session_Recorder>
+#include <basics/Session_Replayer>
+#include <basics/Startup_Timeline>
 #include <basics/opengles/Context>
 #include <basics/Window>
+#include "Game_Scene.hpp"
 #include "Intro_Scene.hpp"
+#include "Menu_Scene.hpp"
+#include "Platform_Field_Scene.hpp"
+#include "Sprite_Storm_Scene.hpp"
 #include <basics/opengles/Canvas_ES2>
 #include <basics/opengles/OpenGL_ES2>
 
+#if defined(BASICS_LINUX_OS)
+    #include <basics/software/Context>
+    #include <basics/software/Software_Rendering>
+#endif
+
 using namespace basics;
 using namespace example;
 using namespace std;
 
+#if defined(BASICS_LINUX_OS)
+
+    namespace
+    {
+
+        const unsigned startup_frames = 3;
+
+        // Guion de entrada de las ejecuciones sin usuario: cada medio segundo se toca la pantalla en
+        // una posición distinta y se levanta el dedo unos fotogramas después.
+
+        Director::Event_Script make_touch_script (unsigned frame_count)
+        {
+            Director::Event_Script script;
+
+            for (unsigned frame = 30, index = 0; frame + 10 < frame_count; frame += 30, ++index)
+            {
+                float x = float(90 + (index * 180) % 540);
+                float y = 640.f;
+
+                Event started(ID(touch-started));
+                Event ended  (ID(touch-ended));
+
+                started[ID(x)] = ended[ID(x)] = x;
+                started[ID(y)] = ended[ID(y)] = y;
+
+                script.push_back ({ frame,      started });
+                script.push_back ({ frame + 10, ended   });
+            }
+
+            return script;
+        }
+
+        // Si BASICS_PROFILE_TRACE indica un archivo, se activa el profiler y al terminar se guarda
+        // en él la traza (en formato de Chrome) y se escribe en el log el resumen de cada zona.
+
+        class Profile_Output
+        {
+            const char * path;
+
+        public:
+
+            Profile_Output() : path(getenv ("BASICS_PROFILE_TRACE"))
+            {
+                if (path) Profiler::enable (true);
+            }
+
+           ~Profile_Output()
+            {
+                if (path)
+                {
+                    Profiler::log_summary ();
+                    Profiler::write_chrome_trace (path);
+                }
+            }
+        };
+
+        // Si BASICS_STARTUP_TRACE indica un archivo, se registra cuánto tarda cada paso del arranque
+        // (creación del contexto gráfico, carga de cada asset, primer fotograma...) y al terminar se
+        // escribe la cronología en el log y en ese archivo (en formato de Chrome).
+
+        class Startup_Output
+        {
+            const char * path;
+
+        public:
+
+            Startup_Output() : path(getenv ("BASICS_STARTUP_TRACE"))
+            {
+                if (path) Startup_Timeline::enable (true);
+            }
+
+           ~Startup_Output()
+            {
+                if (path)
+                {
+                    Startup_Timeline::log_timeline ();
+                    Startup_Timeline::write_chrome_trace (path);
+                }
+            }
+
+            bool is_enabled () const
+            {
+                return path != nullptr;
+            }
+        };
+
+        // Con BASICS_RENDERING=software se dibuja con el backend por software (sin GPU) en lugar de
+        // con OpenGL ES, de modo que se puede comparar el coste de las mismas escenas con ambos.
+
+        const char * select_rendering_backend ()
+        {
+            const char * backend = getenv ("BASICS_RENDERING");
+
+            if (backend && strcmp (backend, "software") == 0)
+            {
+                enable< Software_Rendering > ();
+
+                director.set_graphics_context_factory (software::Context::create);
+
+                return "software";
+            }
+
+            return "opengles";
+        }
+
+        shared_ptr< Scene > make_headless_scene ()
+        {
+            const char * name = getenv ("BASICS_HEADLESS_SCENE");
+
+            if (name && strcmp (name, "menu") == 0) return shared_ptr< Scene >(new Menu_Scene);
+            if (name && strcmp (name, "game") == 0) return shared_ptr< Scene >(new Game_Scene);
+
+            return shared_ptr< Scene >(new Intro_Scene);
+        }
+
+        // Pruebas de carga: BASICS_STRESS_SCENE indica la escena (storm, field o field-brute),
+        // BASICS_STRESS_COUNTS el número de entidades de cada etapa separados por comas,
+        // BASICS_STRESS_FRAMES los fotogramas que se miden en cada etapa, BASICS_STRESS_BATCHING=0
+        // desactiva los lotes del canvas y BASICS_STRESS_REPORT indica un archivo JSON de salida.
+
+        shared_ptr< Scene > make_stress_scene (const char * name, const char * backend)
+        {
+            Stress_Scene::Options options;
+
+            options.backend = backend;
+
+            if (const char * counts = getenv ("BASICS_STRESS_COUNTS"))
+            {
+                options.entity_counts.clear ();
+
+                for (char * end; *counts; counts = *end ? end + 1 : end)
+                {
+                    unsigned long count = strtoul (counts, &end, 10);
+
+                    if (end == counts) break;
+                    if (count > 0) options.entity_counts.push_back (unsigned(count));
+                }
+            }
+
+            if (const char * frames   = getenv ("BASICS_STRESS_FRAMES"  )) options.measured_frames = unsigned(atoi (frames));
+            if (const char * batching = getenv ("BASICS_STRESS_BATCHING")) options.batching        = strcmp (batching, "0") != 0;
+            if (const char * report   = getenv ("BASICS_STRESS_REPORT"  )) options.report_path     = report;
+
+            if (strcmp (name, "storm"      ) == 0) return shared_ptr< Scene >(new Sprite_Storm_Scene  (options));
+            if (strcmp (name, "field"      ) == 0) return shared_ptr< Scene >(new Platform_Field_Scene(options));
+            if (strcmp (name, "field-brute") == 0) return shared_ptr< Scene >(new Platform_Field_Scene(options, Platform_Field_Scene::BRUTE_FORCE));
+
+            return nullptr;
+        }
+
+    }
+
+#endif
+
 int main ()
 {
     // Es necesario habilitar un backend gráfico antes de nada:
     enable< basics::OpenGL_ES2 > ();
 
+    #if defined(BASICS_LINUX_OS)
+
+        Startup_Output startup_output;
+
+        Startup_Timeline::mark ("main");
+
+        // En Linux se puede medir el coste de una escena sin usuario indicando en la variable de
+        // entorno BASICS_HEADLESS_FRAMES cuántos fotogramas se deben ejecutar y, opcionalmente, en
+        // BASICS_HEADLESS_SCENE la escena (intro, menu o game). BASICS_RECORD_SESSION indica un
+        // archivo en el que grabar la partida y BASICS_REPLAY_SESSION uno grabado que repetir.
+        // Con BASICS_TRACK_ALLOCATIONS se cuentan las reservas de memoria y la ejecución termina
+        // con error si alguna zona que no debía reservar memoria lo hizo. Con BASICS_STARTUP_TRACE
+        // y sin BASICS_HEADLESS_FRAMES solo se ejecutan los primeros fotogramas. BASICS_RENDERING
+        // selecciona el backend gráfico (opengles o software) y con BASICS_THREADED_RENDERING las
+        // escenas que lo admiten (como Game_Scene) se dibujan desde un hilo de render:
+
+        if (getenv ("BASICS_TRACK_ALLOCATIONS")) Allocation_Tracker::enable (true);
+
+        const char * backend = select_rendering_backend ();
+
+        if (getenv ("BASICS_THREADED_RENDERING")) director.set_threaded_rendering (true);
+
+        Profile_Output   profile_output;
+        Session_Recorder recorder;
+
+        if (const char * path = getenv ("BASICS_RECORD_SESSION"))
+        {
+            if (recorder.open (path, director.get_random_seed ()))
+            {
+                director.set_session_recorder (&recorder);
+            }
+        }
+
+        if (const char * path = getenv ("BASICS_REPLAY_SESSION"))
+        {
+            Session_Replayer replayer;
+
+            if (!replayer.load (path)) return 1;
+
+            director.enable_headless_mode (replayer);
+            director.run_scene (make_headless_scene ());
+
+            if (replayer.get_mismatch_count () > 0) return 2;
+
+            return Allocation_Tracker::get_violation_count () == 0 ? 0 : 3;
+        }
+
+        if (const char * name = getenv ("BASICS_STRESS_SCENE"))
+        {
+            shared_ptr< Scene > scene = make_stress_scene (name, backend);
+
+            if (!scene) return 1;
+
+            // La escena detiene al director cuando termina su última etapa:
+
+            director.enable_headless_mode (~0u);
+            director.run_scene (scene);
+
+            return 0;
+        }
+
+        const char * frames = getenv ("BASICS_HEADLESS_FRAMES");
+
+        if (frames || startup_output.is_enabled ())
+        {
+            unsigned frame_count = frames ? unsigned(atoi (frames)) : startup_frames;
+
+            director.enable_headless_mode (frame_count, 1.f / 60.f, make_touch_script (frame_count));
+            director.run_scene (make_headless_scene ());
+
+            return Allocation_Tracker::get_violation_count () == 0 ? 0 : 3;
+        }
+
+    #endif
+
     // Se crea una Game_Scene y se inicia mediante el Director:
     director.run_scene (shared_ptr< Scene >(new Intro_Scene));
 
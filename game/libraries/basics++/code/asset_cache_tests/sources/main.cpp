@@ -0,0 +1,222 @@
+/*
+ * ASSET CACHE TESTS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <memory>
+#include <string>
+#include <basics/Asset_Cache>
+#include <basics/Color_Buffer>
+#include <basics/enable>
+#include <basics/Log>
+#include <basics/Texture_2D>
+#include <basics/Window>
+#include <basics/software/Context>
+#include <basics/software/Software_Rendering>
+
+using namespace basics;
+
+namespace
+{
+
+    typedef std::shared_ptr< Texture_2D > Texture_Handle;
+
+    // Todas las texturas de prueba miden lo mismo (16x16 a 4 bytes por pixel):
+
+    const unsigned texture_side = 16;
+    const size_t   texture_size = texture_side * texture_side * 4;
+
+    unsigned checks   = 0;
+    unsigned failures = 0;
+
+    void check (bool condition, const std::string & what)
+    {
+        ++checks;
+
+        if (!condition)
+        {
+            basics::log.e (("ERROR: " + what).c_str ());
+
+            ++failures;
+        }
+    }
+
+    /**
+     * Crea una textura y la añade al contexto como hacen Asset_Cache::load_texture() y
+     * Asset_Loader, pero sin leerla de un archivo.
+     */
+    Texture_Handle make_texture (Graphics_Context::Accessor & context)
+    {
+        Color_Buffer< Rgba8888 > color_buffer(texture_side, texture_side);
+        Texture_2D::Options      options { texture_side, texture_side };
+        Texture_Handle           texture = Texture_2D::create (0, context, color_buffer, options);
+
+        if (texture && context->add (texture)) return texture;
+
+        return Texture_Handle();
+    }
+
+    void check_normalize_path ()
+    {
+        struct Case
+        {
+            const char * path;
+            const char * expected;
+        };
+
+        const Case cases[] =
+        {
+            { "game-scene/game.png",            "game-scene/game.png"   },
+            { "./game-scene/./game.png",        "game-scene/game.png"   },
+            { "game-scene//game.png/",          "game-scene/game.png"   },
+            { "game-scene\\game.png",           "game-scene/game.png"   },
+            { "menu-scene/../game-scene/a.png", "game-scene/a.png"      },
+            { "a/b/../../c.png",                "c.png"                 },
+            { "..",                             ".."                    },
+            { "../a.png",                       "../a.png"              },
+            { "a/../../b.png",                  "../b.png"              },
+            { "../../a/..",                     "../.."                 },
+            { "..\\.\\a.png",                   "../a.png"              },
+            { "/../a.png",                      "/a.png"                },   // No se sube por encima de la raíz
+            { "\\a\\..\\..\\b.png",             "/b.png"                },
+            { "/",                              "/"                     },
+            { ".",                              ""                      },
+            { "",                               ""                      },
+        };
+
+        for (const Case & test : cases)
+        {
+            std::string normalized = Asset_Cache::normalize_path (test.path);
+
+            check (normalized == test.expected, std::string("normalize_path(\"") + test.path + "\") returned \"" + normalized + "\" instead of \"" + test.expected + "\"");
+        }
+    }
+
+    /**
+     * Las distintas formas de escribir una ruta dan el mismo asset, y un asset no se retorna ni
+     * se sustituye al pedirlo como otro tipo de asset.
+     */
+    void check_aliases_and_kinds (Graphics_Context::Accessor & context)
+    {
+        Asset_Cache    cache;
+        Texture_Handle texture = make_texture (context);
+        Texture_Handle copy    = make_texture (context);
+
+        check (texture && copy, "the test textures could not be created");
+
+        if (!texture || !copy) return;
+
+        check (cache.add ("tests/a.png", texture, context) == texture,             "add() did not return the new texture");
+        check (cache.find_texture ("tests/./b/../a.png") == texture,               "a path with . and .. did not find the texture");
+        check (cache.find_texture ("tests\\a.png"      ) == texture,               "a path with \\ did not find the texture");
+        check (cache.add ("./tests/a.png", copy, context) == texture,              "adding the same path again did not return the stored texture");
+        check (cache.find_atlas ("tests/a.png") == nullptr,                        "a texture was returned as an atlas");
+
+        std::shared_ptr< Atlas > atlas = std::make_shared< Atlas > (texture);
+
+        check (cache.add ("tests/a.png", atlas, context) == atlas,                 "add() did not return the atlas whose path is taken");
+        check (cache.find_atlas   ("tests/a.png") == nullptr,                      "an atlas replaced a texture with the same path");
+        check (cache.find_texture ("tests/a.png") == texture,                      "the texture was lost after adding an atlas with its path");
+        check (cache.get_statistics ().entries == 1,                               "aliases created more than one entry");
+    }
+
+    /**
+     * Al superar el presupuesto se descartan los assets menos usados que nadie más tiene, y sus
+     * texturas salen del contexto (se liberan en cuanto no quedan referencias).
+     */
+    void check_eviction (Graphics_Context::Accessor & context)
+    {
+        Asset_Cache cache(texture_size * 2);
+
+        Texture_Handle in_use = make_texture (context);
+        Texture_Handle b      = make_texture (context);
+        Texture_Handle c      = make_texture (context);
+
+        check (in_use && b && c, "the test textures could not be created");
+
+        if (!in_use || !b || !c) return;
+
+        std::weak_ptr< Texture_2D > released = b;
+
+        // La primera queda en uso. Las otras dos solo las tienen la caché y el contexto:
+
+        cache.add ("tests/in-use.png", in_use, context);
+        cache.add ("tests/b.png",      b,      context);
+
+        b.reset ();
+
+        cache.add ("tests/c.png",      c,      context);
+
+        c.reset ();
+
+        Asset_Cache::Statistics statistics = cache.get_statistics ();
+
+        check (statistics.evictions == 1 && statistics.memory == texture_size * 2, "the budget was not applied when adding a texture");
+        check (cache.find_texture ("tests/in-use.png") == in_use,                  "a texture in use was evicted");
+        check (cache.find_texture ("tests/b.png") == nullptr,                      "the least recently used texture was not evicted");
+        check (released.expired (),                                                "the evicted texture was not released");
+        check (cache.find_texture ("tests/c.png") != nullptr,                      "the most recent texture was evicted");
+
+        // Sin presupuesto solo se conserva la que sigue en uso:
+
+        cache.set_budget (0);
+        cache.trim (context);
+
+        statistics = cache.get_statistics ();
+
+        check (statistics.entries == 1 && statistics.memory == texture_size,      "trim() evicted a texture in use or kept an unused one");
+        check (cache.find_texture ("tests/in-use.png") == in_use,                  "trim() evicted a texture in use");
+
+        // Una vez que deja de usarse ya se puede descartar:
+
+        std::weak_ptr< Texture_2D > last = in_use;
+
+        in_use.reset ();
+
+        cache.trim (context);
+
+        check (cache.get_statistics ().entries == 0 && last.expired (),           "an unused texture survived trim() with no budget");
+    }
+
+}
+
+/**
+ * Uso: basics-asset-cache-tests
+ *
+ * Comprueba la normalización de rutas de Asset_Cache y que no descarte assets en uso. Las
+ * texturas se crean con el backend software, por lo que no se necesita OpenGL.
+ * @return 0 si todas las comprobaciones se cumplen.
+ */
+int main ()
+{
+    check_normalize_path ();
+
+    enable< Software_Rendering > ();
+
+    Window::create_window (ID(asset-cache-tests));
+
+    Window::Accessor window = Window::get_window (ID(asset-cache-tests)).lock ();
+
+    if (!window || !software::Context::create (window, nullptr))
+    {
+        basics::log.e ("ERROR: failed to create the graphics context.");
+
+        return 1;
+    }
+
+    {
+        Graphics_Context::Accessor context = window->lock_graphics_context ();
+
+        check_aliases_and_kinds (context);
+        check_eviction          (context);
+    }
+
+    basics::log.i ((std::to_string (checks) + " checks, " + std::to_string (failures) + " failures").c_str ());
+
+    return failures == 0 ? 0 : 1;
+}
@@ -16,6 +16,7 @@
 
     #include <android/asset_manager.h>
     #include <basics/Asset>
+    #include <basics/Startup_Timeline>
     #include "Android_Asset.hpp"
     #include "Native_Activity.hpp"
 
@@ -24,6 +25,8 @@
 
         std::shared_ptr< Asset > Asset::open (const std::string & path)
         {
+            BASICS_STARTUP_SPAN ("open " + path);
+
             std::shared_ptr< Asset > asset(new internal::Android_Asset(path));
 
             if (!asset->good ())
@@ -20,6 +20,7 @@
     #include "Native_Activity.hpp"
 
     #include <basics/Log>
+    #include <basics/Startup_Timeline>
     using namespace basics;
 
     using namespace std;
@@ -331,6 +332,8 @@
             }
 
             application.push (Event(Application::Event_Id::WINDOW_CREATED));
+
+            Startup_Timeline::mark ("window created");
         }
 
         // -----------------------------------------------------------------------------------------
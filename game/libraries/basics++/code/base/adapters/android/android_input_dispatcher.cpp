@@ -16,6 +16,7 @@
 
     #include <basics/Director>
     #include <basics/Id>
+    #include <utility>
     #include <android/input.h>
 
     namespace basics { namespace internal
@@ -39,7 +40,7 @@
                             event[ID(x)] = x;
                             event[ID(y)] = y;
 
-                            director.handle (event);
+                            director.handle (std::move (event));
 
                             break;
                         }
@@ -51,7 +52,7 @@
                             event[ID(x)] = x;
                             event[ID(y)] = y;
 
-                            director.handle (event);
+                            director.handle (std::move (event));
 
                             break;
                         }
@@ -63,7 +64,7 @@
                             event[ID(x)] = x;
                             event[ID(y)] = y;
 
-                            director.handle (event);
+                            director.handle (std::move (event));
 
                             break;
                         }
@@ -16,6 +16,7 @@
 
     #include "Native_Activity.hpp"
     #include <basics/Application>
+    #include <basics/Startup_Timeline>
 
     /*REMOVE*/#include <basics/Log>/****/
 
@@ -166,6 +167,8 @@
 
         activity->instance = native_activity = new Native_Activity(*activity);
 
+        basics::Startup_Timeline::mark ("native activity created");
+
         activity->callbacks->onStart                    = on_start;
         activity->callbacks->onResume                   = on_resume;
         activity->callbacks->onPause                    = on_pause;
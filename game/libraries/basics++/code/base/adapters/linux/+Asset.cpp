@@ -0,0 +1,53 @@
+/*
+ * ASSET
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    #include <sys/stat.h>
+    #include <basics/Asset>
+    #include <basics/Startup_Timeline>
+    #include "Posix_Asset.hpp"
+
+    namespace basics
+    {
+
+        std::shared_ptr< Asset > Asset::open (const std::string & path)
+        {
+            BASICS_STARTUP_SPAN ("open " + path);
+
+            std::shared_ptr< Asset > asset(new internal::Posix_Asset(path));
+
+            if (!asset->good ())
+            {
+                 asset.reset ();
+            }
+
+            return asset;
+        }
+
+        bool Asset::exists (const std::string & path)
+        {
+            struct stat status;
+
+            return ::stat (internal::Posix_Asset::get_full_path (path).c_str (), &status) == 0 && S_ISREG(status.st_mode);
+        }
+
+        size_t Asset::size (const std::string & path)
+        {
+            struct stat status;
+
+            return ::stat (internal::Posix_Asset::get_full_path (path).c_str (), &status) == 0 && S_ISREG(status.st_mode) ? size_t(status.st_size) : 0;
+        }
+
+    }
+
+#endif
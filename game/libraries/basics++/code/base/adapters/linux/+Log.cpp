@@ -0,0 +1,61 @@
+/*
+ * LOG
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    #include <cstdio>
+    #include <cstdlib>
+    #include <mutex>
+    #include <basics/Log>
+
+    namespace basics
+    {
+
+        static const char * const level_names[] =
+        {
+            "V",
+            "D",
+            "I",
+            "W",
+            "E",
+            "F",
+        };
+
+        /**
+         * Los mensajes se escriben en la salida estándar o, si la variable de entorno
+         * BASICS_LOG_FILE indica un archivo, al final de ese archivo.
+         */
+        static FILE * open_log_stream ()
+        {
+            const char * path   = std::getenv ("BASICS_LOG_FILE");
+            FILE       * stream = path && *path ? std::fopen (path, "a") : nullptr;
+
+            return stream ? stream : stdout;
+        }
+
+        void Log::dump (Level level, const char * tag, const char * cstring)
+        {
+            static FILE     * stream = open_log_stream ();
+            static std::mutex mutex;
+
+            std::lock_guard< std::mutex > lock(mutex);
+
+            std::fprintf (stream, "%s/%s: %s\n", level_names[level], tag ? tag : "*", cstring);
+
+            if (level >= ERROR) std::fflush (stream);
+        }
+
+        Log log;
+
+    }
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * WINDOW
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    #include <cstdio>
+    #include <cstdlib>
+    #include <map>
+    #include <memory>
+    #include <mutex>
+    #include <basics/Application>
+    #include <basics/Startup_Timeline>
+    #include <basics/Window>
+    #include "Offscreen_Window.hpp"
+
+    namespace basics
+    {
+
+        using internal::Offscreen_Window;
+
+        namespace
+        {
+
+            typedef std::map< Id, std::shared_ptr< Offscreen_Window > > Window_Map;
+
+            Window_Map windows;
+            std::mutex windows_mutex;
+
+            /**
+             * El tamaño de las ventanas se puede indicar con la variable de entorno
+             * BASICS_WINDOW_SIZE con el formato ANCHOxALTO (por ejemplo 720x1280).
+             */
+            Size2u get_window_size ()
+            {
+                Size2u       size{ 720, 1280 };
+                const char * text = std::getenv ("BASICS_WINDOW_SIZE");
+
+                if (text)
+                {
+                    unsigned width, height;
+
+                    if (std::sscanf (text, "%ux%u", &width, &height) == 2 && width > 0 && height > 0)
+                    {
+                        size.width  = width;
+                        size.height = height;
+                    }
+                }
+
+                return size;
+            }
+
+        }
+
+        // -----------------------------------------------------------------------------------------
+
+        const bool Window::can_be_instantiated = true;
+
+        Window::Handle Window::create_window (Id id)
+        {
+            std::lock_guard< std::mutex > lock(windows_mutex);
+
+            std::shared_ptr< Offscreen_Window > & window = windows[id];
+
+            if (!window)
+            {
+                window.reset (new Offscreen_Window(id, get_window_size ()));
+
+                window->push (Event(GOT_FOCUS));
+
+                if (id == default_window_id)
+                {
+                    application.push (Event(Application::Event_Id::WINDOW_CREATED));
+
+                    Startup_Timeline::mark ("window created");
+                }
+            }
+
+            return Handle(std::weak_ptr< Window >(window));
+        }
+
+        bool Window::destroy_window (Id id)
+        {
+            std::shared_ptr< Offscreen_Window > window;
+
+            {
+                std::lock_guard< std::mutex > lock(windows_mutex);
+
+                Window_Map::iterator iterator = windows.find (id);
+
+                if (iterator == windows.end ()) return false;
+
+                window = iterator->second;
+
+                windows.erase (iterator);
+            }
+
+            window->release_graphics_context ();
+
+            if (id == default_window_id)
+            {
+                application.push (Event(Application::Event_Id::WINDOW_DESTROYED));
+            }
+
+            return true;
+        }
+
+        Window::Handle Window::get_window (Id id)
+        {
+            std::lock_guard< std::mutex > lock(windows_mutex);
+
+            Window_Map::iterator iterator = windows.find (id);
+
+            if (iterator != windows.end ())
+            {
+                return Handle(std::weak_ptr< Window >(iterator->second));
+            }
+
+            return Handle();
+        }
+
+    }
+
+#endif
@@ -0,0 +1,59 @@
+/*
+ * LINUX APPLICATION
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_LINUX_APPLICATION_HEADER
+#define BASICS_LINUX_APPLICATION_HEADER
+
+    #include <atomic>
+    #include <basics/Application>
+    #include <basics/Startup_Timeline>
+
+    namespace basics { namespace internal
+    {
+
+        /**
+         * Aplicación de consola sin interfaz. Pasa a estar interactiva en cuanto se crea y solo
+         * termina cuando alguien añade un evento QUIT (o el director se detiene).
+         */
+        class Linux_Application : public Application
+        {
+
+            std::atomic< Application::State > state;
+
+        public:
+
+            Linux_Application()
+            {
+                state = INTERACTIVE;
+
+                push (Event(RESUME));
+
+                Startup_Timeline::mark ("application created");
+            }
+
+        public:
+
+            State get_state () const override
+            {
+                return state;
+            }
+
+            void set_state (State new_state)
+            {
+                state = new_state;
+            }
+
+        };
+
+        extern Linux_Application application;
+
+    }}
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * OFFSCREEN WINDOW
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_OFFSCREEN_WINDOW_HEADER
+#define BASICS_OFFSCREEN_WINDOW_HEADER
+
+    #include <basics/Window>
+
+    namespace basics { namespace internal
+    {
+
+        /**
+         * Ventana que no se muestra en pantalla. Solo tiene un tamaño, con el que el contexto
+         * gráfico que se le asigne crea su superficie de dibujado. Siempre está disponible y
+         * tiene el foco.
+         */
+        class Offscreen_Window final : public Window
+        {
+        public:
+
+            class Accessor : public Window::Accessor
+            {
+            public:
+
+                Offscreen_Window * get ()
+                {
+                    return static_cast< Offscreen_Window * >(window.get ());
+                }
+
+            };
+
+        private:
+
+            Size2u size;
+
+        public:
+
+            Offscreen_Window(Id id, const Size2u & size) : Window(id), size(size)
+            {
+                available = true;
+                focused   = true;
+            }
+
+        public:
+
+            Graphics_Context * get_graphics_context ()
+            {
+                return graphics.context.get ();
+            }
+
+            Size2u get_size () override
+            {
+                return size;
+            }
+
+            unsigned get_width () override
+            {
+                return size.width;
+            }
+
+            unsigned get_height () override
+            {
+                return size.height;
+            }
+
+        public:
+
+            /**
+             * Libera el contexto gráfico esperando a que ningún otro hilo lo esté usando.
+             */
+            void release_graphics_context ()
+            {
+                available = false;
+
+                if (graphics.context)
+                {
+                    graphics.context->invalidate ();
+
+                    Graphics_Context::Accessor graphics_context = lock_graphics_context ();
+
+                    reset_graphics_context ();
+                }
+            }
+
+        };
+
+    }}
+
+#endif
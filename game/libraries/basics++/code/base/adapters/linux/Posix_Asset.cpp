@@ -0,0 +1,195 @@
+/*
+ * POSIX ASSET
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    #include <cerrno>
+    #include <cstdlib>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #include "Posix_Asset.hpp"
+
+    #if !defined(BASICS_DEFAULT_ASSETS_PATH)
+        #define BASICS_DEFAULT_ASSETS_PATH "assets"
+    #endif
+
+    namespace basics { namespace internal
+    {
+
+        std::string Posix_Asset::get_full_path (const std::string & path)
+        {
+            const char * root = std::getenv ("BASICS_ASSETS_PATH");
+
+            if (!root || !*root) root = BASICS_DEFAULT_ASSETS_PATH;
+
+            return path.empty () || path[0] == '/' ? path : std::string(root) + '/' + path;
+        }
+
+        // ---------------------------------------------------------------------------------------------
+
+        Posix_Asset::Posix_Asset(const std::string & path)
+        {
+            handle = ::open (get_full_path (path).c_str (), O_RDONLY | O_CLOEXEC);
+            length = 0;
+            cursor = 0;
+            failed = handle < 0;
+            at_end = false;
+
+            if (!failed)
+            {
+                struct stat status;
+
+                if (::fstat (handle, &status) == 0 && S_ISREG(status.st_mode))
+                {
+                    length = size_t(status.st_size);
+                }
+                else
+                    failed = true;
+            }
+        }
+
+        Posix_Asset::~Posix_Asset()
+        {
+            if (handle >= 0)
+            {
+                ::close (handle), handle = -1;
+            }
+        }
+
+        bool Posix_Asset::good () const
+        {
+            return not failed;
+        }
+
+        bool Posix_Asset::fail () const
+        {
+            return failed;
+        }
+
+        bool Posix_Asset::eof () const
+        {
+            return at_end;
+        }
+
+        size_t Posix_Asset::size () const
+        {
+            return good () ? length : 0;
+        }
+
+        bool Posix_Asset::seek (ptrdiff_t offset, Anchor anchor)
+        {
+            if (good ())
+            {
+                off_t new_offset = ::lseek
+                (
+                    handle,
+                    off_t(offset),
+                    anchor == BEGINNING ? SEEK_SET : anchor == END ? SEEK_END : SEEK_CUR
+                );
+
+                if (new_offset >= 0)
+                {
+                    cursor = size_t(new_offset);
+                    at_end = false;
+
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        size_t Posix_Asset::tell () const
+        {
+            return cursor;
+        }
+
+        byte Posix_Asset::read ()
+        {
+            byte data = 0;
+
+            if (good ())
+            {
+                read (&data, 1);
+            }
+
+            return data;
+        }
+
+        bool Posix_Asset::read_all (std::vector< byte > & buffer)
+        {
+            if (good ())
+            {
+                size_t s = size ();
+
+                buffer.resize (s);
+
+                return read (buffer.data (), s);
+            }
+
+            return false;
+        }
+
+        bool Posix_Asset::read_all (std::string & buffer)
+        {
+            if (good ())
+            {
+                size_t s = size ();
+
+                buffer.resize (s);
+
+                return read ((uint8_t *)&buffer[0], s);
+            }
+
+            return false;
+        }
+
+        bool Posix_Asset::read (uint8_t * buffer, size_t size)
+        {
+            // read() puede leer menos bytes de los pedidos sin que sea un error:
+
+            size_t done = 0;
+
+            while (done < size)
+            {
+                ssize_t result = ::read (handle, buffer + done, size - done);
+
+                if (result > 0)
+                {
+                    done += size_t(result);
+                }
+                else
+                if (result == 0)
+                {
+                    at_end  = true;
+                    cursor += done;
+
+                    return false;
+                }
+                else
+                if (errno != EINTR)
+                {
+                    failed  = true;
+
+                    return false;
+                }
+            }
+
+            cursor += done;
+
+            return true;
+        }
+
+    }}
+
+#endif
@@ -0,0 +1,63 @@
+/*
+ * POSIX ASSET
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_POSIX_ASSET_HEADER
+#define BASICS_POSIX_ASSET_HEADER
+
+    #include <basics/Asset>
+
+    namespace basics { namespace internal
+    {
+
+        /**
+         * Asset que se lee de un archivo. Las rutas son relativas a la carpeta de assets, que se
+         * puede indicar con la variable de entorno BASICS_ASSETS_PATH. Si no se indica, se usa la
+         * establecida al compilar con BASICS_DEFAULT_ASSETS_PATH o, en su defecto, "assets".
+         */
+        class Posix_Asset final : public Asset
+        {
+
+            int      handle;
+            size_t   length;
+            size_t   cursor;
+            bool     failed;
+            bool     at_end;
+
+        public:
+
+            Posix_Asset(const std::string & path);
+           ~Posix_Asset();
+
+        public:
+
+            static std::string get_full_path (const std::string & path);
+
+        public:
+
+            bool   good () const override;
+            bool   fail () const override;
+            bool   eof  () const override;
+
+            size_t size () const override;
+            bool   seek (ptrdiff_t offset, Anchor = CURRENT) override;
+            size_t tell () const override;
+            byte   read () override;
+            bool   read_all (std::vector< byte > & buffer) override;
+            bool   read_all (std::string & buffer) override;
+
+        private:
+
+            bool read (uint8_t * buffer, size_t size);
+
+        };
+
+    }}
+
+#endif
@@ -0,0 +1,139 @@
+/*
+ * ALLOCATION TRACKER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_ALLOCATION_TRACKER_HEADER
+#define BASICS_ALLOCATION_TRACKER_HEADER
+
+    #include <atomic>
+    #include <basics/Non_Copyable>
+    #include <basics/Non_Instantiable>
+    #include <basics/types>
+
+    namespace basics
+    {
+
+        /**
+         * Cuenta las reservas de memoria dinámica que se hacen con los operadores new y delete
+         * globales (que se sustituyen al enlazar esta clase).
+         *
+         * Está desactivado por defecto y en ese caso cada reserva solo comprueba un flag. Los
+         * contadores de cada hilo solo los modifica su propio hilo, por lo que la diferencia entre
+         * dos lecturas de get_thread_counters() indica cuánto reservó el hilo entre ambas sin
+         * contar lo que hicieran los demás. El profiler la usa para atribuir las reservas a cada
+         * zona y el director a cada fase del fotograma.
+         */
+        class Allocation_Tracker : Non_Instantiable
+        {
+        public:
+
+            struct Counters
+            {
+                uint64_t allocations;
+                uint64_t deallocations;
+                uint64_t bytes;                         ///< Bytes reservados (no se restan los liberados).
+            };
+
+        private:
+
+            static std::atomic< bool     > enabled;
+            static std::atomic< unsigned > violations;
+
+            static thread_local Counters thread_counters;
+
+        public:
+
+            static void enable (bool state)
+            {
+                enabled.store (state, std::memory_order_relaxed);
+            }
+
+            static bool is_enabled ()
+            {
+                return enabled.load (std::memory_order_relaxed);
+            }
+
+            /**
+             * Retorna los contadores acumulados del hilo que llama desde que empezó.
+             */
+            static Counters get_thread_counters ()
+            {
+                return thread_counters;
+            }
+
+            /**
+             * Retorna el número de veces que ha fallado una comprobación de No_Allocation_Scope.
+             */
+            static unsigned get_violation_count ()
+            {
+                return violations;
+            }
+
+        public:
+
+            static void count_allocation (size_t size)
+            {
+                thread_counters.allocations += 1;
+                thread_counters.bytes       += size;
+            }
+
+            static void count_deallocation ()
+            {
+                thread_counters.deallocations += 1;
+            }
+
+            static void report_violation (const char * scope_name, uint64_t allocations, uint64_t bytes);
+
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Comprueba que el hilo que lo crea no reserva memoria dinámica hasta que se destruye. Si
+         * lo hace, lo indica en el log, lo contabiliza como infracción y, en las compilaciones de
+         * depuración, detiene el programa con assert(). Solo comprueba algo mientras el tracker
+         * está activado.
+         */
+        class No_Allocation_Scope : Non_Copyable
+        {
+
+            const char * name;
+            Allocation_Tracker::Counters start;
+
+        public:
+
+            No_Allocation_Scope(const char * scope_name)
+            {
+                name  = Allocation_Tracker::is_enabled () ? scope_name : nullptr;
+                start = Allocation_Tracker::get_thread_counters ();
+            }
+
+           ~No_Allocation_Scope()
+            {
+                if (name)
+                {
+                    Allocation_Tracker::Counters end = Allocation_Tracker::get_thread_counters ();
+
+                    if (end.allocations != start.allocations)
+                    {
+                        Allocation_Tracker::report_violation (name, end.allocations - start.allocations, end.bytes - start.bytes);
+                    }
+                }
+            }
+
+        };
+
+    }
+
+    #define BASICS_NO_ALLOCATION_SCOPE_NAME(LINE)  BASICS_NO_ALLOCATION_SCOPE_NAME_(LINE)
+    #define BASICS_NO_ALLOCATION_SCOPE_NAME_(LINE) basics_no_allocation_scope_##LINE
+
+    #define BASICS_ASSERT_NO_ALLOCATIONS(NAME) basics::No_Allocation_Scope BASICS_NO_ALLOCATION_SCOPE_NAME(__LINE__)(NAME)
+
+#endif
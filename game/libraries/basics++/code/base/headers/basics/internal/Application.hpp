@@ -14,6 +14,7 @@
 #define BASICS_APPLICATION_HEADER
 
     #include <memory>
+    #include <utility>
     #include <basics/Event_Queue>
 
     namespace basics
@@ -69,7 +70,7 @@
 
             void push (Event && event)
             {
-                event_queue.push (event);
+                event_queue.push (std::move (event));
             }
 
             bool poll (Event & event)
@@ -77,6 +78,14 @@
                 return event_queue.poll (event);
             }
 
+            /**
+             * Establece una señal que se activa cada vez que llega un evento nuevo.
+             */
+            void set_event_signal (Event_Signal * signal)
+            {
+                event_queue.set_signal (signal);
+            }
+
         };
 
         extern Application & application;
@@ -0,0 +1,181 @@
+/*
+ * ASSET CACHE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_ASSET_CACHE_HEADER
+#define BASICS_ASSET_CACHE_HEADER
+
+    #include <list>
+    #include <memory>
+    #include <mutex>
+    #include <string>
+    #include <unordered_map>
+    #include <vector>
+    #include <basics/Atlas>
+    #include <basics/Graphics_Context>
+    #include <basics/Non_Copyable>
+    #include <basics/Raster_Font>
+    #include <basics/Texture_2D>
+
+    namespace basics
+    {
+
+        /**
+         * Guarda las texturas, atlas y fuentes cargados indexados por su ruta (normalizada), de modo
+         * que al volver a pedir el mismo asset (por ejemplo, al reiniciar una escena) se comparte
+         * el que ya está en la GPU en lugar de leerlo, decodificarlo y subirlo otra vez.
+         *
+         * Los assets se reparten con shared_ptr. Mientras alguien que no sea la caché (o el contexto
+         * gráfico, en el caso de las texturas) tenga una referencia, el asset está en uso y no se
+         * descarta. Cuando la memoria de las texturas guardadas supera el presupuesto, se descartan
+         * los assets que no están en uso empezando por el que lleva más tiempo sin pedirse, y sus
+         * texturas se sacan del contexto para que se liberen.
+         *
+         * Se puede usar desde varios hilos, pero las operaciones que reciben el contexto gráfico
+         * (que son las que pueden liberar texturas) se deben llamar desde el hilo que lo tiene activo.
+         */
+        class Asset_Cache : Non_Copyable
+        {
+        public:
+
+            struct Statistics
+            {
+                unsigned hits;
+                unsigned misses;
+                unsigned evictions;
+                unsigned entries;
+                size_t   memory;                ///< Bytes de las texturas de los assets guardados.
+                size_t   budget;
+            };
+
+            static constexpr size_t default_budget = size_t(64) << 20;
+
+        private:
+
+            enum Kind
+            {
+                TEXTURE,
+                ATLAS,
+                FONT
+            };
+
+            typedef std::shared_ptr< Texture_2D > Texture_Handle;
+            typedef std::vector< Texture_Handle > Texture_List;
+
+            struct Entry
+            {
+                std::string             path;
+                Kind                    kind;
+                std::shared_ptr< void > asset;
+                Texture_List            textures;           ///< Se sacan del contexto al descartar el asset.
+                long                    own_references;     ///< Referencias al asset de la caché y del contexto.
+                size_t                  size;
+            };
+
+            typedef std::list< Entry >                                      Entry_List;
+            typedef std::unordered_map< std::string, Entry_List::iterator > Entry_Map;
+
+        private:
+
+            std::mutex mutex;
+            Entry_List entries;                             ///< Del usado más recientemente al que menos.
+            Entry_Map  entry_map;
+            size_t     budget;
+            size_t     memory;
+            unsigned   hits;
+            unsigned   misses;
+            unsigned   evictions;
+
+        public:
+
+            explicit Asset_Cache(size_t budget = default_budget);
+
+        public:
+
+            /**
+             * Retorna la ruta con los separadores unificados y sin segmentos "." ni "..", de modo
+             * que distintas formas de escribir la misma ruta correspondan al mismo asset.
+             */
+            static std::string normalize_path (const std::string & path);
+
+            /**
+             * Buscan un asset ya guardado y lo marcan como el usado más recientemente.
+             * @return El asset o nullptr si no está (o está guardado como otro tipo de asset).
+             */
+            std::shared_ptr< Texture_2D  > find_texture (const std::string & path)
+            {
+                return std::static_pointer_cast< Texture_2D  > (find (path, TEXTURE));
+            }
+
+            std::shared_ptr< Atlas       > find_atlas   (const std::string & path)
+            {
+                return std::static_pointer_cast< Atlas       > (find (path, ATLAS  ));
+            }
+
+            std::shared_ptr< Raster_Font > find_font    (const std::string & path)
+            {
+                return std::static_pointer_cast< Raster_Font > (find (path, FONT   ));
+            }
+
+            /**
+             * Guardan un asset recién cargado cuyas texturas ya se han añadido al contexto. Si ya
+             * había otro con la misma ruta (porque se cargó a la vez), se descarta el nuevo y se
+             * retorna el guardado. Después se descartan assets si se ha superado el presupuesto.
+             */
+            std::shared_ptr< Texture_2D  > add (const std::string & path, const std::shared_ptr< Texture_2D  > & texture, Graphics_Context::Accessor & context);
+            std::shared_ptr< Atlas       > add (const std::string & path, const std::shared_ptr< Atlas       > & atlas,   Graphics_Context::Accessor & context);
+            std::shared_ptr< Raster_Font > add (const std::string & path, const std::shared_ptr< Raster_Font > & font,    Graphics_Context::Accessor & context);
+
+            /**
+             * Retornan el asset guardado o, si no está, lo cargan sin esperar a otros hilos y lo
+             * guardan. Los assets que no se pueden cargar no se guardan.
+             * @return El asset o nullptr si no se pudo cargar.
+             */
+            std::shared_ptr< Texture_2D  > load_texture (const std::string & path, Graphics_Context::Accessor & context);
+            std::shared_ptr< Atlas       > load_atlas   (const std::string & path, Graphics_Context::Accessor & context);
+            std::shared_ptr< Raster_Font > load_font    (const std::string & path, Graphics_Context::Accessor & context);
+
+            /**
+             * Establece los bytes de textura que se pueden mantener guardados sin estar en uso. Se
+             * aplica al guardar el siguiente asset o al llamar a trim().
+             */
+            void set_budget (size_t new_budget)
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                budget = new_budget;
+            }
+
+            /**
+             * Descarta los assets que no están en uso, empezando por los menos usados recientemente,
+             * hasta que la memoria guardada no supere el presupuesto.
+             */
+            void trim (Graphics_Context::Accessor & context);
+
+            /**
+             * Descarta todos los assets guardados, estén en uso o no. Se usa antes de destruir el
+             * contexto gráfico para que las texturas se liberen mientras existe.
+             */
+            void clear (Graphics_Context::Accessor & context);
+
+            Statistics get_statistics ();
+
+        private:
+
+            std::shared_ptr< void > find   (const std::string & path, Kind kind);
+            std::shared_ptr< void > insert (Entry && entry, Graphics_Context::Accessor & context);
+
+            void evict   (Graphics_Context::Accessor & context);
+            void release (const Texture_List & textures, Graphics_Context::Accessor & context);
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,206 @@
+/*
+ * ASSET LOADER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_ASSET_LOADER_HEADER
+#define BASICS_ASSET_LOADER_HEADER
+
+    #include <atomic>
+    #include <condition_variable>
+    #include <deque>
+    #include <memory>
+    #include <mutex>
+    #include <string>
+    #include <thread>
+    #include <vector>
+    #include <basics/assert>
+    #include <basics/Asset_Cache>
+    #include <basics/Atlas>
+    #include <basics/Graphics_Context>
+    #include <basics/Non_Copyable>
+    #include <basics/Raster_Font>
+    #include <basics/Texture_2D>
+
+    namespace basics
+    {
+
+        /**
+         * Carga texturas, atlas y fuentes sin detener los fotogramas: la lectura de los archivos,
+         * el parseo de las definiciones y la decodificación de las imágenes se hacen en hilos de
+         * trabajo, y solo la creación de las texturas (la subida a la GPU) se hace en el hilo del
+         * contexto gráfico mediante upload(), con un límite de tiempo por fotograma.
+         *
+         * Cada petición retorna un Handle que indica cuándo está listo el asset, de modo que una
+         * escena puede seguir dibujando una animación de carga mientras tanto.
+         *
+         * Si se le asigna una Asset_Cache, los assets que ya están en ella se completan en el acto
+         * sin leer nada y los que se cargan se guardan en ella.
+         */
+        class Asset_Loader : Non_Copyable
+        {
+        private:
+
+            template< typename TYPE >
+            struct Result
+            {
+                std::atomic< bool >     ready;
+                std::shared_ptr< TYPE > asset;
+
+                Result() : ready(false)
+                {
+                }
+            };
+
+        public:
+
+            template< typename TYPE >
+            class Handle
+            {
+
+                friend class Asset_Loader;
+
+                std::shared_ptr< Result< TYPE > > result;
+
+            public:
+
+                /**
+                 * Indica si el handle corresponde a alguna petición.
+                 */
+                bool valid () const
+                {
+                    return result.get () != nullptr;
+                }
+
+                /**
+                 * Indica si la petición ha terminado, tanto si el asset se ha cargado como si no.
+                 */
+                bool is_ready () const
+                {
+                    return result && result->ready.load (std::memory_order_acquire);
+                }
+
+                /**
+                 * Retorna el asset cargado o nullptr si no se pudo cargar. Solo se debe llamar una
+                 * vez que is_ready() retorna true.
+                 */
+                const std::shared_ptr< TYPE > & get () const
+                {
+                    assert(is_ready ());
+
+                    return result->asset;
+                }
+
+            };
+
+            typedef Handle< Texture_2D  > Texture_Handle;
+            typedef Handle< Atlas       > Atlas_Handle;
+            typedef Handle< Raster_Font > Font_Handle;
+
+        private:
+
+            struct Request;
+            struct Texture_Request;
+            struct Atlas_Request;
+            struct Font_Request;
+
+            typedef std::shared_ptr< Request > Request_Handle;
+
+        private:
+
+            unsigned                     worker_count;
+            Asset_Cache                * cache;
+            std::vector< std::thread >   workers;           ///< Se crean con la primera petición.
+
+            std::mutex                   mutex;
+            std::condition_variable      work_available;
+            std::condition_variable      work_done;
+            std::deque< Request_Handle > decode_queue;      ///< Peticiones por leer y decodificar.
+            std::deque< Request_Handle > upload_queue;      ///< Peticiones decodificadas por subir.
+            unsigned                     pending_count;     ///< Peticiones que aún no han terminado.
+            bool                         exit;
+
+        public:
+
+            /**
+             * Crea el cargador.
+             * @param worker_count Número de hilos de trabajo. Si es 0 se usa uno menos que el
+             *     número de núcleos disponibles (y al menos uno).
+             */
+            Asset_Loader(unsigned worker_count = 0);
+
+           ~Asset_Loader();
+
+        public:
+
+            /**
+             * Asigna la caché en la que se buscan y se guardan los assets (o ninguna si es nullptr).
+             * Se debe asignar antes de hacer alguna petición.
+             */
+            void set_cache (Asset_Cache * new_cache)
+            {
+                cache = new_cache;
+            }
+
+            Texture_Handle load_texture (const std::string & path);
+            Atlas_Handle   load_atlas   (const std::string & path);
+            Font_Handle    load_font    (const std::string & path);
+
+            /**
+             * Crea en el contexto gráfico las texturas de las peticiones ya decodificadas y completa
+             * esas peticiones. Se debe llamar desde el hilo en el que el contexto está activo.
+             * @param budget Segundos que se pueden dedicar. Se sube al menos una textura aunque
+             *     tarde más, de modo que la carga siempre avanza.
+             * @return Número de peticiones completadas.
+             */
+            unsigned upload (Graphics_Context::Accessor & context, float budget);
+
+            /**
+             * Espera a que terminen todas las peticiones pendientes subiendo sus texturas a medida
+             * que se decodifican. Se debe llamar desde el hilo en el que el contexto está activo.
+             * Permite, por ejemplo, que una ejecución sin usuario sea reproducible.
+             */
+            void finish (Graphics_Context::Accessor & context);
+
+            /**
+             * Indica si alguna petición está esperando a upload().
+             */
+            bool has_uploads ()
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                return !upload_queue.empty ();
+            }
+
+            /**
+             * Retorna el número de peticiones que todavía no han terminado.
+             */
+            unsigned get_pending_count ()
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                return pending_count;
+            }
+
+        private:
+
+            /**
+             * Retorna un handle ya completado con el asset de la caché o, si no lo hay, pone en la
+             * cola una nueva petición del tipo indicado.
+             */
+            template< typename REQUEST, typename TYPE >
+            Handle< TYPE > load (const std::string & path, const std::shared_ptr< TYPE > & cached);
+
+            void enqueue (const Request_Handle & request);
+            void worker_function ();
+
+        };
+
+    }
+
+#endif
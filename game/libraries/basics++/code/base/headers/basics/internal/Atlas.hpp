@@ -13,11 +13,11 @@
 #ifndef BASICS_ATLAS_HEADER
 #define BASICS_ATLAS_HEADER
 
-    #include <map>
     #include <memory>
     #include <string>
     #include <vector>
     #include <rapidxml.hpp>
+    #include <basics/assert>
     #include <basics/Id>
     #include <basics/Point>
     #include <basics/Size>
@@ -27,6 +27,12 @@
     namespace basics
     {
 
+        /**
+         * Conjunto de slices (rectángulos con nombre) de una textura. Los slices se guardan en un
+         * array contiguo en el orden en que se añaden, y un índice ordenado por id permite buscarlos
+         * con una búsqueda binaria. Cada slice lleva sus coordenadas normalizadas en la textura, que
+         * se calculan al asignarla, de modo que dibujarlo no requiere ningún cálculo adicional.
+         */
         class Atlas
         {
         public:
@@ -40,24 +46,69 @@
                 float   top;
                 float   width;
                 float   height;
+                float   normalized_left;            ///< Coordenadas divididas entre el tamaño de la
+                float   normalized_right;           ///< textura (0 mientras el atlas no la tiene).
+                float   normalized_bottom;
+                float   normalized_top;
             };
 
+            /**
+             * Posición de un slice en el atlas. A diferencia de los punteros a los slices, no cambia
+             * al añadir nuevos slices, por lo que se puede obtener una vez con get_slice_handle() y
+             * usar después con el operador [] sin buscar el id.
+             */
+            typedef unsigned Slice_Handle;
+
+            static constexpr Slice_Handle no_slice = ~0u;
+
+            /**
+             * Rectángulo de un slice tal como lo genera basics-atlas-compiler en las cabeceras de
+             * los atlas compilados, donde los slices aparecen en el orden de sus handles.
+             */
+            struct Slice_Definition
+            {
+                Id    id;
+                float x;
+                float y;
+                float width;
+                float height;
+            };
+
+            typedef std::vector< byte >           Buffer;
+
         private:
 
+            struct Index_Entry
+            {
+                Id           id;
+                Slice_Handle handle;
+            };
+
             typedef std::shared_ptr< Texture_2D > Texture_Handle;
-            typedef std::map< Id, Slice >         Slice_Map;
-            typedef std::vector< byte >           Buffer;
+            typedef std::vector< Slice >          Slice_List;
+            typedef std::vector< Index_Entry >    Slice_Index;
 
         private:
 
             Texture_Handle texture;
-            Slice_Map      slices;
+            std::string    texture_path;
+            Slice_List     slices;
+            Slice_Index    index;                   ///< Ordenado por id.
 
         public:
 
             Atlas(const std::string    & path, Graphics_Context::Accessor & context);
             Atlas(const Texture_Handle & texture);
 
+            /**
+             * Lee la definición de los slices sin cargar la textura, por lo que no usa el contexto
+             * gráfico y se puede llamar desde cualquier hilo. El atlas no es válido hasta que se le
+             * asigna la textura con set_texture() (por ejemplo, la de get_texture_path()).
+             * La definición puede estar en formato binario (.atlas, ver write_binary()) o en XML
+             * (.sprites). El formato se detecta a partir del contenido del archivo.
+             */
+            explicit Atlas(const std::string & path);
+
         public:
 
             bool good () const
@@ -70,22 +121,71 @@
                 return texture;
             }
 
+            /**
+             * Retorna la ruta de la textura que indica la definición leída (o una cadena vacía si
+             * el atlas se creó a partir de una textura).
+             */
+            const std::string & get_texture_path () const
+            {
+                return texture_path;
+            }
+
+            /**
+             * Asigna la textura y recalcula las coordenadas normalizadas de todos los slices.
+             */
+            void set_texture (const Texture_Handle & new_texture);
+
             const Slice * get_slice (Id id) const
             {
-                Slice_Map::const_iterator slice = slices.find (id);
+                Slice_Handle handle = get_slice_handle (id);
 
-                return slice != slices.end () ? &slice->second : nullptr;
+                return handle != no_slice ? &slices[handle] : nullptr;
             }
 
+            /**
+             * Retorna el handle del slice con el id indicado o no_slice si no existe.
+             */
+            Slice_Handle get_slice_handle (Id id) const;
+
+            const Slice & operator [] (Slice_Handle handle) const
+            {
+                assert(handle < slices.size ());
+
+                return slices[handle];
+            }
+
+            size_t get_slice_count () const
+            {
+                return slices.size ();
+            }
+
+            /**
+             * Comprueba que el atlas tiene exactamente los slices indicados y que el handle de cada
+             * uno es su posición en el array, de modo que se puede acceder a ellos con índices
+             * constantes generados con basics-atlas-compiler sin buscar sus ids.
+             */
+            bool matches (const Slice_Definition * definitions, size_t count) const;
+
             /**
              * Añade un nuevo slice al atlas.
              * @param id Identificador del nuevo slice. No debe existir algún slice con el mismo id.
              * @param position Coordenadas del vértice inferior izquierdo del slice sobre la textura.
              * @param size Tamaño del slice dentro de la textura.
              * @return Puntero al slice si no existía otro con el mismo id o nullptr en caso contrario.
+             *     Los punteros a los slices dejan de ser válidos al añadir otro slice (los handles no).
              */
             Slice * add_slice (Id id, const Point2f & position, const Size2f & size);
 
+            /**
+             * Guarda la definición del atlas en formato binario: una cabecera con versión, el nombre
+             * del archivo de la textura y los slices ordenados por id. Se carga con una sola lectura
+             * y sin parsear nada, por lo que es mucho más rápido que el XML. Lo usa la herramienta
+             * basics-atlas-compiler para convertir los archivos .sprites.
+             * @param data Buffer en el que se deja el contenido del archivo.
+             * @return false si el atlas no tiene una textura con nombre o no tiene slices.
+             */
+            bool write_binary (Buffer & data) const;
+
             operator bool () const
             {
                 return this->good ();
@@ -93,8 +193,11 @@
 
         private:
 
-            void parse     (Buffer           & slices_data, const std::string & path, Graphics_Context::Accessor & context);
-            void parse_img (rapidxml::xml_node<> * img_tag, const std::string & path, Graphics_Context::Accessor & context);
+            void set_normalized_coordinates (Slice & slice) const;
+
+            bool load      (const Buffer     & slices_data, const std::string & path);
+            void parse     (Buffer           & slices_data, const std::string & path);
+            void parse_img (rapidxml::xml_node<> * img_tag, const std::string & path);
             void parse_dir (rapidxml::xml_node<> * dir_tag, const std::string & prefix = std::string());
             void parse_spr (rapidxml::xml_node<> * spr_tag, const std::string & id);
 
@@ -57,6 +57,17 @@
                 Size2u size;
             };
 
+            /**
+             * Contadores de actividad del canvas. Un lote (batch) es un grupo de quads texturizados
+             * que se envía con una sola llamada de dibujado.
+             */
+            struct Statistics
+            {
+                unsigned quads;
+                unsigned batches;
+                unsigned draw_calls;
+            };
+
         public:
 
             typedef Canvas * (* Factory) (Id id, Graphics_Context::Accessor & context, const Options & options);
@@ -82,12 +93,46 @@
 
         protected:
 
+            Statistics statistics;                  ///< Contadores del último fotograma completado.
+            Statistics frame_statistics;            ///< Contadores del fotograma en curso.
+
+        protected:
+
+            Canvas()
+            :
+                statistics      { 0, 0, 0 },
+                frame_statistics{ 0, 0, 0 }
+            {
+            }
+
             virtual ~Canvas() = default;
 
+        public:
+
+            /**
+             * Retorna los contadores del último fotograma presentado.
+             */
+            const Statistics & get_statistics () const
+            {
+                return statistics;
+            }
+
+            void flush () override
+            {
+                statistics       = frame_statistics;
+                frame_statistics = { 0, 0, 0 };
+            }
+
         public:
 
             virtual void reset_state     () { }
 
+            /**
+             * Activa o desactiva la agrupación de quads texturizados en lotes. Cuando no está
+             * activada, cada quad se dibuja de inmediato con su propia llamada de dibujado.
+             */
+            virtual void set_batching    (bool enabled) { }
+
         public:
 
             virtual void set_size        (const Size2u & size) { }
@@ -98,6 +143,15 @@
             virtual void set_color       (float r, float g, float b) { }
             virtual void set_opacity     (float opacity) { }
             virtual void set_blending    (Blending blending) { }
+
+            /**
+             * Establece la capa en la que se dibujan las siguientes operaciones. Lo que se dibuja en
+             * una capa queda siempre por encima de lo que se dibuja en capas inferiores, aunque se
+             * haya dibujado antes. Dentro de una misma capa el canvas puede reordenar las operaciones
+             * que no se solapan para agruparlas mejor. Valores de 0 a 255.
+             */
+            virtual void set_layer       (unsigned layer) { }
+
             virtual void set_transform   (const Transformation2f & transform) { }
             virtual void apply_transform (const Transformation2f & transform) { }
 
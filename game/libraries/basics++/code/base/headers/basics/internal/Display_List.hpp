@@ -0,0 +1,158 @@
+/*
+ * DISPLAY LIST
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_DISPLAY_LIST_HEADER
+#define BASICS_DISPLAY_LIST_HEADER
+
+    #include <vector>
+    #include <basics/Canvas>
+
+    namespace basics
+    {
+
+        /**
+         * Canvas que no dibuja nada: registra las operaciones que recibe para reproducirlas más
+         * tarde sobre otro canvas, posiblemente desde otro hilo.
+         *
+         * Solo se guardan punteros a las texturas y a los slices, por lo que estos deben seguir
+         * existiendo hasta que la lista se reproduzca o se descarte.
+         */
+        class Display_List : public Canvas
+        {
+        private:
+
+            struct Command
+            {
+                enum Type
+                {
+                    RESET_STATE,
+                    SET_CLEAR_COLOR,
+                    SET_COLOR,
+                    SET_OPACITY,
+                    SET_BLENDING,
+                    SET_LAYER,
+                    SET_TRANSFORM,
+                    APPLY_TRANSFORM,
+                    CLEAR,
+                    DRAW_POINT,
+                    DRAW_SEGMENT,
+                    DRAW_TRIANGLE,
+                    FILL_TRIANGLE,
+                    DRAW_RECTANGLE,
+                    FILL_RECTANGLE,
+                    FILL_TEXTURED_RECTANGLE,
+                    FILL_SLICED_RECTANGLE
+                };
+
+                Type         type;
+                float        values[6];         ///< Coordenadas, tamaños o componentes de color.
+                unsigned     index;             ///< Transformación, capa o modo de blending.
+                int          handling;
+                const void * resource;          ///< Textura o slice.
+            };
+
+            typedef std::vector< Command          > Command_List;
+            typedef std::vector< Transformation2f > Transformation_List;
+
+            /**
+             * Capacidad que se reserva al construir la lista para que un fotograma típico se pueda
+             * registrar sin reservar memoria una vez en marcha.
+             */
+            static constexpr size_t initial_command_capacity   = 1024;
+            static constexpr size_t initial_transform_capacity =  128;
+
+        private:
+
+            Command_List        commands;
+            Transformation_List transforms;
+            Size2u              size;
+
+        public:
+
+            Display_List()
+            :
+                size{ 0, 0 }
+            {
+                commands  .reserve (initial_command_capacity  );
+                transforms.reserve (initial_transform_capacity);
+            }
+
+           ~Display_List() = default;
+
+        public:
+
+            /**
+             * Retorna el tamaño que se estableció con set_size(). Es el que se debe usar al crear el
+             * canvas sobre el que se reproduzca la lista.
+             */
+            const Size2u & get_size () const
+            {
+                return size;
+            }
+
+            bool is_empty () const
+            {
+                return commands.empty ();
+            }
+
+            /**
+             * Elimina las operaciones registradas conservando la memoria reservada.
+             */
+            void discard ()
+            {
+                commands  .clear ();
+                transforms.clear ();
+            }
+
+            /**
+             * Envía al canvas indicado todas las operaciones registradas en el mismo orden.
+             */
+            void replay (Canvas & canvas) const;
+
+        public:
+
+            void reset_state     () override;
+
+            void set_size        (const Size2u & new_size) override
+            {
+                size = new_size;
+            }
+
+        public:
+
+            void set_clear_color (float r, float g, float b) override;
+            void set_color       (float r, float g, float b) override;
+            void set_opacity     (float opacity) override;
+            void set_blending    (Blending blending) override;
+            void set_layer       (unsigned layer) override;
+            void set_transform   (const Transformation2f & transform) override;
+            void apply_transform (const Transformation2f & transform) override;
+
+        public:
+
+            void clear           () override;
+            void draw_point      (const Point2f & position) override;
+            void draw_segment    (const Point2f & a, const Point2f & b) override;
+            void draw_triangle   (const Point2f & a, const Point2f & b, const Point2f & c) override;
+            void fill_triangle   (const Point2f & a, const Point2f & b, const Point2f & c) override;
+            void draw_rectangle  (const Point2f & bottom_left, const Size2f & size) override;
+            void fill_rectangle  (const Point2f & bottom_left, const Size2f & size) override;
+            void fill_rectangle  (const Point2f & where, const Size2f & size, const Texture_2D   * texture, int handling = CENTER) override;
+            void fill_rectangle  (const Point2f & where, const Size2f & size, const Atlas::Slice * slice,   int handling = CENTER) override;
+
+        private:
+
+            Command & add (Command::Type type);
+
+        };
+
+    }
+
+#endif
@@ -13,9 +13,9 @@
 #ifndef BASICS_EVENT_HEADER
 #define BASICS_EVENT_HEADER
 
-    #include <map>
     #include <basics/fnv>
     #include <basics/Id>
+    #include <basics/Tiny_Map>
     #include <basics/Var>
 
     namespace basics
@@ -25,7 +25,9 @@
         {
         public:
 
-            typedef std::map< Id, Var > Property_List;      // REEMPLAZAR POR UN MAPA "LIGERO"
+            /// Las propiedades se guardan dentro del propio evento para que crearlo, copiarlo o
+            /// moverlo no reserve memoria dinámica.
+            typedef Tiny_Map< Id, Var, 8 > Property_List;
 
         public:
 
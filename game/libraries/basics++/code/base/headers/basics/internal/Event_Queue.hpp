@@ -13,69 +13,162 @@
 #ifndef BASICS_EVENT_QUEUE_HEADER
 #define BASICS_EVENT_QUEUE_HEADER
 
-    #include <queue>
-    #include <mutex>
+    #include <atomic>
+    #include <cstddef>
+    #include <memory>
+    #include <vector>
     #include <basics/Event>
+    #include <basics/Event_Signal>
+    #include <basics/Non_Copyable>
 
     namespace basics
     {
 
-        class Event_Queue
+        /**
+         * Cola de eventos de capacidad fija sin bloqueos. Varios hilos pueden añadir eventos a la
+         * vez, pero solo uno puede extraerlos (poll(), peek(), drain() y clear()).
+         *
+         * Cada posición del búfer circular lleva un número de secuencia que indica si está libre
+         * para la vuelta en curso o si ya contiene un evento listo para extraerse, por lo que los
+         * hilos productores solo compiten entre ellos por avanzar la posición de escritura.
+         */
+        class Event_Queue : Non_Copyable
         {
+        public:
+
+            /**
+             * Qué hacer cuando se añade un evento a la cola llena. Con WAIT, el hilo que extrae los
+             * eventos nunca debe añadirlos y debe seguir extrayéndolos mientras otros los añaden,
+             * ya que de lo contrario los productores esperarían para siempre.
+             */
+            enum Overflow_Policy
+            {
+                WAIT,                           ///< El productor espera a que se extraiga algún evento.
+                DISCARD                         ///< El evento nuevo se descarta y se contabiliza.
+            };
+
+            static constexpr unsigned default_capacity = 256;
+
+        private:
+
+            struct Slot
+            {
+                std::atomic< size_t > sequence;
+                Event                 event;
+            };
+
+            // Las posiciones de escritura y lectura se separan para que no compartan línea de caché:
+
+            static constexpr size_t cache_line_size = 64;
+
+        private:
+
+            std::unique_ptr< Slot[] > slots;
+            size_t                    mask;                 ///< Capacidad - 1 (la capacidad es potencia de 2).
+            Overflow_Policy           overflow_policy;
+            Event_Signal            * signal;
+
+            std::atomic< size_t >     write_position;
+            char                      write_padding[cache_line_size - sizeof(std::atomic< size_t >)];
+            std::atomic< size_t >     read_position;
+            char                      read_padding [cache_line_size - sizeof(std::atomic< size_t >)];
+
+            std::atomic< unsigned >   high_water_mark;      ///< Mayor número de eventos pendientes.
+            std::atomic< unsigned >   discarded_count;
+
+        public:
 
-            std::queue< Event > queue;
-            std::mutex          mutex;
+            /**
+             * @param capacity Número máximo de eventos pendientes. Se redondea a la siguiente
+             *     potencia de 2.
+             */
+            Event_Queue(unsigned capacity = default_capacity, Overflow_Policy policy = WAIT);
 
         public:
 
-            void clear ()
+            /**
+             * Establece la señal que se activa cada vez que se añade un evento (nullptr para
+             * ninguna).
+             */
+            void set_signal (Event_Signal * new_signal)
             {
-                std::queue< Event >().swap (queue);
+                signal = new_signal;
             }
 
-            void push (const Event & event)
+            void set_overflow_policy (Overflow_Policy policy)
             {
-                std::lock_guard< std::mutex > lock(mutex);
+                overflow_policy = policy;
+            }
+
+        public:
 
-                queue.push (event);
+            unsigned get_capacity () const
+            {
+                return unsigned(mask + 1);
             }
 
-            void push (Event && event)
+            /**
+             * Retorna el número de eventos pendientes. Si otros hilos están usando la cola, el
+             * valor es solo aproximado.
+             */
+            unsigned get_depth () const
             {
-                std::lock_guard< std::mutex > lock(mutex);
+                size_t written = write_position.load (std::memory_order_relaxed);
+                size_t read    = read_position .load (std::memory_order_relaxed);
 
-                queue.push (event);
+                return written > read ? unsigned(written - read) : 0;
             }
 
-            bool poll (Event & event)
+            unsigned get_high_water_mark () const
             {
-                std::lock_guard< std::mutex > lock(mutex);
+                return high_water_mark;
+            }
 
-                if (queue.size () > 0)
-                {
-                    event = queue.front ();
+            /**
+             * Retorna el número de eventos que se han descartado por encontrar la cola llena.
+             */
+            unsigned get_discarded_count () const
+            {
+                return discarded_count;
+            }
 
-                    queue.pop ();
+            void reset_high_water_mark ()
+            {
+                high_water_mark = get_depth ();
+            }
 
-                    return true;
-                }
+        public:
 
-                return false;
+            /**
+             * Añade una copia del evento.
+             * @return false si el evento se descartó porque la cola estaba llena.
+             */
+            bool push (const Event & event)
+            {
+                return push (Event(event));
             }
 
-            bool peek (Event & event)
-            {
-                std::lock_guard< std::mutex > lock(mutex);
+            /**
+             * Añade el evento moviéndolo a la cola.
+             * @return false si el evento se descartó porque la cola estaba llena.
+             */
+            bool push (Event && event);
 
-                if (queue.size () > 0)
-                {
-                    event = queue.front ();
+            bool poll (Event & event);
+            bool peek (Event & event);
 
-                    return true;
-                }
+            /**
+             * Extrae de una vez todos los eventos pendientes y los deja en la lista indicada, cuyo
+             * contenido anterior se descarta.
+             * @return El número de eventos extraídos.
+             */
+            unsigned drain (std::vector< Event > & events);
 
-                return false;
-            }
+            void clear ();
+
+        private:
+
+            void update_high_water_mark (size_t written);
 
         };
 
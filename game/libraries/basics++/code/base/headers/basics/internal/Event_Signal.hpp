@@ -0,0 +1,69 @@
+/*
+ * EVENT SIGNAL
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_EVENT_SIGNAL_HEADER
+#define BASICS_EVENT_SIGNAL_HEADER
+
+    #include <condition_variable>
+    #include <mutex>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Permite que un hilo duerma hasta que otro le avise de que hay eventos nuevos. Los avisos
+         * que llegan cuando nadie espera no se pierden: la siguiente espera retorna de inmediato.
+         */
+        class Event_Signal : Non_Copyable
+        {
+
+            std::mutex              mutex;
+            std::condition_variable condition;
+            bool                    signaled;
+
+        public:
+
+            Event_Signal()
+            :
+                signaled(false)
+            {
+            }
+
+        public:
+
+            void notify ()
+            {
+                {
+                    std::lock_guard< std::mutex > lock(mutex);
+
+                    signaled = true;
+                }
+
+                condition.notify_all ();
+            }
+
+            /**
+             * Espera hasta que se llame a notify() si no se ha llamado desde la espera anterior.
+             */
+            void wait ()
+            {
+                std::unique_lock< std::mutex > lock(mutex);
+
+                condition.wait (lock, [this] () { return signaled; });
+
+                signaled = false;
+            }
+
+        };
+
+    }
+
+#endif
@@ -0,0 +1,72 @@
+/*
+ * FRAME PACER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_FRAME_PACER_HEADER
+#define BASICS_FRAME_PACER_HEADER
+
+    #include <chrono>
+
+    namespace basics
+    {
+
+        /**
+         * Espera hasta el instante en que debe empezar cada fotograma para mantener una frecuencia
+         * de fotogramas constante. Duerme mientras falta más de un margen y apura el resto cediendo
+         * el procesador, ya que el sistema puede despertar al hilo bastante después de lo pedido.
+         */
+        class Frame_Pacer
+        {
+        public:
+
+            typedef std::chrono::steady_clock Clock;
+
+        private:
+
+            Clock::duration   period;               ///< Duración de cada fotograma (0 si no se espera).
+            Clock::duration   spin_margin;          ///< Parte final de la espera que no se duerme.
+            Clock::time_point deadline;             ///< Instante en que empieza el siguiente fotograma.
+
+        public:
+
+            Frame_Pacer()
+            :
+                period     (Clock::duration::zero ()),
+                spin_margin(std::chrono::milliseconds(2))
+            {
+            }
+
+        public:
+
+            /**
+             * Establece la duración de los fotogramas en segundos. Si no es positiva, wait() retorna
+             * de inmediato.
+             */
+            void set_frame_duration (float seconds);
+
+            /**
+             * Hace que el siguiente fotograma empiece una duración después del momento actual. Se debe
+             * llamar cuando se reanuda el bucle tras haber estado parado.
+             */
+            void reset ()
+            {
+                deadline = Clock::now () + period;
+            }
+
+            /**
+             * Espera hasta el instante en que debe empezar el siguiente fotograma. Si ese instante ya
+             * ha pasado no espera, y si se ha perdido más de un fotograma deja de intentar recuperarlo.
+             */
+            void wait ();
+
+        };
+
+    }
+
+#endif
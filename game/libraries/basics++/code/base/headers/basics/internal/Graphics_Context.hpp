@@ -13,6 +13,7 @@
 #ifndef BASICS_GRAPHICS_CONTEXT_HEADER
 #define BASICS_GRAPHICS_CONTEXT_HEADER
 
+    #include <algorithm>
     #include <map>
     #include <memory>
     #include <mutex>
@@ -24,6 +25,7 @@
     #include <basics/Graphics_Resource_Cache>
     #include <basics/Id>
     #include <basics/Point>
+    #include <basics/Renderer>
     #include <basics/Size>
     #include <basics/types>
 
@@ -176,6 +178,25 @@
                 return false;
             }
 
+            /**
+             * Saca un recurso de la lista del contexto. Si nadie más lo usa, se destruye en el hilo
+             * que llama, que debe ser el que tiene el contexto activo.
+             * @return false si el recurso no estaba en la lista.
+             */
+            bool remove (const std::shared_ptr< Graphics_Resource > & resource)
+            {
+                Resource_List::iterator item = std::find (resources.begin (), resources.end (), resource);
+
+                if (item != resources.end ())
+                {
+                    resources.erase (item);
+
+                    return true;
+                }
+
+                return false;
+            }
+
         public:
 
             virtual void initialize ()
@@ -202,6 +223,18 @@
                 }
             }
 
+            /**
+             * Vuelca las operaciones pendientes de todos los renderers. Las especializaciones deben
+             * llamarlo desde flush_and_display() antes de presentar el fotograma.
+             */
+            void flush_renderers ()
+            {
+                for (auto & renderer : renderers)
+                {
+                    renderer.second->flush ();
+                }
+            }
+
             virtual void invalidate () = 0;
             virtual void suspend () = 0;
             virtual bool resume () = 0;
@@ -218,6 +251,12 @@
             virtual void set_viewport (const Point2u & bottom_left, const Size2u & size) = 0;
 
             virtual bool make_current () = 0;
+
+            /**
+             * Deja de usar el contexto en el hilo que lo tiene activo para que se pueda activar en
+             * otro hilo con make_current().
+             */
+            virtual bool release_current () = 0;
             virtual bool flush_and_display () = 0;
 
         };
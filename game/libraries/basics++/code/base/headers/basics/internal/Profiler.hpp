@@ -0,0 +1,179 @@
+/*
+ * PROFILER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_PROFILER_HEADER
+#define BASICS_PROFILER_HEADER
+
+    #include <atomic>
+    #include <chrono>
+    #include <string>
+    #include <vector>
+    #include <basics/Allocation_Tracker>
+    #include <basics/Non_Copyable>
+    #include <basics/Non_Instantiable>
+    #include <basics/types>
+
+    namespace basics
+    {
+
+        /**
+         * Registro de zonas de tiempo (intervalos con nombre) para ver en qué se va cada fotograma.
+         *
+         * Cada hilo guarda sus zonas en su propio búfer circular, por lo que registrar una zona
+         * nunca bloquea ni compite con otros hilos. Cuando el búfer se llena, las zonas nuevas
+         * sustituyen a las más antiguas, de modo que el resumen y la exportación siempre se
+         * refieren a la ventana de tiempo más reciente.
+         *
+         * Mientras el profiler está desactivado (lo está por defecto), una zona solo cuesta
+         * comprobar un flag. Definiendo BASICS_DISABLE_PROFILER las zonas desaparecen del todo.
+         */
+        class Profiler : Non_Instantiable
+        {
+        public:
+
+            /**
+             * Estadísticas de una zona en milisegundos.
+             */
+            struct Zone_Summary
+            {
+                std::string name;
+                unsigned    count;
+                double      min;
+                double      average;
+                double      p99;                ///< Percentil 99.
+                double      total;
+                double      allocations;        ///< Media de reservas de memoria (ver Allocation_Tracker).
+                double      bytes;              ///< Media de bytes reservados.
+            };
+
+            typedef std::vector< Zone_Summary > Summary;
+
+            static constexpr unsigned samples_per_thread = 8192;
+
+        private:
+
+            static std::atomic< bool > enabled;
+
+        public:
+
+            static void enable (bool state)
+            {
+                enabled.store (state, std::memory_order_relaxed);
+            }
+
+            static bool is_enabled ()
+            {
+                return enabled.load (std::memory_order_relaxed);
+            }
+
+            /**
+             * Retorna el instante actual en nanosegundos con el reloj que usan las zonas.
+             */
+            static uint64_t now ()
+            {
+                return uint64_t
+                (
+                    std::chrono::duration_cast< std::chrono::nanoseconds >
+                    (
+                        std::chrono::steady_clock::now ().time_since_epoch ()
+                    )
+                    .count ()
+                );
+            }
+
+            /**
+             * Registra una zona que ya ha terminado en el búfer del hilo que llama.
+             * @param name Debe ser una cadena que exista mientras exista el registro (normalmente
+             *     un literal).
+             * @param allocations Reservas de memoria que el hilo hizo durante la zona.
+             * @param bytes Bytes que el hilo reservó durante la zona.
+             */
+            static void record (const char * name, uint64_t start, uint64_t end, uint64_t allocations = 0, uint64_t bytes = 0);
+
+            /**
+             * Descarta las zonas registradas hasta el momento en todos los hilos.
+             */
+            static void clear ();
+
+        public:
+
+            /**
+             * Calcula las estadísticas de cada zona con las muestras que contienen los búferes,
+             * ordenadas por tiempo total de mayor a menor.
+             */
+            static void get_summary (Summary & summary);
+
+            /**
+             * Escribe el resumen en el log, una zona por línea.
+             */
+            static void log_summary ();
+
+            /**
+             * Guarda las zonas registradas en un archivo JSON con el formato de trazas de Chrome
+             * (se puede abrir con chrome://tracing o con Perfetto).
+             */
+            static bool write_chrome_trace (const std::string & path);
+
+        };
+
+        // -----------------------------------------------------------------------------------------
+
+        /**
+         * Mide el tiempo que transcurre desde que se crea hasta que se destruye y lo registra en el
+         * profiler si este estaba activado al crearla, junto con la memoria que el hilo reservó
+         * mientras tanto.
+         */
+        class Profile_Zone : Non_Copyable
+        {
+
+            const char                 * name;
+            uint64_t                     start;
+            Allocation_Tracker::Counters counters;
+
+        public:
+
+            Profile_Zone(const char * zone_name)
+            :
+                name    (Profiler::is_enabled () ? zone_name : nullptr),
+                start   (0),
+                counters{}
+            {
+                if (name)
+                {
+                    counters = Allocation_Tracker::get_thread_counters ();
+                    start    = Profiler::now ();
+                }
+            }
+
+           ~Profile_Zone()
+            {
+                if (name)
+                {
+                    uint64_t                     end     = Profiler::now ();
+                    Allocation_Tracker::Counters current = Allocation_Tracker::get_thread_counters ();
+
+                    Profiler::record (name, start, end, current.allocations - counters.allocations, current.bytes - counters.bytes);
+                }
+            }
+
+        };
+
+    }
+
+    #define BASICS_PROFILE_ZONE_NAME(LINE)  BASICS_PROFILE_ZONE_NAME_(LINE)
+    #define BASICS_PROFILE_ZONE_NAME_(LINE) basics_profile_zone_##LINE
+
+    #if defined(BASICS_DISABLE_PROFILER)
+        #define BASICS_PROFILE_ZONE(NAME)
+    #else
+        #define BASICS_PROFILE_ZONE(NAME) basics::Profile_Zone BASICS_PROFILE_ZONE_NAME(__LINE__)(NAME)
+    #endif
+
+#endif
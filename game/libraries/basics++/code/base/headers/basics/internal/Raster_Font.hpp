@@ -14,8 +14,8 @@
 #define BASICS_RASTER_FONT_HEADER
 
     #include <memory>
-    #include <unordered_map>
     #include <vector>
+    #include <basics/assert>
     #include <basics/Atlas>
     #include <basics/Font>
     #include <basics/Vector>
@@ -23,6 +23,11 @@
     namespace basics
     {
 
+        /**
+         * Fuente con los caracteres en una o varias texturas (páginas), que se lee de un archivo de
+         * BMFont en formato XML o binario (versión 3). El formato se detecta a partir del contenido
+         * del archivo.
+         */
         class Raster_Font : public Font
         {
         public:
@@ -35,27 +40,47 @@
 
             struct Character : public Font::Character
             {
-                Atlas::Slice * slice;
+                const Atlas::Slice * slice;         ///< nullptr en las entradas de la tabla sin carácter.
                 Vector2f       offset;
                 float          advance;
             };
 
+            /// Los caracteres con un código menor se buscan directamente en una tabla.
+            static constexpr uint32_t direct_range = 256;
+
         private:
 
-            typedef std::unordered_map< uint32_t, Character > Character_Map;
-            typedef std::vector< byte >                       Buffer;
-            typedef std::unique_ptr< Atlas >                  Atlas_Handle;
+            struct Coded_Character
+            {
+                uint32_t  code;
+                Character character;
+            };
+
+            typedef std::vector< Character       > Character_Table;
+            typedef std::vector< Coded_Character > Character_List;
+            typedef std::vector< byte >            Buffer;
+            typedef std::unique_ptr< Atlas >       Atlas_Handle;
 
         private:
 
-            Character_Map character_map;
-            Atlas_Handle  atlas;
-            Metrics       metrics;
+            Character_Table             direct_characters;      ///< Basic Latin y Latin-1 indexados por su código.
+            Character_List              other_characters;       ///< El resto, ordenados por su código.
+            std::vector< Atlas_Handle > pages;
+            std::vector< std::string >  texture_paths;
+            Metrics                     metrics;
+            bool                        parsed;
 
         public:
 
             Raster_Font(const std::string & path, Graphics_Context::Accessor & context);
 
+            /**
+             * Lee la definición de la fuente sin cargar sus texturas, por lo que no usa el contexto
+             * gráfico y se puede llamar desde cualquier hilo. La fuente no es válida hasta que se
+             * le asigna a cada página la textura de get_texture_path() con set_texture().
+             */
+            explicit Raster_Font(const std::string & path);
+
         public:
 
             const Metrics & get_metrics () const
@@ -63,18 +88,51 @@
                 return metrics;
             }
 
+            unsigned get_page_count () const
+            {
+                return unsigned(texture_paths.size ());
+            }
+
+            const std::string & get_texture_path (unsigned page = 0) const
+            {
+                assert(page < texture_paths.size ());
+
+                return texture_paths[page];
+            }
+
+            const std::shared_ptr< Texture_2D > & get_texture (unsigned page = 0) const
+            {
+                assert(page < pages.size ());
+
+                return pages[page]->get_texture ();
+            }
+
+            void set_texture (const std::shared_ptr< Texture_2D > & texture, unsigned page = 0);
+
             const Character * get_character (uint32_t code) const
             {
-                Character_Map::const_iterator item = character_map.find (code);
+                if (code < direct_range)
+                {
+                    const Character & character = direct_characters[code];
+
+                    return character.slice ? &character : nullptr;
+                }
 
-                return item != character_map.end () ? &item->second : nullptr;
+                return find_character (code);
             }
 
         private:
 
-            bool parse        (Buffer & font_data, const std::string & path, Graphics_Context::Accessor & context);
-            bool parse_font   (rapidxml::xml_node<> *   font_tag, const std::string & path, Graphics_Context::Accessor & context);
-            bool parse_pages  (rapidxml::xml_node<> *  pages_tag, const std::string & path, Graphics_Context::Accessor & context);
+            const Character * find_character (uint32_t code) const;
+
+            bool add_page      (const std::string & path, const char * file_name);
+            bool add_character (uint32_t code, unsigned page, int x, int y, int width, int height, int x_offset, int y_offset, int advance);
+            bool link_characters ();
+
+            bool load         (const Buffer & font_data, const std::string & path);
+            bool parse        (Buffer & font_data, const std::string & path);
+            bool parse_font   (rapidxml::xml_node<> *   font_tag, const std::string & path);
+            bool parse_pages  (rapidxml::xml_node<> *  pages_tag, const std::string & path);
             bool parse_info   (rapidxml::xml_node<> *   info_tag);
             bool parse_common (rapidxml::xml_node<> * common_tag);
             bool parse_chars  (rapidxml::xml_node<> *  chars_tag);
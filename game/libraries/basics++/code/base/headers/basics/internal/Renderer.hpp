@@ -24,6 +24,14 @@
             Renderer() = default;
             virtual ~Renderer() = default;
 
+        public:
+
+            /**
+             * El contexto gráfico llama a este método justo antes de presentar cada fotograma para
+             * que el renderer envíe las operaciones de dibujado que pueda tener pendientes.
+             */
+            virtual void flush () { }
+
         };
 
     }
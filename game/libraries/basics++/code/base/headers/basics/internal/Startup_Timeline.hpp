@@ -0,0 +1,133 @@
+/*
+ * STARTUP TIMELINE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_STARTUP_TIMELINE_HEADER
+#define BASICS_STARTUP_TIMELINE_HEADER
+
+    #include <atomic>
+    #include <string>
+    #include <vector>
+    #include <basics/Non_Copyable>
+    #include <basics/Non_Instantiable>
+    #include <basics/Profiler>
+
+    namespace basics
+    {
+
+        /**
+         * Cronología del arranque: hitos (instantes con nombre, como la creación de la aplicación
+         * o la presentación del primer fotograma) e intervalos (como la lectura, decodificación y
+         * subida de cada asset) medidos desde que se inició el proceso.
+         *
+         * A diferencia de las zonas del Profiler, los nombres pueden ser dinámicos (por ejemplo,
+         * incluir la ruta del asset), porque solo se registran unos pocos durante el arranque.
+         * Los hitos se registran siempre, incluso antes de main(), mientras que los intervalos
+         * solo se registran con la cronología activada.
+         */
+        class Startup_Timeline : Non_Instantiable
+        {
+        public:
+
+            struct Entry
+            {
+                std::string name;
+                uint64_t    start;              ///< Nanosegundos con el reloj de Profiler::now().
+                uint64_t    end;                ///< Igual a start en los hitos.
+                unsigned    thread;
+                bool        milestone;
+            };
+
+            typedef std::vector< Entry > Entry_List;
+
+            /// Límite de entradas para que los hitos no crezcan sin fin en una ejecución larga.
+            static constexpr unsigned max_entries = 4096;
+
+        private:
+
+            static std::atomic< bool > enabled;
+
+        public:
+
+            static void enable (bool state)
+            {
+                enabled.store (state, std::memory_order_relaxed);
+            }
+
+            static bool is_enabled ()
+            {
+                return enabled.load (std::memory_order_relaxed);
+            }
+
+            /**
+             * Retorna el instante en el que se inició el proceso con el reloj de Profiler::now().
+             * Se calcula a partir de lo que informa el sistema, por lo que su resolución puede ser
+             * de varios milisegundos. Si no se puede conocer, se retorna el de la primera entrada.
+             */
+            static uint64_t get_process_start ();
+
+            static void mark   (const std::string & name);
+            static void record (const std::string & name, uint64_t start, uint64_t end);
+
+            /**
+             * Copia las entradas registradas ordenadas por su inicio.
+             */
+            static void get_entries (Entry_List & entries);
+
+            /**
+             * Escribe en el log cada entrada con su instante y su duración desde el inicio del
+             * proceso.
+             */
+            static void log_timeline ();
+
+            /**
+             * Guarda la cronología en el formato de trazas de Chrome (chrome://tracing) tomando
+             * como origen el inicio del proceso.
+             */
+            static bool write_chrome_trace (const std::string & path);
+
+        };
+
+        /**
+         * Registra un intervalo de la cronología desde su construcción hasta su destrucción. Un
+         * nombre vacío (que es lo que usa BASICS_STARTUP_SPAN con la cronología desactivada) no se
+         * registra.
+         */
+        class Startup_Span : Non_Copyable
+        {
+
+            std::string name;
+            uint64_t    start;
+
+        public:
+
+            Startup_Span(std::string && span_name) : name(std::move (span_name))
+            {
+                start = name.empty () ? 0 : Profiler::now ();
+            }
+
+           ~Startup_Span()
+            {
+                if (!name.empty ()) Startup_Timeline::record (name, start, Profiler::now ());
+            }
+
+        };
+
+    }
+
+    #define BASICS_STARTUP_SPAN_NAME(LINE)  BASICS_STARTUP_SPAN_NAME_(LINE)
+    #define BASICS_STARTUP_SPAN_NAME_(LINE) basics_startup_span_##LINE
+
+    /**
+     * El nombre solo se construye si la cronología está activada.
+     */
+    #define BASICS_STARTUP_SPAN(NAME) \
+        basics::Startup_Span BASICS_STARTUP_SPAN_NAME(__LINE__)(basics::Startup_Timeline::is_enabled () ? std::string(NAME) : std::string())
+
+#endif
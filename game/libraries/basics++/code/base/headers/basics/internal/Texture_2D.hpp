@@ -57,6 +57,12 @@
             static std::shared_ptr< Texture_2D > create (Id id, Graphics_Context::Accessor & context, Color_Buffer< Rgba8888 > & color_buffer, const Options & options = {});
             static std::shared_ptr< Texture_2D > create (Id id, Graphics_Context::Accessor & context, const std::string & asset_path, const Options & options = {});
 
+            /**
+             * Lee y decodifica la imagen PNG de un asset sin usar el contexto gráfico, por lo que se
+             * puede llamar desde cualquier hilo. El resultado se puede pasar después a create().
+             */
+            static bool decode (const std::string & asset_path, Color_Buffer< Rgba8888 > & color_buffer, Options & options);
+
         protected:
 
             float width;
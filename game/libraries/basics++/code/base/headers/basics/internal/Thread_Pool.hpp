@@ -0,0 +1,86 @@
+/*
+ * THREAD POOL
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_THREAD_POOL_HEADER
+#define BASICS_THREAD_POOL_HEADER
+
+    #include <atomic>
+    #include <condition_variable>
+    #include <functional>
+    #include <mutex>
+    #include <thread>
+    #include <vector>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Conjunto de hilos de trabajo que permanecen dormidos hasta que se les encarga un trabajo.
+         * El hilo que encarga el trabajo también participa en él y espera a que termine.
+         */
+        class Thread_Pool : Non_Copyable
+        {
+        public:
+
+            typedef std::function< void (unsigned index) > Task;
+
+        private:
+
+            std::vector< std::thread > workers;
+
+            std::mutex                 mutex;
+            std::condition_variable    work_available;
+            std::condition_variable    work_done;
+
+            const Task               * task;            ///< Trabajo en curso (nullptr si no hay ninguno).
+            unsigned                   task_count;      ///< Número de índices del trabajo en curso.
+            std::atomic< unsigned >    next_index;      ///< Siguiente índice por procesar.
+            unsigned                   busy_workers;    ///< Hilos de trabajo que aún no han terminado.
+            unsigned                   generation;      ///< Se incrementa con cada nuevo trabajo.
+            bool                       exit;
+
+        public:
+
+            /**
+             * Crea el pool de hilos.
+             * @param worker_count Número de hilos de trabajo adicionales. Si es 0 se usa uno menos
+             *     que el número de núcleos disponibles.
+             */
+            Thread_Pool(unsigned worker_count = 0);
+
+           ~Thread_Pool();
+
+        public:
+
+            /**
+             * Retorna el número de hilos que participan en cada trabajo (incluido el que lo encarga).
+             */
+            unsigned get_concurrency () const
+            {
+                return unsigned(workers.size ()) + 1;
+            }
+
+            /**
+             * Ejecuta task(index) para cada index en [0, count) repartiendo los índices entre todos
+             * los hilos y no retorna hasta que se han procesado todos.
+             */
+            void parallel_for (unsigned count, const Task & task);
+
+        private:
+
+            void worker_function ();
+            void run_pending_indices ();
+
+        };
+
+    }
+
+#endif
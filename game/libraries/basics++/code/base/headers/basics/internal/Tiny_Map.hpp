@@ -19,53 +19,78 @@
     namespace basics
     {
 
+        /**
+         * Mapa de capacidad fija que guarda sus elementos dentro del propio objeto, por lo que nunca
+         * reserva memoria dinámica. Está pensado para unos pocos elementos: las claves se guardan
+         * juntas en un array que se recorre linealmente hasta encontrar la buscada (con pocas claves
+         * contiguas en memoria es más rápido que un árbol o una tabla hash) y los valores en otro.
+         * No conserva ningún orden entre las claves.
+         */
         template< typename KEY, typename VALUE, size_t CAPACITY >
         class Tiny_Map
         {
+        public:
+
             typedef KEY   Key;
             typedef VALUE Value;
 
-            static constexpr size_t capacity = CAPACITY;
+            static constexpr size_t max_size = CAPACITY;
 
-            struct Item
-            {
-                Key   key;
-                Value value,
-            };
+        private:
 
-            template< class ITEM >
+            template< class MAP, class VALUE_TYPE >
             class Iterator_Template
             {
 
-                ITEM * item;
+                MAP    * map;
+                size_t   index;
 
             public:
 
-                Iterator()            : item(nullptr) { }
-                Iterator(Item * item) : item(item   ) { }
+                Iterator_Template()                         : map(nullptr), index(0    ) { }
+                Iterator_Template(MAP * map, size_t index)  : map(map    ), index(index) { }
+
+                const Key  & key   () const { return map->keys  [index]; }
+                VALUE_TYPE & value () const { return map->values[index]; }
 
-                      Value & operator  * ()       { return  item->value; }
-                const Value & operator  * () const { return  item->value; }
+                VALUE_TYPE & operator  * () const { return  map->values[index]; }
+                VALUE_TYPE * operator -> () const { return &map->values[index]; }
 
-                      Value * operator -> ()       { return &item->value; }
-                const Value * operator -> () const { return &item->value; }
+                Iterator_Template & operator ++ ()
+                {
+                    return ++index, *this;
+                }
+
+                bool operator == (const Iterator_Template & other) const
+                {
+                    return map == other.map && index == other.index;
+                }
 
-                operator bool () const
+                bool operator != (const Iterator_Template & other) const
                 {
-                    return item != nullptr;
+                    return !(*this == other);
                 }
+
             };
 
         public:
 
-            typedef Iterator_Template<       Item >       Iterator;
-            typedef Iterator_Template< const Item > Const_Iterator;
+            typedef Iterator_Template<       Tiny_Map,       Value >       Iterator;
+            typedef Iterator_Template< const Tiny_Map, const Value > Const_Iterator;
 
         private:
 
-            Item   items[capacity];
+            Key    keys  [CAPACITY];
+            Value  values[CAPACITY];
+            Value  overflow;                            ///< Lo que retorna [] con el mapa lleno.
             size_t count;
 
+        public:
+
+            Tiny_Map() : count(0)
+            {
+            }
+
         public:
 
             size_t size () const
@@ -75,53 +100,123 @@
 
             size_t capacity () const
             {
-                return capacity;
+                return max_size;
             }
 
-        public:
+            bool empty () const
+            {
+                return count == 0;
+            }
 
-            Iterator begin ()
+            bool full () const
             {
-                return Iterator(items[0]);
+                return count == max_size;
             }
 
-            Const_Iterator cbegin () const
+            void clear ()
             {
-                return Const_Iterator(items[0]);
+                // Los valores se restablecen para que no retengan recursos:
+
+                for (size_t index = 0; index < count; ++index) values[index] = Value();
+
+                count = 0;
             }
 
-            Iterator end ()
+        public:
+
+            Iterator       begin  ()       { return       Iterator(this, 0    ); }
+            Const_Iterator begin  () const { return Const_Iterator(this, 0    ); }
+            Const_Iterator cbegin () const { return Const_Iterator(this, 0    ); }
+            Iterator       end    ()       { return       Iterator(this, count); }
+            Const_Iterator end    () const { return Const_Iterator(this, count); }
+            Const_Iterator cend   () const { return Const_Iterator(this, count); }
+
+        public:
+
+            Iterator find (const Key & key)
             {
-                return Iterator(items[count]);
+                return Iterator(this, index_of (key));
             }
 
-            Const_Iterator cend () const
+            Const_Iterator find (const Key & key) const
             {
-                return Const_Iterator(items[count]);
+                return Const_Iterator(this, index_of (key));
             }
 
-        public:
+            bool contains (const Key & key) const
+            {
+                return index_of (key) < count;
+            }
 
+            /**
+             * Retorna el valor asociado a la clave. Si la clave no existe, se añade con un valor
+             * por defecto. No se deben añadir más claves que la capacidad del mapa: en ese caso
+             * falla la aserción y, si las aserciones están desactivadas, la clave no se añade y se
+             * retorna un valor por defecto aparte, de modo que lo que se le asigne se descarta sin
+             * modificar ningún otro elemento (se puede comprobar antes con full()).
+             */
             Value & operator [] (const Key & key)
             {
-                for (size_t  index = 0; index < count; ++index)
+                size_t index = index_of (key);
+
+                if (index == count)
                 {
-                    if (item[index].key == key) return item[index].value;
-                }
+                    assert(count < max_size);
+
+                    if (count == max_size)
+                    {
+                        overflow = Value();
 
-                assert(count < capacity);
+                        return overflow;
+                    }
+
+                    keys  [index] = key;
+                    values[index] = Value();
+
+                    count++;
+                }
 
-                return item[count].key = key, item[count++];
+                return values[index];
             }
 
-            const Value & operator [] (const Key & key) const
+            /**
+             * Elimina la clave y su valor. El último elemento ocupa su lugar.
+             * @return El número de elementos eliminados (0 o 1).
+             */
+            size_t erase (const Key & key)
             {
-                for (auto & item : items)
+                size_t index = index_of (key);
+
+                if (index < count)
                 {
-                    if (item.key == key) return item.value;
+                    size_t last = --count;
+
+                    if (index != last)
+                    {
+                        keys  [index] = keys  [last];
+                        values[index] = values[last];
+                    }
+
+                    values[last] = Value();
+
+                    return 1;
                 }
 
-                return *reinterpret_cast< Value * >(nullptr);
+                return 0;
+            }
+
+        private:
+
+            /**
+             * Retorna la posición de la clave o count si no existe.
+             */
+            size_t index_of (const Key & key) const
+            {
+                size_t index = 0;
+
+                while (index < count && !(keys[index] == key)) ++index;
+
+                return index;
             }
 
         };
@@ -0,0 +1,122 @@
+/*
+ * TRIPLE BUFFER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_TRIPLE_BUFFER_HEADER
+#define BASICS_TRIPLE_BUFFER_HEADER
+
+    #include <atomic>
+    #include <basics/Non_Copyable>
+
+    namespace basics
+    {
+
+        /**
+         * Buzón sin bloqueos entre un único hilo productor y un único hilo consumidor.
+         *
+         * El productor rellena el búfer trasero y lo publica. El consumidor adquiere siempre el
+         * último búfer publicado y lo usa mientras el productor rellena otro, de modo que ninguno
+         * de los dos espera al otro. Los búferes publicados que el consumidor no llega a adquirir
+         * se reutilizan sin haberse consumido.
+         */
+        template< typename TYPE >
+        class Triple_Buffer : Non_Copyable
+        {
+        private:
+
+            // El índice del búfer intermedio y el bit que indica que contiene una publicación que
+            // el consumidor todavía no ha adquirido se intercambian juntos:
+
+            static constexpr unsigned fresh_bit  = 4;
+            static constexpr unsigned index_mask = 3;
+
+        private:
+
+            TYPE                    buffers[3];
+
+            unsigned                back;               ///< Solo lo usa el productor.
+            unsigned                front;              ///< Solo lo usa el consumidor.
+            std::atomic< unsigned > middle;
+
+        public:
+
+            Triple_Buffer()
+            {
+                reset ();
+            }
+
+        public:
+
+            /**
+             * Descarta lo publicado. Solo se puede llamar cuando ningún otro hilo usa el buzón.
+             */
+            void reset ()
+            {
+                back   = 0;
+                middle = 1;
+                front  = 2;
+            }
+
+        public:
+
+            /**
+             * Retorna el búfer que puede rellenar el productor.
+             */
+            TYPE & get_back ()
+            {
+                return buffers[back];
+            }
+
+            /**
+             * Publica el búfer trasero. El productor recibe a cambio otro búfer trasero.
+             */
+            void publish ()
+            {
+                back = middle.exchange (back | fresh_bit, std::memory_order_acq_rel) & index_mask;
+            }
+
+        public:
+
+            /**
+             * Pasa a ser búfer delantero la última publicación, si la hay.
+             * @return true si había una publicación que no se había adquirido antes.
+             */
+            bool acquire ()
+            {
+                if (middle.load (std::memory_order_relaxed) & fresh_bit)
+                {
+                    front = middle.exchange (front, std::memory_order_acq_rel) & index_mask;
+
+                    return true;
+                }
+
+                return false;
+            }
+
+            /**
+             * Indica si hay una publicación que el consumidor todavía no ha adquirido.
+             */
+            bool has_fresh () const
+            {
+                return (middle.load (std::memory_order_acquire) & fresh_bit) != 0;
+            }
+
+            /**
+             * Retorna el búfer que está usando el consumidor.
+             */
+            const TYPE & get_front () const
+            {
+                return buffers[front];
+            }
+
+        };
+
+    }
+
+#endif
@@ -111,6 +111,12 @@
                 return value.type_info ().id == TYPE::id ? static_cast< TYPE * >(&value) : nullptr;
             }
 
+            template< typename TYPE >
+            const TYPE * as () const
+            {
+                return value.type_info ().id == TYPE::id ? static_cast< const TYPE * >(&value) : nullptr;
+            }
+
             // AL CONTRARIO QUE EL MÉTODO AS(), EL MÉTODO TO() REALIZA CONVERSIÓN ENTRE TIPOS.
             // UNA PLANTILLA INDEX_OF<TYPE> DEVOLVERÍA EL ÍNDICE EN LA TABLA DE CONVERSIÓN DE UN TIPO
             // CUALQUIERA EN TIEMPO DE COMPILACIÓN. SI NO EXISTE EL ÍNDICE O SI LA ENTRADA EN DICHO
@@ -15,6 +15,7 @@
 
     #include <atomic>
     #include <memory>
+    #include <utility>
     #include <basics/Size>
     #include <basics/Event_Queue>
     #include <basics/Graphics_Context>
@@ -240,7 +241,7 @@
 
             void push (Event && event)
             {
-                event_queue.push (event);
+                event_queue.push (std::move (event));
             }
 
             bool poll (Event & event)
@@ -253,6 +254,14 @@
                 return event_queue.peek (event);
             }
 
+            /**
+             * Establece una señal que se activa cada vez que llega un evento nuevo.
+             */
+            void set_event_signal (Event_Signal * signal)
+            {
+                event_queue.set_signal (signal);
+            }
+
         };
 
         constexpr Id default_window_id = FNV(default-window);
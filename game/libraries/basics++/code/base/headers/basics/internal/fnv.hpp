@@ -125,6 +125,23 @@
             return hash;
         }
 
+        /**
+         * Calculates the FNV-1a hash of a block of bytes at run time. A previous hash can be given
+         * as starting value to hash several blocks as if they were contiguous.
+         */
+        inline uint32_t fnv32 (const void * data, size_t size, uint32_t hash = internal::fnv_basis_32)
+        {
+            const uint8_t * bytes = static_cast< const uint8_t * >(data);
+
+            for (size_t index = 0; index < size; ++index)
+            {
+                hash ^= bytes[index];
+                hash *= internal::fnv_prime_32;
+            }
+
+            return hash;
+        }
+
     }
 
     constexpr unsigned operator "" _fnv (const char * c)
@@ -0,0 +1,113 @@
+/*
+ * ALLOCATION TRACKER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <basics/Allocation_Tracker>
+#include <basics/assert>
+#include <basics/Log>
+
+namespace basics
+{
+
+    std::atomic< bool     > Allocation_Tracker::enabled   (false);
+    std::atomic< unsigned > Allocation_Tracker::violations(0);
+
+    thread_local Allocation_Tracker::Counters Allocation_Tracker::thread_counters = { 0, 0, 0 };
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Allocation_Tracker::report_violation (const char * scope_name, uint64_t allocations, uint64_t bytes)
+    {
+        ++violations;
+
+        // El mensaje se escribe sin reservar memoria para no alterar lo que se está midiendo:
+
+        char message[160];
+
+        std::snprintf
+        (
+            message, sizeof(message), "ERROR: %s made %llu allocations (%llu bytes) in a scope that must not allocate.",
+            scope_name, (unsigned long long)allocations, (unsigned long long)bytes
+        );
+
+        log.e (message);
+
+        assert(false);
+    }
+
+}
+
+// -------------------------------------------------------------------------------------------------
+// Sustitución de los operadores new y delete globales:
+
+namespace
+{
+
+    void * allocate (std::size_t size)
+    {
+        if (basics::Allocation_Tracker::is_enabled ()) basics::Allocation_Tracker::count_allocation (size);
+
+        if (size == 0) size = 1;
+
+        for (;;)
+        {
+            void * pointer = std::malloc (size);
+
+            if (pointer) return pointer;
+
+            std::new_handler handler = std::set_new_handler (nullptr);
+
+            std::set_new_handler (handler);
+
+            if (!handler) return nullptr;
+
+            handler ();
+        }
+    }
+
+    void * allocate_or_fail (std::size_t size)
+    {
+        void * pointer = allocate (size);
+
+        if (!pointer)
+        {
+            #if defined(BASICS_EXCEPTIONS_ENABLED)
+                throw std::bad_alloc();
+            #else
+                std::abort ();
+            #endif
+        }
+
+        return pointer;
+    }
+
+    void deallocate (void * pointer)
+    {
+        if (pointer)
+        {
+            if (basics::Allocation_Tracker::is_enabled ()) basics::Allocation_Tracker::count_deallocation ();
+
+            std::free (pointer);
+        }
+    }
+
+}
+
+void * operator new   (std::size_t size)                        { return allocate_or_fail (size); }
+void * operator new[] (std::size_t size)                        { return allocate_or_fail (size); }
+void * operator new   (std::size_t size, const std::nothrow_t & ) noexcept { return allocate (size); }
+void * operator new[] (std::size_t size, const std::nothrow_t & ) noexcept { return allocate (size); }
+
+void   operator delete   (void * pointer) noexcept                          { deallocate (pointer); }
+void   operator delete[] (void * pointer) noexcept                          { deallocate (pointer); }
+void   operator delete   (void * pointer, const std::nothrow_t & ) noexcept { deallocate (pointer); }
+void   operator delete[] (void * pointer, const std::nothrow_t & ) noexcept { deallocate (pointer); }
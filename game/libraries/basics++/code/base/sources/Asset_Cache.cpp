@@ -0,0 +1,336 @@
+/*
+ * ASSET CACHE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <basics/Asset_Cache>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        // Todas las texturas usan 4 bytes por pixel (Rgba8888):
+
+        size_t get_size (const std::shared_ptr< Texture_2D > & texture)
+        {
+            return size_t(texture->get_width ()) * size_t(texture->get_height ()) * 4;
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    constexpr size_t Asset_Cache::default_budget;
+
+    // ---------------------------------------------------------------------------------------------
+
+    Asset_Cache::Asset_Cache(size_t budget)
+    :
+        budget   (budget),
+        memory   (0),
+        hits     (0),
+        misses   (0),
+        evictions(0)
+    {
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    std::string Asset_Cache::normalize_path (const std::string & path)
+    {
+        std::vector< std::string > segments;
+        std::string                segment;
+        bool                       absolute = !path.empty () && (path[0] == '/' || path[0] == '\\');
+
+        for (size_t index = 0; index <= path.size (); ++index)
+        {
+            char c = index < path.size () ? path[index] : '/';
+
+            if (c != '/' && c != '\\')
+            {
+                segment += c;
+                continue;
+            }
+
+            if (segment == "..")
+            {
+                // Solo se conservan los ".." que suben por encima del inicio de una ruta relativa:
+
+                if (!segments.empty () && segments.back () != "..") segments.pop_back ();
+                else
+                if (!absolute) segments.push_back (segment);
+            }
+            else
+            if (!segment.empty () && segment != ".")
+            {
+                segments.push_back (segment);
+            }
+
+            segment.clear ();
+        }
+
+        std::string normalized = absolute ? "/" : "";
+
+        for (size_t index = 0; index < segments.size (); ++index)
+        {
+            if (index > 0) normalized += '/';
+
+            normalized += segments[index];
+        }
+
+        return normalized;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    std::shared_ptr< Texture_2D > Asset_Cache::add (const std::string & path, const std::shared_ptr< Texture_2D > & texture, Graphics_Context::Accessor & context)
+    {
+        if (!texture) return texture;
+
+        // La caché tiene el asset y la lista de texturas, y el contexto otra referencia:
+
+        Entry entry { normalize_path (path), TEXTURE, texture, { texture }, 3, get_size (texture) };
+
+        return std::static_pointer_cast< Texture_2D > (insert (std::move (entry), context));
+    }
+
+    std::shared_ptr< Atlas > Asset_Cache::add (const std::string & path, const std::shared_ptr< Atlas > & atlas, Graphics_Context::Accessor & context)
+    {
+        if (!atlas) return atlas;
+
+        Entry entry { normalize_path (path), ATLAS, atlas, { }, 1, 0 };
+
+        if (atlas->get_texture ())
+        {
+            entry.textures.push_back (atlas->get_texture ());
+
+            entry.size = get_size (atlas->get_texture ());
+        }
+
+        return std::static_pointer_cast< Atlas > (insert (std::move (entry), context));
+    }
+
+    std::shared_ptr< Raster_Font > Asset_Cache::add (const std::string & path, const std::shared_ptr< Raster_Font > & font, Graphics_Context::Accessor & context)
+    {
+        if (!font) return font;
+
+        Entry entry { normalize_path (path), FONT, font, { }, 1, 0 };
+
+        for (unsigned page = 0; page < font->get_page_count (); ++page)
+        {
+            const Texture_Handle & texture = font->get_texture (page);
+
+            if (texture)
+            {
+                entry.textures.push_back (texture);
+
+                entry.size += get_size (texture);
+            }
+        }
+
+        return std::static_pointer_cast< Raster_Font > (insert (std::move (entry), context));
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    std::shared_ptr< Texture_2D > Asset_Cache::load_texture (const std::string & path, Graphics_Context::Accessor & context)
+    {
+        std::shared_ptr< Texture_2D > texture = find_texture (path);
+
+        if (!texture)
+        {
+            texture = Texture_2D::create (0, context, path);
+
+            if (texture && context->add (texture))
+            {
+                texture = add (path, texture, context);
+            }
+            else
+                texture.reset ();
+        }
+
+        return texture;
+    }
+
+    std::shared_ptr< Atlas > Asset_Cache::load_atlas (const std::string & path, Graphics_Context::Accessor & context)
+    {
+        std::shared_ptr< Atlas > atlas = find_atlas (path);
+
+        if (!atlas)
+        {
+            atlas.reset (new Atlas(path, context));
+
+            if (atlas->good ()) atlas = add (path, atlas, context); else atlas.reset ();
+        }
+
+        return atlas;
+    }
+
+    std::shared_ptr< Raster_Font > Asset_Cache::load_font (const std::string & path, Graphics_Context::Accessor & context)
+    {
+        std::shared_ptr< Raster_Font > font = find_font (path);
+
+        if (!font)
+        {
+            font.reset (new Raster_Font(path, context));
+
+            if (font->good ()) font = add (path, font, context); else font.reset ();
+        }
+
+        return font;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Cache::trim (Graphics_Context::Accessor & context)
+    {
+        std::lock_guard< std::mutex > lock(mutex);
+
+        evict (context);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Cache::clear (Graphics_Context::Accessor & context)
+    {
+        Texture_List textures;
+
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            for (Entry & entry : entries)
+            {
+                textures.insert (textures.end (), entry.textures.begin (), entry.textures.end ());
+            }
+
+            entries  .clear ();
+            entry_map.clear ();
+
+            memory = 0;
+        }
+
+        release (textures, context);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Asset_Cache::Statistics Asset_Cache::get_statistics ()
+    {
+        std::lock_guard< std::mutex > lock(mutex);
+
+        return { hits, misses, evictions, unsigned(entries.size ()), memory, budget };
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    std::shared_ptr< void > Asset_Cache::find (const std::string & path, Kind kind)
+    {
+        std::string key = normalize_path (path);
+
+        std::lock_guard< std::mutex > lock(mutex);
+
+        Entry_Map::iterator item = entry_map.find (key);
+
+        if (item != entry_map.end () && item->second->kind == kind)
+        {
+            // Se pasa al principio de la lista (los iteradores de std::list siguen siendo válidos):
+
+            entries.splice (entries.begin (), entries, item->second);
+
+            hits++;
+
+            return item->second->asset;
+        }
+
+        misses++;
+
+        return std::shared_ptr< void >();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    std::shared_ptr< void > Asset_Cache::insert (Entry && entry, Graphics_Context::Accessor & context)
+    {
+        std::lock_guard< std::mutex > lock(mutex);
+
+        Entry_Map::iterator item = entry_map.find (entry.path);
+
+        if (item != entry_map.end ())
+        {
+            // Si el mismo asset se ha cargado dos veces a la vez, se conserva el primero y las
+            // texturas del segundo se sacan del contexto. Un asset de otro tipo con la misma ruta
+            // no se guarda:
+
+            if (item->second->kind != entry.kind) return entry.asset;
+
+            release (entry.textures, context);
+
+            entries.splice (entries.begin (), entries, item->second);
+
+            return item->second->asset;
+        }
+
+        memory += entry.size;
+
+        entries.push_front (std::move (entry));
+
+        entry_map[entries.front ().path] = entries.begin ();
+
+        std::shared_ptr< void > asset = entries.front ().asset;
+
+        evict (context);
+
+        return asset;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Cache::evict (Graphics_Context::Accessor & context)
+    {
+        Entry_List::iterator entry = entries.end ();
+
+        while (memory > budget && entry != entries.begin ())
+        {
+            --entry;
+
+            // Los assets que alguien está usando no se descartan:
+
+            if (entry->asset.use_count () > entry->own_references) continue;
+
+            Texture_List textures = std::move (entry->textures);
+
+            memory -= entry->size;
+
+            evictions++;
+
+            entry_map.erase (entry->path);
+
+            entry = entries.erase (entry);
+
+            // Las texturas se destruyen (y se liberan en la GPU) al salir de este bloque:
+
+            release (textures, context);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Cache::release (const Texture_List & textures, Graphics_Context::Accessor & context)
+    {
+        if (context)
+        {
+            for (const Texture_Handle & texture : textures)
+            {
+                context->remove (texture);
+            }
+        }
+    }
+
+}
@@ -0,0 +1,396 @@
+/*
+ * ASSET LOADER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <basics/Asset_Loader>
+#include <basics/Profiler>
+
+namespace basics
+{
+
+    /**
+     * Una petición pasa por decode() en un hilo de trabajo y, si lo supera, por upload() en el hilo
+     * del contexto gráfico. Si no se completa por cualquier otro motivo se llama a fail().
+     */
+    struct Asset_Loader::Request
+    {
+        std::string              path;
+        Asset_Cache            * cache;
+        Color_Buffer< Rgba8888 > color_buffer;
+        Texture_2D::Options      options;
+
+        Request(const std::string & path, Asset_Cache * cache) : path(path), cache(cache)
+        {
+        }
+
+        virtual ~Request() = default;
+
+        virtual bool decode () = 0;
+        virtual void upload (Graphics_Context::Accessor & context) = 0;
+        virtual void fail   () = 0;
+
+        /**
+         * Crea en el contexto la textura con la imagen decodificada y libera la copia de la imagen
+         * que tenía la petición.
+         */
+        std::shared_ptr< Texture_2D > create_texture (Graphics_Context::Accessor & context)
+        {
+            std::shared_ptr< Texture_2D > texture = Texture_2D::create (0, context, color_buffer, options);
+
+            color_buffer = Color_Buffer< Rgba8888 >();
+
+            if (texture && !context->add (texture))
+            {
+                texture.reset ();
+            }
+
+            return texture;
+        }
+
+        /**
+         * Guarda en la caché (si hay) el asset ya subido y completa la petición con él o con el que
+         * ya estaba guardado si se ha cargado dos veces a la vez.
+         */
+        template< typename TYPE >
+        void complete (Result< TYPE > & result, const std::shared_ptr< TYPE > & asset, Graphics_Context::Accessor & context)
+        {
+            complete (result, cache && asset ? cache->add (path, asset, context) : asset);
+        }
+
+        template< typename TYPE >
+        static void complete (Result< TYPE > & result, const std::shared_ptr< TYPE > & asset)
+        {
+            result.asset = asset;
+            result.ready.store (true, std::memory_order_release);
+        }
+    };
+
+    // ---------------------------------------------------------------------------------------------
+
+    struct Asset_Loader::Texture_Request : public Asset_Loader::Request
+    {
+        std::shared_ptr< Result< Texture_2D > > result;
+
+        Texture_Request(const std::string & path, Asset_Cache * cache) : Request(path, cache)
+        {
+            result.reset (new Result< Texture_2D >);
+        }
+
+        bool decode () override
+        {
+            return Texture_2D::decode (path, color_buffer, options);
+        }
+
+        void upload (Graphics_Context::Accessor & context) override
+        {
+            complete (*result, create_texture (context), context);
+        }
+
+        void fail () override
+        {
+            complete (*result, std::shared_ptr< Texture_2D >());
+        }
+    };
+
+    // ---------------------------------------------------------------------------------------------
+
+    struct Asset_Loader::Atlas_Request : public Asset_Loader::Request
+    {
+        std::shared_ptr< Result< Atlas > > result;
+        std::shared_ptr< Atlas >           atlas;
+
+        Atlas_Request(const std::string & path, Asset_Cache * cache) : Request(path, cache)
+        {
+            result.reset (new Result< Atlas >);
+        }
+
+        bool decode () override
+        {
+            atlas.reset (new Atlas(path));
+
+            return !atlas->get_texture_path ().empty () && Texture_2D::decode (atlas->get_texture_path (), color_buffer, options);
+        }
+
+        void upload (Graphics_Context::Accessor & context) override
+        {
+            atlas->set_texture (create_texture (context));
+
+            complete (*result, atlas->good () ? atlas : std::shared_ptr< Atlas >(), context);
+        }
+
+        void fail () override
+        {
+            complete (*result, std::shared_ptr< Atlas >());
+        }
+    };
+
+    // ---------------------------------------------------------------------------------------------
+
+    struct Asset_Loader::Font_Request : public Asset_Loader::Request
+    {
+        std::shared_ptr< Result< Raster_Font > >  result;
+        std::shared_ptr< Raster_Font >            font;
+        std::vector< Color_Buffer< Rgba8888 > >   page_buffers;     ///< Una imagen por página.
+        std::vector< Texture_2D::Options >        page_options;
+
+        Font_Request(const std::string & path, Asset_Cache * cache) : Request(path, cache)
+        {
+            result.reset (new Result< Raster_Font >);
+        }
+
+        bool decode () override
+        {
+            font.reset (new Raster_Font(path));
+
+            unsigned page_count = font->get_page_count ();
+
+            page_buffers.resize (page_count);
+            page_options.resize (page_count);
+
+            for (unsigned page = 0; page < page_count; ++page)
+            {
+                if (!Texture_2D::decode (font->get_texture_path (page), page_buffers[page], page_options[page])) return false;
+            }
+
+            return page_count > 0;
+        }
+
+        void upload (Graphics_Context::Accessor & context) override
+        {
+            for (unsigned page = 0; page < page_buffers.size (); ++page)
+            {
+                color_buffer = std::move (page_buffers[page]);
+                options      = page_options[page];
+
+                font->set_texture (create_texture (context), page);
+            }
+
+            page_buffers.clear ();
+
+            complete (*result, font->good () ? font : std::shared_ptr< Raster_Font >(), context);
+        }
+
+        void fail () override
+        {
+            complete (*result, std::shared_ptr< Raster_Font >());
+        }
+    };
+
+    // ---------------------------------------------------------------------------------------------
+
+    Asset_Loader::Asset_Loader(unsigned worker_count)
+    :
+        worker_count (worker_count),
+        cache        (nullptr),
+        pending_count(0),
+        exit         (false)
+    {
+        if (this->worker_count == 0)
+        {
+            unsigned cores = std::thread::hardware_concurrency ();
+
+            this->worker_count = cores > 1 ? cores - 1 : 1;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Asset_Loader::~Asset_Loader()
+    {
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            exit = true;
+        }
+
+        work_available.notify_all ();
+
+        for (auto & worker : workers)
+        {
+            worker.join ();
+        }
+
+        // Las peticiones que no se han completado se dan por fallidas para que ningún handle se
+        // quede esperando:
+
+        for (auto & request : decode_queue) request->fail ();
+        for (auto & request : upload_queue) request->fail ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    template< typename REQUEST, typename TYPE >
+    Asset_Loader::Handle< TYPE > Asset_Loader::load (const std::string & path, const std::shared_ptr< TYPE > & cached)
+    {
+        Handle< TYPE > handle;
+
+        if (cached)
+        {
+            handle.result.reset (new Result< TYPE >);
+
+            Request::complete (*handle.result, cached);
+        }
+        else
+        {
+            std::shared_ptr< REQUEST > request(new REQUEST(path, cache));
+
+            handle.result = request->result;
+
+            enqueue (request);
+        }
+
+        return handle;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Asset_Loader::Texture_Handle Asset_Loader::load_texture (const std::string & path)
+    {
+        return load< Texture_Request > (path, cache ? cache->find_texture (path) : nullptr);
+    }
+
+    Asset_Loader::Atlas_Handle Asset_Loader::load_atlas (const std::string & path)
+    {
+        return load< Atlas_Request > (path, cache ? cache->find_atlas (path) : nullptr);
+    }
+
+    Asset_Loader::Font_Handle Asset_Loader::load_font (const std::string & path)
+    {
+        return load< Font_Request > (path, cache ? cache->find_font (path) : nullptr);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    unsigned Asset_Loader::upload (Graphics_Context::Accessor & context, float budget)
+    {
+        BASICS_PROFILE_ZONE ("Asset_Loader::upload");
+
+        uint64_t start     = Profiler::now ();
+        uint64_t limit     = uint64_t(double(budget) * 1e9);
+        unsigned completed = 0;
+
+        while (completed == 0 || Profiler::now () - start < limit)
+        {
+            Request_Handle request;
+
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                if (upload_queue.empty ()) break;
+
+                request = upload_queue.front ();
+
+                upload_queue.pop_front ();
+            }
+
+            request->upload (context);
+
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                pending_count--;
+            }
+
+            work_done.notify_all ();
+
+            completed++;
+        }
+
+        return completed;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Loader::finish (Graphics_Context::Accessor & context)
+    {
+        std::unique_lock< std::mutex > lock(mutex);
+
+        while (pending_count > 0)
+        {
+            work_done.wait (lock, [this] () { return pending_count == 0 || !upload_queue.empty (); });
+
+            if (!upload_queue.empty ())
+            {
+                lock.unlock ();
+
+                upload (context, 0.f);
+
+                lock.lock ();
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Loader::enqueue (const Request_Handle & request)
+    {
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            // Los hilos de trabajo se ponen en marcha con la primera petición:
+
+            if (workers.empty ())
+            {
+                for (unsigned index = 0; index < worker_count; ++index)
+                {
+                    workers.emplace_back (&Asset_Loader::worker_function, this);
+                }
+            }
+
+            decode_queue.push_back (request);
+
+            pending_count++;
+        }
+
+        work_available.notify_one ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Asset_Loader::worker_function ()
+    {
+        for (;;)
+        {
+            Request_Handle request;
+
+            {
+                std::unique_lock< std::mutex > lock(mutex);
+
+                work_available.wait (lock, [this] () { return exit || !decode_queue.empty (); });
+
+                if (exit) return;
+
+                request = decode_queue.front ();
+
+                decode_queue.pop_front ();
+            }
+
+            bool decoded;
+
+            {
+                BASICS_PROFILE_ZONE ("Asset_Loader::decode");
+
+                decoded = request->decode ();
+            }
+
+            // Si no se ha podido leer o decodificar, la petición termina aquí:
+
+            if (!decoded) request->fail ();
+
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                if (decoded) upload_queue.push_back (request); else pending_count--;
+            }
+
+            work_done.notify_all ();
+        }
+    }
+
+}
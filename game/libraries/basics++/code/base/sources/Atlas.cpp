@@ -13,9 +13,12 @@
 #include <basics/assert>
 #include <basics/Asset>
 #include <basics/Atlas>
+#include <algorithm>
 #include <cstring>
 
 #include <basics/Log>
+#include <basics/Profiler>
+#include <basics/Startup_Timeline>
 
 using namespace std;
 using namespace rapidxml;
@@ -23,17 +26,118 @@ using namespace rapidxml;
 namespace basics
 {
 
+    namespace
+    {
+
+        // Formato binario de los atlas. Los valores se guardan en little endian, que es el orden de
+        // bytes de todas las plataformas soportadas, por lo que se usan tal cual tras leerlos. Tras
+        // la cabecera va el nombre del archivo de la textura (relativo a la carpeta del atlas y
+        // completado con ceros hasta un múltiplo de 4 bytes) y después los slices ordenados por id:
+
+        const uint32_t binary_magic   = 0x4C544142;         // "BATL"
+        const uint16_t binary_version = 1;
+
+        struct Binary_Header
+        {
+            uint32_t magic;
+            uint16_t version;
+            uint16_t name_length;
+            uint32_t slice_count;
+        };
+
+        struct Binary_Slice
+        {
+            uint32_t id;
+            float    x;
+            float    y;
+            float    width;
+            float    height;
+        };
+
+        size_t get_slices_offset (const Binary_Header & header)
+        {
+            return sizeof(Binary_Header) + ((size_t(header.name_length) + 3) & ~size_t(3));
+        }
+
+        /**
+         * Retorna la carpeta de una ruta incluyendo el separador final (o una cadena vacía si la
+         * ruta no tiene carpeta).
+         */
+        string get_folder (const string & path)
+        {
+            size_t slash     = path.find_last_of ('/' );
+            size_t backslash = path.find_last_of ('\\');
+
+            if (slash != string::npos && backslash != string::npos)
+            {
+                return path.substr (0, std::max (slash, backslash + 1));
+            }
+            else
+            if (slash != string::npos)
+            {
+                return path.substr (0, slash + 1);
+            }
+            else
+            if (backslash != string::npos)
+            {
+                return path.substr (0, backslash + 1);
+            }
+
+            return string();
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    constexpr Atlas::Slice_Handle Atlas::no_slice;
+
+    // ---------------------------------------------------------------------------------------------
+
     Atlas::Atlas(const string & path, Graphics_Context::Accessor & context)
+    :
+        Atlas(path)
+    {
+        BASICS_PROFILE_ZONE ("Atlas::load");
+        BASICS_STARTUP_SPAN ("load atlas " + path);
+
+        if (!texture_path.empty ())
+        {
+            // Se intenta cargar la textura:
+
+            Texture_Handle new_texture = Texture_2D::create (0, context, texture_path);
+
+            assert(new_texture);
+
+            if (new_texture)
+            {
+                context->add (new_texture);
+
+                set_texture (new_texture);
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Atlas::Atlas(const string & path)
     {
+        BASICS_PROFILE_ZONE ("Atlas::read");
+
         shared_ptr< Asset > slices_file = Asset::open (path);
 
-        if (slices_file->good ())
+        if (slices_file && slices_file->good ())
         {
             Buffer slices_data;
 
             if (slices_file->read_all (slices_data))
             {
-                parse (slices_data, path, context);
+                // Si no es un atlas compilado, se espera que sea el XML:
+
+                if (!load (slices_data, path))
+                {
+                    parse (slices_data, path);
+                }
             }
         }
     }
@@ -48,29 +152,204 @@ namespace basics
 
     // ---------------------------------------------------------------------------------------------
 
-    Atlas::Slice * Atlas::add_slice (Id id, const Point2f & position, const Size2f & size)
+    void Atlas::set_texture (const Texture_Handle & new_texture)
     {
-        if (slices.count (id) == 0)
+        texture = new_texture;
+
+        for (Slice & slice : slices)
         {
-            return &
+            set_normalized_coordinates (slice);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Atlas::set_normalized_coordinates (Slice & slice) const
+    {
+        float horizontal_ratio = texture ? 1.f / texture->get_width  () : 0.f;
+        float   vertical_ratio = texture ? 1.f / texture->get_height () : 0.f;
+
+        slice.normalized_left   = slice.left   * horizontal_ratio;
+        slice.normalized_right  = slice.right  * horizontal_ratio;
+        slice.normalized_bottom = slice.bottom *   vertical_ratio;
+        slice.normalized_top    = slice.top    *   vertical_ratio;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Atlas::Slice_Handle Atlas::get_slice_handle (Id id) const
+    {
+        Slice_Index::const_iterator entry = std::lower_bound
+        (
+            index.begin (),
+            index.end   (),
+            id,
+            [] (const Index_Entry & entry, Id id) { return entry.id < id; }
+        );
+
+        return entry != index.end () && entry->id == id ? entry->handle : no_slice;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Atlas::matches (const Slice_Definition * definitions, size_t count) const
+    {
+        if (count != slices.size ()) return false;
+
+        for (Slice_Handle handle = 0; handle < count; ++handle)
+        {
+            const Slice_Definition & definition = definitions[handle];
+            const Slice            & slice      = slices[handle];
+
+            if
             (
-                slices[id] =
-                {
-                    this,
-                    position.coordinates.x (), position.coordinates.x () + size.width,
-                    position.coordinates.y (), position.coordinates.y () + size.height,
-                    size.width,                size.height
-                }
-            );
-        };
+                get_slice_handle (definition.id) != handle ||
+                slice.left  != definition.x     || slice.bottom != definition.y ||
+                slice.width != definition.width || slice.height != definition.height
+            )
+            {
+                return false;
+            }
+        }
 
-        return nullptr;
+        return true;
     }
 
     // ---------------------------------------------------------------------------------------------
 
-    void Atlas::parse (Buffer & slices_data, const std::string & path, Graphics_Context::Accessor & context)
+    Atlas::Slice * Atlas::add_slice (Id id, const Point2f & position, const Size2f & size)
+    {
+        Slice_Index::iterator entry = std::lower_bound
+        (
+            index.begin (),
+            index.end   (),
+            id,
+            [] (const Index_Entry & entry, Id id) { return entry.id < id; }
+        );
+
+        if (entry != index.end () && entry->id == id)
+        {
+            return nullptr;
+        }
+
+        Slice_Handle handle = Slice_Handle(slices.size ());
+
+        index.insert (entry, { id, handle });
+
+        slices.push_back
+        ({
+            this,
+            position.coordinates.x (), position.coordinates.x () + size.width,
+            position.coordinates.y (), position.coordinates.y () + size.height,
+            size.width,                size.height,
+            0.f, 0.f, 0.f, 0.f                                      // Se calculan a continuación
+        });
+
+        set_normalized_coordinates (slices.back ());
+
+        return &slices.back ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Atlas::write_binary (Buffer & data) const
     {
+        string texture_name = texture_path.substr (get_folder (texture_path).size ());
+
+        if (texture_name.empty () || texture_name.size () > 65535 || slices.empty ()) return false;
+
+        Binary_Header header = { binary_magic, binary_version, uint16_t(texture_name.size ()), uint32_t(slices.size ()) };
+
+        data.assign (get_slices_offset (header) + slices.size () * sizeof(Binary_Slice), 0);
+
+        std::memcpy (data.data (), &header, sizeof(header));
+        std::memcpy (data.data () + sizeof(header), texture_name.data (), texture_name.size ());
+
+        // Se recorren los slices en el orden del índice, que ya está ordenado por id:
+
+        byte * record = data.data () + get_slices_offset (header);
+
+        for (const Index_Entry & entry : index)
+        {
+            const Slice & slice  = slices[entry.handle];
+            Binary_Slice  binary = { entry.id, slice.left, slice.bottom, slice.width, slice.height };
+
+            std::memcpy (record, &binary, sizeof(binary));
+
+            record += sizeof(binary);
+        }
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Atlas::load (const Buffer & slices_data, const std::string & path)
+    {
+        BASICS_PROFILE_ZONE ("Atlas::load_binary");
+
+        Binary_Header header;
+
+        if (slices_data.size () < sizeof(header)) return false;
+
+        std::memcpy (&header, slices_data.data (), sizeof(header));
+
+        if (header.magic != binary_magic) return false;
+
+        // A partir de aquí es un atlas compilado, aunque puede no ser válido:
+
+        size_t slices_offset = get_slices_offset (header);
+
+        if (header.version != binary_version || slices_data.size () != slices_offset + size_t(header.slice_count) * sizeof(Binary_Slice))
+        {
+            log.e (string("ERROR: the compiled atlas ") + path + " has an unsupported version or a wrong size.");
+
+            return true;
+        }
+
+        texture_path  = get_folder (path);
+        texture_path.append (reinterpret_cast< const char * >(slices_data.data ()) + sizeof(header), header.name_length);
+
+        const byte * record = slices_data.data () + slices_offset;
+
+        slices.reserve (header.slice_count);
+        index .reserve (header.slice_count);
+
+        for (uint32_t number = 0; number < header.slice_count; ++number, record += sizeof(Binary_Slice))
+        {
+            Binary_Slice binary;
+
+            std::memcpy (&binary, record, sizeof(binary));
+
+            // El formato compilado no admite ids repetidos ni slices vacíos. Si hay alguno el atlas
+            // está dañado y se descarta entero (good() retornará false):
+
+            bool valid_size = binary.width > 0.f && binary.height > 0.f;
+
+            if (!valid_size || !add_slice (binary.id, { binary.x, binary.y }, { binary.width, binary.height }))
+            {
+                log.e
+                (
+                    string("ERROR: the compiled atlas ") + path + " has a " + (valid_size ? "repeated id" : "wrong size")
+                    + " in slice " + std::to_string (number) + "."
+                );
+
+                slices.clear ();
+                index .clear ();
+
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Atlas::parse (Buffer & slices_data, const std::string & path)
+    {
+        BASICS_PROFILE_ZONE ("Atlas::parse");
+
         // Se pone un caracter nulo al final para que el parseador de rapidxml sepa dónde está el
         // final de los datos:
 
@@ -88,13 +367,13 @@ namespace basics
 
         if (img_tag)
         {
-            parse_img (img_tag, path, context);
+            parse_img (img_tag, path);
         }
     }
 
     // ---------------------------------------------------------------------------------------------
 
-    void Atlas::parse_img (rapidxml::xml_node<> * img_tag, const std::string & path, Graphics_Context::Accessor & context)
+    void Atlas::parse_img (rapidxml::xml_node<> * img_tag, const std::string & path)
     {
         // Se busca el atributo "name" del tag "img", el cual indica el nombre del archivo de la textura:
 
@@ -102,57 +381,22 @@ namespace basics
 
         if (name_attribute)
         {
-            // Se determina la ruta de la textura:
-
-            size_t slash     = path.find_last_of ('/' );
-            size_t backslash = path.find_last_of ('\\');
-            string texture_path;
+            // Se determina la ruta de la textura, que se carga aparte:
 
-            if (slash != string::npos && backslash != string::npos)
-            {
-                texture_path = path.substr (0, std::max (slash, backslash + 1));
-            }
-            else
-            if (slash != string::npos)
-            {
-                texture_path = path.substr (0, slash + 1);
-            }
-            else
-            if (backslash != string::npos)
-            {
-                texture_path = path.substr (0, backslash + 1);
-            }
+            texture_path  = get_folder (path);
+            texture_path += name_attribute->value ();
 
-            // Se intenta cargar la textura:
-
-            texture = Texture_2D::create (0, context, texture_path + name_attribute->value ());
+            // Se busca el tag "definitions" (anidado en el tag "img"):
 
-            assert(texture);
+            xml_node<> * definitions_tag = img_tag->first_node ();
 
-            if (texture)
+            if (definitions_tag && definitions_tag->name () == string("definitions"))
             {
-                context->add (texture);
-
-                // Se comprueba que las dimensiones de la textura coinciden con lo que indica el XML:
-
-                //xml_attribute<> * w_attribute = img_tag->first_attribute ("w");
-                //xml_attribute<> * h_attribute = img_tag->first_attribute ("h");
-
-                //assert(!w_attribute || texture->get_width  () == std::atoi (w_attribute->value ()));
-                //assert(!h_attribute || texture->get_height () == std::atoi (h_attribute->value ()));
+                // Se buscan y parsean todos los tags "dir" anidados dentro de "definitions":
 
-                // Se busca el tag "definitions" (anidado en el tag "img"):
-
-                xml_node<> * definitions_tag = img_tag->first_node ();
-
-                if (definitions_tag && definitions_tag->name () == string("definitions"))
+                for (xml_node<> * dir_tag = definitions_tag->first_node ("dir"); dir_tag; dir_tag = dir_tag->next_sibling ("dir"))
                 {
-                    // Se buscan y parsean todos los tags "dir" anidados dentro de "definitions":
-
-                    for (xml_node<> * dir_tag = definitions_tag->first_node ("dir"); dir_tag; dir_tag = dir_tag->next_sibling ("dir"))
-                    {
-                        parse_dir (dir_tag);
-                    }
+                    parse_dir (dir_tag);
                 }
             }
         }
@@ -0,0 +1,260 @@
+/*
+ * DISPLAY LIST
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <basics/Display_List>
+
+namespace basics
+{
+
+    Display_List::Command & Display_List::add (Command::Type type)
+    {
+        commands.emplace_back ();
+
+        Command & command = commands.back ();
+
+        command.type     = type;
+        command.index    = 0;
+        command.handling = 0;
+        command.resource = nullptr;
+
+        return command;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Display_List::reset_state ()
+    {
+        add (Command::RESET_STATE);
+    }
+
+    void Display_List::set_clear_color (float r, float g, float b)
+    {
+        Command & command = add (Command::SET_CLEAR_COLOR);
+
+        command.values[0] = r;
+        command.values[1] = g;
+        command.values[2] = b;
+    }
+
+    void Display_List::set_color (float r, float g, float b)
+    {
+        Command & command = add (Command::SET_COLOR);
+
+        command.values[0] = r;
+        command.values[1] = g;
+        command.values[2] = b;
+    }
+
+    void Display_List::set_opacity (float opacity)
+    {
+        add (Command::SET_OPACITY).values[0] = opacity;
+    }
+
+    void Display_List::set_blending (Blending blending)
+    {
+        add (Command::SET_BLENDING).index = unsigned(blending);
+    }
+
+    void Display_List::set_layer (unsigned layer)
+    {
+        add (Command::SET_LAYER).index = layer;
+    }
+
+    void Display_List::set_transform (const Transformation2f & transform)
+    {
+        add (Command::SET_TRANSFORM).index = unsigned(transforms.size ());
+
+        transforms.push_back (transform);
+    }
+
+    void Display_List::apply_transform (const Transformation2f & transform)
+    {
+        add (Command::APPLY_TRANSFORM).index = unsigned(transforms.size ());
+
+        transforms.push_back (transform);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Display_List::clear ()
+    {
+        add (Command::CLEAR);
+    }
+
+    void Display_List::draw_point (const Point2f & position)
+    {
+        Command & command = add (Command::DRAW_POINT);
+
+        command.values[0] = position[0];
+        command.values[1] = position[1];
+    }
+
+    void Display_List::draw_segment (const Point2f & a, const Point2f & b)
+    {
+        Command & command = add (Command::DRAW_SEGMENT);
+
+        command.values[0] = a[0];
+        command.values[1] = a[1];
+        command.values[2] = b[0];
+        command.values[3] = b[1];
+    }
+
+    void Display_List::draw_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
+    {
+        Command & command = add (Command::DRAW_TRIANGLE);
+
+        command.values[0] = a[0];
+        command.values[1] = a[1];
+        command.values[2] = b[0];
+        command.values[3] = b[1];
+        command.values[4] = c[0];
+        command.values[5] = c[1];
+    }
+
+    void Display_List::fill_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
+    {
+        Command & command = add (Command::FILL_TRIANGLE);
+
+        command.values[0] = a[0];
+        command.values[1] = a[1];
+        command.values[2] = b[0];
+        command.values[3] = b[1];
+        command.values[4] = c[0];
+        command.values[5] = c[1];
+    }
+
+    void Display_List::draw_rectangle (const Point2f & bottom_left, const Size2f & size)
+    {
+        Command & command = add (Command::DRAW_RECTANGLE);
+
+        command.values[0] = bottom_left[0];
+        command.values[1] = bottom_left[1];
+        command.values[2] = size.width;
+        command.values[3] = size.height;
+    }
+
+    void Display_List::fill_rectangle (const Point2f & bottom_left, const Size2f & size)
+    {
+        Command & command = add (Command::FILL_RECTANGLE);
+
+        command.values[0] = bottom_left[0];
+        command.values[1] = bottom_left[1];
+        command.values[2] = size.width;
+        command.values[3] = size.height;
+    }
+
+    void Display_List::fill_rectangle (const Point2f & where, const Size2f & size, const Texture_2D * texture, int handling)
+    {
+        Command & command = add (Command::FILL_TEXTURED_RECTANGLE);
+
+        command.values[0] = where[0];
+        command.values[1] = where[1];
+        command.values[2] = size.width;
+        command.values[3] = size.height;
+        command.handling  = handling;
+        command.resource  = texture;
+    }
+
+    void Display_List::fill_rectangle (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling)
+    {
+        Command & command = add (Command::FILL_SLICED_RECTANGLE);
+
+        command.values[0] = where[0];
+        command.values[1] = where[1];
+        command.values[2] = size.width;
+        command.values[3] = size.height;
+        command.handling  = handling;
+        command.resource  = slice;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Display_List::replay (Canvas & canvas) const
+    {
+        for (const Command & command : commands)
+        {
+            const float * values = command.values;
+
+            switch (command.type)
+            {
+                case Command::RESET_STATE:      canvas.reset_state     (); break;
+                case Command::SET_CLEAR_COLOR:  canvas.set_clear_color (values[0], values[1], values[2]); break;
+                case Command::SET_COLOR:        canvas.set_color       (values[0], values[1], values[2]); break;
+                case Command::SET_OPACITY:      canvas.set_opacity     (values[0]); break;
+                case Command::SET_BLENDING:     canvas.set_blending    (Blending(command.index)); break;
+                case Command::SET_LAYER:        canvas.set_layer       (command.index); break;
+                case Command::SET_TRANSFORM:    canvas.set_transform   (transforms[command.index]); break;
+                case Command::APPLY_TRANSFORM:  canvas.apply_transform (transforms[command.index]); break;
+                case Command::CLEAR:            canvas.clear           (); break;
+
+                case Command::DRAW_POINT:
+                {
+                    canvas.draw_point ({ values[0], values[1] });
+                    break;
+                }
+
+                case Command::DRAW_SEGMENT:
+                {
+                    canvas.draw_segment ({ values[0], values[1] }, { values[2], values[3] });
+                    break;
+                }
+
+                case Command::DRAW_TRIANGLE:
+                {
+                    canvas.draw_triangle ({ values[0], values[1] }, { values[2], values[3] }, { values[4], values[5] });
+                    break;
+                }
+
+                case Command::FILL_TRIANGLE:
+                {
+                    canvas.fill_triangle ({ values[0], values[1] }, { values[2], values[3] }, { values[4], values[5] });
+                    break;
+                }
+
+                case Command::DRAW_RECTANGLE:
+                {
+                    canvas.draw_rectangle ({ values[0], values[1] }, { values[2], values[3] });
+                    break;
+                }
+
+                case Command::FILL_RECTANGLE:
+                {
+                    canvas.fill_rectangle ({ values[0], values[1] }, { values[2], values[3] });
+                    break;
+                }
+
+                case Command::FILL_TEXTURED_RECTANGLE:
+                {
+                    canvas.fill_rectangle
+                    (
+                        { values[0], values[1] },
+                        { values[2], values[3] },
+                        static_cast< const Texture_2D * >(command.resource),
+                        command.handling
+                    );
+                    break;
+                }
+
+                case Command::FILL_SLICED_RECTANGLE:
+                {
+                    canvas.fill_rectangle
+                    (
+                        { values[0], values[1] },
+                        { values[2], values[3] },
+                        static_cast< const Atlas::Slice * >(command.resource),
+                        command.handling
+                    );
+                    break;
+                }
+            }
+        }
+    }
+
+}
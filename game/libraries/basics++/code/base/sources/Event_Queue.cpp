@@ -0,0 +1,175 @@
+/*
+ * EVENT QUEUE
+ * Copyright © 2017+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <thread>
+#include <basics/Event_Queue>
+
+namespace basics
+{
+
+    Event_Queue::Event_Queue(unsigned capacity, Overflow_Policy policy)
+    :
+        overflow_policy(policy),
+        signal         (nullptr),
+        write_position (0),
+        read_position  (0),
+        high_water_mark(0),
+        discarded_count(0)
+    {
+        size_t size = 2;
+
+        while (size < capacity) size <<= 1;
+
+        slots.reset (new Slot[size]);
+        mask = size - 1;
+
+        // Al principio cada posición está libre para la primera vuelta:
+
+        for (size_t index = 0; index < size; ++index)
+        {
+            slots[index].sequence.store (index, std::memory_order_relaxed);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Event_Queue::push (Event && event)
+    {
+        size_t position = write_position.load (std::memory_order_relaxed);
+        Slot * slot;
+
+        for (;;)
+        {
+            slot = &slots[position & mask];
+
+            size_t    sequence   = slot->sequence.load (std::memory_order_acquire);
+            ptrdiff_t difference = ptrdiff_t(sequence) - ptrdiff_t(position);
+
+            if (difference == 0)
+            {
+                // La posición está libre. Se reserva si ningún otro productor se ha adelantado:
+
+                if (write_position.compare_exchange_weak (position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else
+            if (difference < 0)
+            {
+                // La posición todavía contiene el evento de la vuelta anterior, así que está llena:
+
+                if (overflow_policy == DISCARD)
+                {
+                    discarded_count.fetch_add (1, std::memory_order_relaxed);
+
+                    return false;
+                }
+
+                std::this_thread::yield ();
+
+                position = write_position.load (std::memory_order_relaxed);
+            }
+            else
+            {
+                position = write_position.load (std::memory_order_relaxed);
+            }
+        }
+
+        slot->event = std::move (event);
+        slot->sequence.store (position + 1, std::memory_order_release);
+
+        update_high_water_mark (position + 1);
+
+        if (signal) signal->notify ();
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Event_Queue::poll (Event & event)
+    {
+        size_t position = read_position.load (std::memory_order_relaxed);
+        Slot & slot     = slots[position & mask];
+
+        if (slot.sequence.load (std::memory_order_acquire) != position + 1)
+        {
+            return false;
+        }
+
+        event = std::move (slot.event);
+
+        // Se deja libre la posición para la siguiente vuelta:
+
+        slot.sequence.store  (position + mask + 1, std::memory_order_release);
+        read_position.store  (position + 1,        std::memory_order_relaxed);
+
+        return true;
+    }
+
+    bool Event_Queue::peek (Event & event)
+    {
+        size_t position = read_position.load (std::memory_order_relaxed);
+        Slot & slot     = slots[position & mask];
+
+        if (slot.sequence.load (std::memory_order_acquire) != position + 1)
+        {
+            return false;
+        }
+
+        event = slot.event;
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    unsigned Event_Queue::drain (std::vector< Event > & events)
+    {
+        events.clear ();
+
+        size_t position = read_position.load (std::memory_order_relaxed);
+
+        for (;; ++position)
+        {
+            Slot & slot = slots[position & mask];
+
+            if (slot.sequence.load (std::memory_order_acquire) != position + 1) break;
+
+            events.push_back (std::move (slot.event));
+
+            slot.sequence.store (position + mask + 1, std::memory_order_release);
+        }
+
+        read_position.store (position, std::memory_order_relaxed);
+
+        return unsigned(events.size ());
+    }
+
+    void Event_Queue::clear ()
+    {
+        Event event;
+
+        while (poll (event));
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Event_Queue::update_high_water_mark (size_t written)
+    {
+        size_t   read  = read_position.load (std::memory_order_relaxed);
+        unsigned depth = written > read ? unsigned(written - read) : 0;
+        unsigned mark  = high_water_mark.load (std::memory_order_relaxed);
+
+        while (depth > mark && !high_water_mark.compare_exchange_weak (mark, depth, std::memory_order_relaxed));
+    }
+
+}
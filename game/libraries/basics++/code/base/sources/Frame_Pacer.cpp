@@ -0,0 +1,58 @@
+/*
+ * FRAME PACER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <thread>
+#include <basics/Frame_Pacer>
+
+namespace basics
+{
+
+    void Frame_Pacer::set_frame_duration (float seconds)
+    {
+        using std::chrono::duration;
+        using std::chrono::duration_cast;
+
+        period = seconds > 0.f ? duration_cast< Clock::duration > (duration< float >(seconds)) : Clock::duration::zero ();
+
+        reset ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Frame_Pacer::wait ()
+    {
+        if (period <= Clock::duration::zero ()) return;
+
+        Clock::time_point now = Clock::now ();
+
+        if (now < deadline)
+        {
+            if (deadline - now > spin_margin)
+            {
+                std::this_thread::sleep_for (deadline - now - spin_margin);
+            }
+
+            while (Clock::now () < deadline)
+            {
+                std::this_thread::yield ();
+            }
+
+            deadline += period;
+        }
+        else
+        {
+            // Un retraso menor que un fotograma se recupera acortando el siguiente. Uno mayor no,
+            // para no encadenar varios fotogramas sin espera:
+
+            deadline = now - deadline < period ? deadline + period : now + period;
+        }
+    }
+
+}
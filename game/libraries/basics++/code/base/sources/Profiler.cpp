@@ -0,0 +1,297 @@
+/*
+ * PROFILER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <basics/Log>
+#include <basics/Profiler>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        struct Sample
+        {
+            const char * name;
+            uint64_t     start;
+            uint64_t     end;
+            uint32_t     allocations;
+            uint32_t     bytes;
+        };
+
+        /**
+         * Búfer circular de un hilo. Solo escribe en él su hilo, que publica cada muestra
+         * avanzando el contador. Los lectores copian las muestras y después descartan las que el
+         * hilo haya podido sobrescribir mientras tanto.
+         */
+        struct Thread_Buffer
+        {
+            static constexpr uint64_t mask = Profiler::samples_per_thread - 1;
+
+            Sample                  samples[Profiler::samples_per_thread];
+            std::atomic< uint64_t > written;
+            std::atomic< uint64_t > first;          ///< Primera muestra que no se ha descartado.
+            unsigned                thread_index;
+
+            Thread_Buffer(unsigned index) : written(0), first(0), thread_index(index)
+            {
+            }
+
+            void copy_samples (std::vector< Sample > & copy) const
+            {
+                uint64_t end   = written.load (std::memory_order_acquire);
+                uint64_t begin = std::max (first.load (std::memory_order_relaxed), end > mask ? end - mask : 0);
+                size_t   size  = copy.size ();
+
+                for (uint64_t index = begin; index < end; ++index)
+                {
+                    copy.push_back (samples[index & mask]);
+                }
+
+                // Si el hilo ha seguido escribiendo, las muestras más antiguas pueden haber cambiado:
+
+                uint64_t now   = written.load (std::memory_order_acquire);
+                uint64_t valid = now > mask ? now - mask : 0;
+
+                if (valid > begin)
+                {
+                    size_t discarded = size_t(std::min (valid, end) - begin);
+
+                    copy.erase (copy.begin () + size, copy.begin () + size + discarded);
+                }
+            }
+        };
+
+        constexpr uint64_t Thread_Buffer::mask;
+
+        typedef std::vector< std::unique_ptr< Thread_Buffer > > Thread_Buffer_List;
+
+        // Los búferes no se liberan al terminar su hilo para que los lectores no tengan que
+        // sincronizarse con ellos:
+
+        std::mutex         buffers_mutex;
+        Thread_Buffer_List buffers;
+
+        thread_local Thread_Buffer * local_buffer = nullptr;
+
+        Thread_Buffer * register_thread ()
+        {
+            std::lock_guard< std::mutex > lock(buffers_mutex);
+
+            buffers.emplace_back (new Thread_Buffer(unsigned(buffers.size ())));
+
+            return local_buffer = buffers.back ().get ();
+        }
+
+        void copy_samples (std::vector< Sample > & samples, std::vector< unsigned > * threads)
+        {
+            std::lock_guard< std::mutex > lock(buffers_mutex);
+
+            for (auto & buffer : buffers)
+            {
+                buffer->copy_samples (samples);
+
+                if (threads) threads->resize (samples.size (), buffer->thread_index);
+            }
+        }
+
+        void write_json_string (std::FILE * file, const char * chars)
+        {
+            std::fputc ('"', file);
+
+            for ( ; *chars; ++chars)
+            {
+                if (*chars == '"' || *chars == '\\') std::fputc ('\\', file);
+
+                std::fputc (*chars, file);
+            }
+
+            std::fputc ('"', file);
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    std::atomic< bool > Profiler::enabled(false);
+
+    constexpr unsigned  Profiler::samples_per_thread;
+
+    static_assert((Profiler::samples_per_thread & (Profiler::samples_per_thread - 1)) == 0, "basics::Profiler: samples_per_thread must be a power of 2.");
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Profiler::record (const char * name, uint64_t start, uint64_t end, uint64_t allocations, uint64_t bytes)
+    {
+        Thread_Buffer * buffer = local_buffer ? local_buffer : register_thread ();
+        uint64_t        index  = buffer->written.load (std::memory_order_relaxed);
+        Sample        & sample = buffer->samples[index & Thread_Buffer::mask];
+
+        sample.name  = name;
+        sample.start = start;
+        sample.end         = end;
+        sample.allocations = uint32_t(allocations);
+        sample.bytes       = uint32_t(bytes);
+
+        buffer->written.store (index + 1, std::memory_order_release);
+    }
+
+    void Profiler::clear ()
+    {
+        std::lock_guard< std::mutex > lock(buffers_mutex);
+
+        for (auto & buffer : buffers)
+        {
+            buffer->first.store (buffer->written.load (std::memory_order_acquire), std::memory_order_relaxed);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Profiler::get_summary (Summary & summary)
+    {
+        struct Less
+        {
+            bool operator () (const char * a, const char * b) const { return std::strcmp (a, b) < 0; }
+        };
+
+        struct Zone_Samples
+        {
+            std::vector< double > times;
+            double                allocations;
+            double                bytes;
+
+            Zone_Samples() : allocations(0.0), bytes(0.0)
+            {
+            }
+        };
+
+        typedef std::map< const char *, Zone_Samples, Less > Zone_Map;
+
+        std::vector< Sample > samples;
+        Zone_Map              zones;
+
+        copy_samples (samples, nullptr);
+
+        for (const Sample & sample : samples)
+        {
+            Zone_Samples & zone = zones[sample.name];
+
+            zone.times.push_back (double(sample.end - sample.start) * 1e-6);
+
+            zone.allocations += sample.allocations;
+            zone.bytes       += sample.bytes;
+        }
+
+        summary.clear ();
+
+        for (auto & zone : zones)
+        {
+            std::vector< double > & times = zone.second.times;
+            Zone_Summary            entry;
+
+            std::sort (times.begin (), times.end ());
+
+            entry.name    = zone.first;
+            entry.count   = unsigned(times.size ());
+            entry.min     = times.front ();
+            entry.total   = 0.0;
+
+            for (double time : times) entry.total += time;
+
+            entry.average     = entry.total / double(times.size ());
+            entry.allocations = zone.second.allocations / double(times.size ());
+            entry.bytes       = zone.second.bytes       / double(times.size ());
+            entry.p99     = times[(times.size () * 99 + 99) / 100 - 1];        // Rango más cercano
+
+            summary.push_back (entry);
+        }
+
+        std::sort
+        (
+            summary.begin (),
+            summary.end   (),
+            [] (const Zone_Summary & a, const Zone_Summary & b) { return a.total > b.total; }
+        );
+    }
+
+    void Profiler::log_summary ()
+    {
+        Summary summary;
+        char    line[160];
+
+        get_summary (summary);
+
+        std::snprintf (line, sizeof(line), "%-32s %8s %10s %10s %10s %10s %10s", "zone", "count", "min ms", "avg ms", "p99 ms", "allocs", "bytes");
+
+        log.i (line);
+
+        for (const Zone_Summary & zone : summary)
+        {
+            std::snprintf
+            (
+                line, sizeof(line), "%-32s %8u %10.4f %10.4f %10.4f %10.1f %10.1f",
+                zone.name.c_str (), zone.count, zone.min, zone.average, zone.p99, zone.allocations, zone.bytes
+            );
+
+            log.i (line);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Profiler::write_chrome_trace (const std::string & path)
+    {
+        std::vector< Sample   > samples;
+        std::vector< unsigned > threads;
+
+        copy_samples (samples, &threads);
+
+        std::FILE * file = std::fopen (path.c_str (), "wb");
+
+        if (!file) return false;
+
+        uint64_t origin = ~uint64_t(0);
+
+        for (const Sample & sample : samples) origin = std::min (origin, sample.start);
+
+        std::fputs ("{\"traceEvents\":[\n", file);
+
+        for (size_t index = 0; index < samples.size (); ++index)
+        {
+            const Sample & sample = samples[index];
+
+            std::fputs (index > 0 ? ",\n{\"name\":" : "{\"name\":", file);
+
+            write_json_string (file, sample.name);
+
+            std::fprintf
+            (
+                file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"allocations\":%u,\"bytes\":%u}}",
+                threads[index],
+                double(sample.start - origin)       * 1e-3,
+                double(sample.end   - sample.start) * 1e-3,
+                sample.allocations,
+                sample.bytes
+            );
+        }
+
+        std::fputs ("\n],\"displayTimeUnit\":\"ms\"}\n", file);
+
+        return std::fclose (file) == 0;
+    }
+
+}
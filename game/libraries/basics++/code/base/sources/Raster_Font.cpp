@@ -10,9 +10,11 @@
  * C1802030114
  */
 
+#include <algorithm>
 #include <cstring>
 #include <rapidxml.hpp>
 #include <basics/Raster_Font>
+#include <basics/Startup_Timeline>
 
 using namespace std;
 using namespace rapidxml;
@@ -20,29 +22,345 @@ using namespace rapidxml;
 namespace basics
 {
 
+    namespace
+    {
+
+        // Los valores de los archivos binarios de BMFont están en little endian:
+
+        unsigned read_uint8  (const byte * data) { return data[0]; }
+        unsigned read_uint16 (const byte * data) { return unsigned(data[0]) | unsigned(data[1]) << 8; }
+        int      read_int16  (const byte * data) { return int16_t(read_uint16 (data)); }
+        uint32_t read_uint32 (const byte * data) { return uint32_t(read_uint16 (data)) | uint32_t(read_uint16 (data + 2)) << 16; }
+
+        /**
+         * Los archivos binarios de BMFont empiezan por "BMF" seguido de la versión.
+         */
+        bool is_binary (const vector< byte > & font_data)
+        {
+            return font_data.size () >= 4 && std::memcmp (font_data.data (), "BMF", 3) == 0;
+        }
+
+        /**
+         * Retorna la carpeta de una ruta incluyendo el separador final (o una cadena vacía si la
+         * ruta no tiene carpeta).
+         */
+        string get_folder (const string & path)
+        {
+            size_t slash     = path.find_last_of ('/' );
+            size_t backslash = path.find_last_of ('\\');
+
+            if (slash != string::npos && backslash != string::npos)
+            {
+                return path.substr (0, std::max (slash, backslash + 1));
+            }
+            else
+            if (slash != string::npos)
+            {
+                return path.substr (0, slash + 1);
+            }
+            else
+            if (backslash != string::npos)
+            {
+                return path.substr (0, backslash + 1);
+            }
+
+            return string();
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    constexpr uint32_t Raster_Font::direct_range;
+
+    // ---------------------------------------------------------------------------------------------
+
     Raster_Font::Raster_Font(const string & path, Graphics_Context::Accessor & context)
+    :
+        Raster_Font(path)
     {
+        BASICS_STARTUP_SPAN ("load font " + path);
+
+        for (unsigned page = 0; page < texture_paths.size (); ++page)
+        {
+            // Se intenta cargar la textura de cada página:
+
+            auto texture = Texture_2D::create (0, context, texture_paths[page]);
+
+            assert(texture);
+
+            if (texture)
+            {
+                context->add (texture);
+
+                set_texture (texture, page);
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Raster_Font::Raster_Font(const string & path)
+    :
+        parsed(false)
+    {
+        Character none;
+
+        none.slice   = nullptr;
+        none.offset  = Vector2f{ 0.f, 0.f };
+        none.advance = 0.f;
+
+        direct_characters.assign (direct_range, none);
+
         shared_ptr< Asset > font_file = Asset::open (path);
 
-        if (font_file->good ())
+        if (font_file && font_file->good ())
         {
             Buffer font_data;
 
             if (font_file->read_all (font_data))
             {
-                ready = parse (font_data, path, context);
+                parsed = is_binary (font_data) ? load (font_data, path) : parse (font_data, path);
             }
         }
     }
 
     // ---------------------------------------------------------------------------------------------
 
-    bool Raster_Font::parse
+    void Raster_Font::set_texture (const std::shared_ptr< Texture_2D > & texture, unsigned page)
+    {
+        if (parsed && page < pages.size ())
+        {
+            pages[page]->set_texture (texture);
+
+            // La fuente está lista cuando todas sus páginas tienen textura:
+
+            ready = true;
+
+            for (auto & atlas : pages)
+            {
+                if (!atlas->get_texture ()) ready = false;
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    const Raster_Font::Character * Raster_Font::find_character (uint32_t code) const
+    {
+        Character_List::const_iterator item = std::lower_bound
+        (
+            other_characters.begin (),
+            other_characters.end   (),
+            code,
+            [] (const Coded_Character & character, uint32_t code) { return character.code < code; }
+        );
+
+        return item != other_characters.end () && item->code == code ? &item->character : nullptr;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Raster_Font::add_page (const std::string & path, const char * file_name)
+    {
+        if (!*file_name) return false;
+
+        // Se determina la ruta de la textura, que se carga aparte, y los slices de los caracteres
+        // de la página se añaden a un atlas que recibe la textura después:
+
+        texture_paths.push_back (get_folder (path) + file_name);
+
+        pages.emplace_back (new Atlas(std::shared_ptr< Texture_2D >()));
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Raster_Font::add_character
     (
-        Buffer                     & font_data,
-        const std::string          & path,
-        Graphics_Context::Accessor & context
+        uint32_t code,
+        unsigned page,
+        int      x,
+        int      y,
+        int      width,
+        int      height,
+        int      x_offset,
+        int      y_offset,
+        int      advance
     )
+    {
+        // Se admiten caracteres sin imagen (como el espacio), que solo avanzan:
+
+        if (page >= pages.size () || width < 0 || height < 0) return false;
+
+        Character character;
+
+        character.slice   = pages[page]->add_slice (Id(code), { float(x), float(y) }, { float(width), float(height) });
+        character.offset  = Vector2f{ float(x_offset), float(y_offset) };
+        character.advance = float(advance);
+
+        if (!character.slice) return false;
+
+        if (code < direct_range)
+        {
+            if (direct_characters[code].slice) return false;
+
+            direct_characters[code] = character;
+        }
+        else
+            other_characters.push_back ({ code, character });
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Raster_Font::link_characters ()
+    {
+        std::sort
+        (
+            other_characters.begin (),
+            other_characters.end   (),
+            [] (const Coded_Character & a, const Coded_Character & b) { return a.code < b.code; }
+        );
+
+        // Un mismo código no puede aparecer en varias páginas:
+
+        for (size_t index = 1; index < other_characters.size (); ++index)
+        {
+            if (other_characters[index].code == other_characters[index - 1].code) return false;
+        }
+
+        // Los punteros que retorna Atlas::add_slice() dejan de ser válidos al añadir más slices, por
+        // lo que hasta ahora solo indicaban qué caracteres existen. Ya con todos los slices añadidos
+        // se buscan los definitivos:
+
+        auto link = [this] (uint32_t code, Character & character)
+        {
+            for (Atlas_Handle & atlas : pages)
+            {
+                if ((character.slice = atlas->get_slice (Id(code)))) break;
+            }
+        };
+
+        for (uint32_t code = 0; code < direct_range; ++code)
+        {
+            if (direct_characters[code].slice) link (code, direct_characters[code]);
+        }
+
+        for (Coded_Character & other : other_characters)
+        {
+            link (other.code, other.character);
+        }
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Raster_Font::load (const Buffer & font_data, const std::string & path)
+    {
+        // Solo se admite la versión 3 del formato binario, que está formada por bloques con un byte
+        // de tipo y 4 bytes de tamaño. Los datos se leen directamente del buffer sin copiarlos:
+
+        if (font_data[3] != 3) return false;
+
+        const byte * data        = font_data.data ();
+        size_t       size        = font_data.size ();
+        size_t       offset      = 4;
+        unsigned     page_count  = 0;
+        bool         info_read   = false;
+        bool         common_read = false;
+        bool         chars_read  = false;
+
+        while (offset + 5 <= size)
+        {
+            unsigned     type       = read_uint8  (data + offset);
+            size_t       block_size = read_uint32 (data + offset + 1);
+            const byte * block      = data + offset + 5;
+
+            offset += 5;
+
+            if (block_size > size - offset) return false;
+
+            offset += block_size;
+
+            if (type == 1)                                      // info
+            {
+                if (block_size < 15) return false;
+
+                const char * face = reinterpret_cast< const char * >(block + 14);
+
+                name.assign (face, strnlen (face, block_size - 14));
+
+                info_read = true;
+            }
+            else
+            if (type == 2)                                      // common
+            {
+                if (block_size < 15) return false;
+
+                metrics.line_height = float(read_uint16 (block));
+                metrics.base_height = metrics.line_height - float(read_uint16 (block + 2));
+                page_count          = read_uint16 (block + 8);
+
+                if (!(metrics.line_height > 0 && metrics.base_height < metrics.line_height)) return false;
+
+                common_read = true;
+            }
+            else
+            if (type == 3)                                      // pages
+            {
+                // Los nombres de los archivos de las páginas terminan con un caracter nulo:
+
+                if (!common_read || !pages.empty ()) return false;
+
+                for (size_t position = 0; pages.size () < page_count; )
+                {
+                    const char * file_name = reinterpret_cast< const char * >(block + position);
+                    size_t       length    = strnlen (file_name, block_size - position);
+
+                    if (position + length >= block_size || !add_page (path, file_name)) return false;
+
+                    position += length + 1;
+                }
+            }
+            else
+            if (type == 4)                                      // chars
+            {
+                if (pages.empty () || pages.size () != page_count || block_size % 20 != 0) return false;
+
+                for (const byte * record = block; record < block + block_size; record += 20)
+                {
+                    bool added = add_character
+                    (
+                        read_uint32 (record     ),              // id
+                        read_uint8  (record + 18),              // page
+                        read_uint16 (record +  4),              // x
+                        read_uint16 (record +  6),              // y
+                        read_uint16 (record +  8),              // width
+                        read_uint16 (record + 10),              // height
+                        read_int16  (record + 12),              // xoffset
+                        read_int16  (record + 14),              // yoffset
+                        read_int16  (record + 16)               // xadvance
+                    );
+
+                    if (!added) return false;
+                }
+
+                chars_read = block_size > 0;
+            }
+
+            // Los bloques de otros tipos (como el de kerning) se ignoran.
+        }
+
+        return info_read && common_read && chars_read && link_characters ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Raster_Font::parse (Buffer & font_data, const std::string & path)
     {
         // Se pone un caracter nulo al final para que el parseador de rapidxml sepa dónde está el
         // final de los datos:
@@ -61,7 +379,7 @@ namespace basics
 
         if (font_tag)
         {
-            return parse_font (font_tag, path, context);
+            return parse_font (font_tag, path) && link_characters ();
         }
 
         return false;
@@ -69,12 +387,7 @@ namespace basics
 
     // ---------------------------------------------------------------------------------------------
 
-    bool Raster_Font::parse_font
-    (
-        rapidxml::xml_node<>       * font_tag,
-        const std::string          & path,
-        Graphics_Context::Accessor & context
-    )
+    bool Raster_Font::parse_font (rapidxml::xml_node<> * font_tag, const std::string & path)
     {
         xml_node<> *   info_tag = font_tag->first_node ("info"  );
         xml_node<> * common_tag = font_tag->first_node ("common");
@@ -86,7 +399,7 @@ namespace basics
             common_tag &&
              pages_tag &&
              chars_tag &&
-             parse_pages  ( pages_tag, path, context) &&
+             parse_pages  ( pages_tag, path) &&
              parse_info   (  info_tag) &&
              parse_common (common_tag) &&
              parse_chars  ( chars_tag);
@@ -94,60 +407,23 @@ namespace basics
 
     // ---------------------------------------------------------------------------------------------
 
-    bool Raster_Font::parse_pages
-    (
-        rapidxml::xml_node<>       * pages_tag,
-        const std::string          & path,
-        Graphics_Context::Accessor & context
-    )
+    bool Raster_Font::parse_pages (rapidxml::xml_node<> * pages_tag, const std::string & path)
     {
-        xml_node<> * page = pages_tag->first_node ("page");
+        // Las páginas deben aparecer en el orden de sus ids:
 
-        if (page)
+        for (xml_node<> * page = pages_tag->first_node ("page"); page; page = page->next_sibling ("page"))
         {
+            xml_attribute<> *   id_attribute = page->first_attribute ("id"  );
             xml_attribute<> * file_attritube = page->first_attribute ("file");
 
-            if (file_attritube)
-            {
-                // Se determina la ruta de la textura:
-
-                size_t slash     = path.find_last_of ('/' );
-                size_t backslash = path.find_last_of ('\\');
-                string texture_path;
-
-                if (slash != string::npos && backslash != string::npos)
-                {
-                    texture_path = path.substr (0, std::max (slash, backslash + 1));
-                }
-                else
-                if (slash != string::npos)
-                {
-                    texture_path = path.substr (0, slash + 1);
-                }
-                else
-                if (backslash != string::npos)
-                {
-                    texture_path = path.substr (0, backslash + 1);
-                }
-
-                // Se intenta cargar la textura:
+            if (!file_attritube) return false;
 
-                auto texture = Texture_2D::create (0, context, texture_path + file_attritube->value ());
+            if (id_attribute && std::atoi (id_attribute->value ()) != int(pages.size ())) return false;
 
-                assert(texture);
-
-                if (texture)
-                {
-                    context->add (texture);
-
-                    atlas.reset (new Atlas(texture));
-
-                    return true;
-                }
-            }
+            if (!add_page (path, file_attritube->value ())) return false;
         }
 
-        return false;
+        return !pages.empty ();
     }
 
     // ---------------------------------------------------------------------------------------------
@@ -176,7 +452,7 @@ namespace basics
 
         if (pages_attribute)
         {
-            if (std::atoi (pages_attribute->value ()) != 1) return false;
+            if (std::atoi (pages_attribute->value ()) != int(pages.size ())) return false;
         }
 
         if (height_attribute)
@@ -230,6 +506,7 @@ namespace basics
         xml_attribute<> * x_offset_attribute = char_tag->first_attribute ("xoffset" );
         xml_attribute<> * y_offset_attribute = char_tag->first_attribute ("yoffset" );
         xml_attribute<> *  advance_attribute = char_tag->first_attribute ("xadvance");
+        xml_attribute<> *     page_attribute = char_tag->first_attribute ("page"    );
 
         if
         (
@@ -243,25 +520,18 @@ namespace basics
               advance_attribute
         )
         {
-            int id       = std::atoi (      id_attribute->value ());
-            int x        = std::atoi (       x_attribute->value ());
-            int y        = std::atoi (       y_attribute->value ());
-            int width    = std::atoi (   width_attribute->value ());
-            int height   = std::atoi (  height_attribute->value ());
-            int x_offset = std::atoi (x_offset_attribute->value ());
-            int y_offset = std::atoi (y_offset_attribute->value ());
-            int advance  = std::atoi ( advance_attribute->value ());
-
-            if (width > 0 && height > 0 && character_map.count (uint32_t(id)) == 0)
-            {
-                Character & character = character_map[uint32_t(id)];
-
-                character.slice   = atlas->add_slice (Id(id), { float(x), float(y) }, { float(width), float(height) });
-                character.offset  = Vector2f{ float(x_offset), float(y_offset) };
-                character.advance = float(advance);
-
-                return true;
-            };
+            return add_character
+            (
+                uint32_t(std::atoi (id_attribute->value ())),
+                page_attribute ? unsigned(std::atoi (page_attribute->value ())) : 0u,
+                std::atoi (       x_attribute->value ()),
+                std::atoi (       y_attribute->value ()),
+                std::atoi (   width_attribute->value ()),
+                std::atoi (  height_attribute->value ()),
+                std::atoi (x_offset_attribute->value ()),
+                std::atoi (y_offset_attribute->value ()),
+                std::atoi ( advance_attribute->value ())
+            );
         }
 
         return false;
@@ -0,0 +1,258 @@
+/*
+ * STARTUP TIMELINE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <basics/Log>
+#include <basics/Startup_Timeline>
+
+#if defined(__linux__)
+    #include <ctime>
+    #include <unistd.h>
+#endif
+
+namespace basics
+{
+
+    namespace
+    {
+
+        // Los hitos se pueden registrar durante la inicialización de objetos estáticos (antes de
+        // main()), por lo que el estado se crea la primera vez que se usa:
+
+        struct Timeline
+        {
+            std::mutex                     mutex;
+            Startup_Timeline::Entry_List   entries;
+        };
+
+        Timeline & get_timeline ()
+        {
+            static Timeline timeline;
+
+            return timeline;
+        }
+
+        unsigned get_thread_index ()
+        {
+            static std::atomic< unsigned > next_index(0);
+
+            thread_local unsigned index = next_index++;
+
+            return index;
+        }
+
+        void add_entry (const std::string & name, uint64_t start, uint64_t end, bool milestone)
+        {
+            Timeline & timeline = get_timeline ();
+
+            std::lock_guard< std::mutex > lock(timeline.mutex);
+
+            if (timeline.entries.size () < Startup_Timeline::max_entries)
+            {
+                timeline.entries.push_back ({ name, start, end, get_thread_index (), milestone });
+            }
+        }
+
+        void write_json_string (std::FILE * file, const std::string & text)
+        {
+            std::fputc ('"', file);
+
+            for (char c : text)
+            {
+                if (c == '"' || c == '\\') std::fputc ('\\', file);
+
+                std::fputc (c, file);
+            }
+
+            std::fputc ('"', file);
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    std::atomic< bool > Startup_Timeline::enabled(false);
+
+    constexpr unsigned Startup_Timeline::max_entries;
+
+    // ---------------------------------------------------------------------------------------------
+
+    uint64_t Startup_Timeline::get_process_start ()
+    {
+        #if defined(__linux__)
+
+            // El campo 22 de /proc/self/stat es el instante de inicio del proceso en ticks desde el
+            // arranque del sistema. Se traslada al reloj de Profiler::now() restando cuánto ha
+            // pasado desde entonces según CLOCK_BOOTTIME:
+
+            std::FILE * file = std::fopen ("/proc/self/stat", "rb");
+
+            if (file)
+            {
+                char   text[1024];
+                size_t length = std::fread (text, 1, sizeof(text) - 1, file);
+
+                std::fclose (file);
+
+                text[length] = 0;
+
+                // El nombre del ejecutable (campo 2) puede contener espacios, así que se cuenta a
+                // partir del último paréntesis:
+
+                const char * field = std::strrchr (text, ')');
+                unsigned long long start_ticks = 0;
+
+                for (unsigned index = 2; field && index < 22; ++index)
+                {
+                    field = std::strchr (field + 1, ' ');
+                }
+
+                long     ticks_per_second = sysconf (_SC_CLK_TCK);
+                timespec boot_time;
+
+                if
+                (
+                    field && std::sscanf (field + 1, "%llu", &start_ticks) == 1 && ticks_per_second > 0 &&
+                    clock_gettime (CLOCK_BOOTTIME, &boot_time) == 0
+                )
+                {
+                    uint64_t now      = Profiler::now ();
+                    uint64_t boot_now = uint64_t(boot_time.tv_sec) * 1000000000u + uint64_t(boot_time.tv_nsec);
+                    uint64_t started  = uint64_t(start_ticks) * 1000000000u / uint64_t(ticks_per_second);
+
+                    if (boot_now >= started && now >= boot_now - started)
+                    {
+                        return now - (boot_now - started);
+                    }
+                }
+            }
+
+        #endif
+
+        Entry_List entries;
+
+        get_entries (entries);
+
+        return entries.empty () ? Profiler::now () : entries.front ().start;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Startup_Timeline::mark (const std::string & name)
+    {
+        uint64_t now = Profiler::now ();
+
+        add_entry (name, now, now, true);
+    }
+
+    void Startup_Timeline::record (const std::string & name, uint64_t start, uint64_t end)
+    {
+        if (is_enabled ()) add_entry (name, start, end, false);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Startup_Timeline::get_entries (Entry_List & entries)
+    {
+        {
+            Timeline & timeline = get_timeline ();
+
+            std::lock_guard< std::mutex > lock(timeline.mutex);
+
+            entries = timeline.entries;
+        }
+
+        std::stable_sort
+        (
+            entries.begin (),
+            entries.end   (),
+            [] (const Entry & a, const Entry & b) { return a.start < b.start; }
+        );
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Startup_Timeline::log_timeline ()
+    {
+        Entry_List entries;
+
+        get_entries (entries);
+
+        uint64_t origin = get_process_start ();
+        char     line[256];
+
+        log.i ("startup timeline (ms since process start):");
+
+        for (const Entry & entry : entries)
+        {
+            double start = entry.start >= origin ? double(entry.start - origin) * 1e-6 : -double(origin - entry.start) * 1e-6;
+
+            if (entry.milestone)
+            {
+                std::snprintf (line, sizeof(line), "  %10.3f %10s  * %s", start, "", entry.name.c_str ());
+            }
+            else
+            {
+                std::snprintf (line, sizeof(line), "  %10.3f %10.3f    %s", start, double(entry.end - entry.start) * 1e-6, entry.name.c_str ());
+            }
+
+            log.i (line);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Startup_Timeline::write_chrome_trace (const std::string & path)
+    {
+        Entry_List entries;
+
+        get_entries (entries);
+
+        std::FILE * file = std::fopen (path.c_str (), "wb");
+
+        if (!file) return false;
+
+        uint64_t origin = get_process_start ();
+
+        // Se empieza por el inicio del proceso, que no es una entrada registrada:
+
+        std::fputs ("{\"traceEvents\":[\n{\"name\":\"process start\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":0}", file);
+
+        for (const Entry & entry : entries)
+        {
+            double start = entry.start >= origin ? double(entry.start - origin) * 1e-3 : 0.0;
+
+            std::fputs (",\n{\"name\":", file);
+
+            write_json_string (file, entry.name);
+
+            if (entry.milestone)
+            {
+                std::fprintf (file, ",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}", entry.thread, start);
+            }
+            else
+            {
+                std::fprintf
+                (
+                    file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    entry.thread, start, double(entry.end - entry.start) * 1e-3
+                );
+            }
+        }
+
+        std::fputs ("\n],\"displayTimeUnit\":\"ms\"}\n", file);
+
+        return std::fclose (file) == 0;
+    }
+
+}
@@ -11,6 +11,7 @@
  */
 
 #include <basics/png_decode>
+#include <basics/Startup_Timeline>
 #include <basics/Texture_2D>
 
 namespace basics
@@ -35,27 +36,47 @@ namespace basics
         return std::shared_ptr< Texture_2D >();
     }
 
-    std::shared_ptr< Texture_2D > Texture_2D::create (Id id, Graphics_Context::Accessor & context, const std::string & asset_path, const Options & options)
+    std::shared_ptr< Texture_2D > Texture_2D::create (Id id, Graphics_Context::Accessor & context, const std::string & asset_path, const Options & )
+    {
+        Color_Buffer< Rgba8888 > color_buffer;
+        Texture_2D::Options      options;
+
+        if (decode (asset_path, color_buffer, options))
+        {
+            BASICS_STARTUP_SPAN ("create texture " + asset_path);
+
+            return Texture_2D::create (id, context, color_buffer, options);
+        }
+
+        return std::shared_ptr< Texture_2D >();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Texture_2D::decode (const std::string & asset_path, Color_Buffer< Rgba8888 > & color_buffer, Options & options)
     {
         std::shared_ptr< Asset > asset = Asset::open (asset_path);
 
         if (asset)
         {
-            std::vector< byte >  data;
+            std::vector< byte > data;
+            bool                read;
 
-            if (asset->read_all (data))
             {
-                Color_Buffer< Rgba8888 > color_buffer;
-                Texture_2D::Options      options;
+                BASICS_STARTUP_SPAN ("read " + asset_path);
 
-                if (png_decode (data, color_buffer, options.width, options.height))
-                {
-                    return Texture_2D::create (id, context, color_buffer, options);
-                }
+                read = asset->read_all (data);
+            }
+
+            if (read)
+            {
+                BASICS_STARTUP_SPAN ("decode " + asset_path);
+
+                return png_decode (data, color_buffer, options.width, options.height);
             }
         }
 
-        return std::shared_ptr< Texture_2D >();
+        return false;
     }
 
 }
@@ -0,0 +1,131 @@
+/*
+ * THREAD POOL
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <basics/Thread_Pool>
+
+namespace basics
+{
+
+    Thread_Pool::Thread_Pool(unsigned worker_count)
+    :
+        task        (nullptr),
+        task_count  (0),
+        next_index  (0),
+        busy_workers(0),
+        generation  (0),
+        exit        (false)
+    {
+        if (worker_count == 0)
+        {
+            unsigned cores = std::thread::hardware_concurrency ();
+
+            worker_count = cores > 1 ? cores - 1 : 0;
+        }
+
+        for (unsigned index = 0; index < worker_count; ++index)
+        {
+            workers.emplace_back (&Thread_Pool::worker_function, this);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Thread_Pool::~Thread_Pool()
+    {
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            exit = true;
+        }
+
+        work_available.notify_all ();
+
+        for (auto & worker : workers)
+        {
+            worker.join ();
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Thread_Pool::parallel_for (unsigned count, const Task & new_task)
+    {
+        if (count == 0) return;
+
+        if (workers.empty () || count == 1)
+        {
+            for (unsigned index = 0; index < count; ++index) new_task (index);
+
+            return;
+        }
+
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            task         = &new_task;
+            task_count   = count;
+            next_index   = 0;
+            busy_workers = unsigned(workers.size ());
+
+            generation++;
+        }
+
+        work_available.notify_all ();
+
+        // El hilo que encarga el trabajo también procesa índices mientras los haya:
+
+        run_pending_indices ();
+
+        std::unique_lock< std::mutex > lock(mutex);
+
+        work_done.wait (lock, [this] () { return busy_workers == 0; });
+
+        task = nullptr;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Thread_Pool::worker_function ()
+    {
+        unsigned last_generation = 0;
+
+        for (;;)
+        {
+            {
+                std::unique_lock< std::mutex > lock(mutex);
+
+                work_available.wait (lock, [&] () { return exit || generation != last_generation; });
+
+                if (exit) return;
+
+                last_generation = generation;
+            }
+
+            run_pending_indices ();
+
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                if (--busy_workers == 0) work_done.notify_one ();
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Thread_Pool::run_pending_indices ()
+    {
+        for (unsigned index = next_index++; index < task_count; index = next_index++)
+        {
+            (*task) (index);
+        }
+    }
+
+}
@@ -0,0 +1,155 @@
+/*
+ * BENCHMARK SUITE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <basics/Log>
+#include <basics/Profiler>
+#include "Benchmark_Suite.hpp"
+
+namespace basics { namespace benchmarks
+{
+
+    constexpr uint64_t Benchmark_Suite::min_sample_time;
+
+    // ---------------------------------------------------------------------------------------------
+
+    unsigned Benchmark_Suite::run (const std::string & filter)
+    {
+        unsigned count = 0;
+
+        for (const Benchmark & benchmark : benchmarks)
+        {
+            if (!filter.empty () && benchmark.name.find (filter) == std::string::npos) continue;
+
+            results.push_back (measure (benchmark));
+
+            const Result & result = results.back ();
+            char           line[160];
+
+            std::snprintf
+            (
+                line, sizeof(line), "%-46s %12.1f ns median %12.1f ns min %9u x %u",
+                result.name.c_str (), result.median, result.min, result.batch, result.samples
+            );
+
+            log.i (line);
+
+            ++count;
+        }
+
+        return count;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Benchmark_Suite::Result Benchmark_Suite::measure (const Benchmark & benchmark)
+    {
+        // Se duplica el número de iteraciones hasta que una muestra dura lo suficiente. Esta
+        // primera fase sirve además para calentar las cachés:
+
+        unsigned batch = 1;
+
+        for (;;)
+        {
+            uint64_t start = Profiler::now ();
+
+            benchmark.body (batch);
+
+            uint64_t elapsed = Profiler::now () - start;
+
+            if (elapsed >= min_sample_time || batch >= benchmark.options.max_batch) break;
+
+            batch = std::min (batch * 2, benchmark.options.max_batch);
+        }
+
+        // Se toman las muestras:
+
+        std::vector< double > times;
+
+        times.reserve (benchmark.options.samples);
+
+        for (unsigned sample = 0; sample < benchmark.options.samples; ++sample)
+        {
+            uint64_t start = Profiler::now ();
+
+            benchmark.body (batch);
+
+            times.push_back (double(Profiler::now () - start) / double(batch));
+        }
+
+        std::sort (times.begin (), times.end ());
+
+        Result result;
+
+        result.name    = benchmark.name;
+        result.samples = unsigned(times.size ());
+        result.batch   = batch;
+        result.min     = times.front ();
+        result.max     = times.back  ();
+        result.median  = times[times.size () / 2];
+        result.mean    = 0.0;
+
+        for (double time : times) result.mean += time;
+
+        result.mean /= double(times.size ());
+
+        return result;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Benchmark_Suite::write_json (const std::string & path) const
+    {
+        std::FILE * file = std::fopen (path.c_str (), "wb");
+
+        if (!file) return false;
+
+        char        date[32];
+        std::time_t now = std::time (nullptr);
+
+        std::strftime (date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime (&now));
+
+        std::fprintf (file, "{\n  \"date\": \"%s\",\n", date);
+
+        #if defined(__VERSION__)
+            std::fprintf (file, "  \"compiler\": \"%s\",\n", __VERSION__);
+        #endif
+
+        #if defined(NDEBUG)
+            std::fprintf (file, "  \"assertions\": false,\n");
+        #else
+            std::fprintf (file, "  \"assertions\": true,\n");
+        #endif
+
+        std::fprintf (file, "  \"unit\": \"ns\",\n  \"benchmarks\": [\n");
+
+        for (size_t index = 0; index < results.size (); ++index)
+        {
+            const Result & result = results[index];
+
+            std::fprintf
+            (
+                file,
+                "    {\"name\":\"%s\",\"samples\":%u,\"iterations\":%u,"
+                "\"min\":%.3f,\"median\":%.3f,\"mean\":%.3f,\"max\":%.3f}%s\n",
+                result.name.c_str (), result.samples, result.batch,
+                result.min, result.median, result.mean, result.max,
+                index + 1 < results.size () ? "," : ""
+            );
+        }
+
+        std::fprintf (file, "  ]\n}\n");
+
+        return std::fclose (file) == 0;
+    }
+
+}}
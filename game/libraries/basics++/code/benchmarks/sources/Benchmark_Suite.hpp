@@ -0,0 +1,132 @@
+/*
+ * BENCHMARK SUITE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_BENCHMARK_SUITE_HEADER
+#define BASICS_BENCHMARK_SUITE_HEADER
+
+    #include <functional>
+    #include <string>
+    #include <vector>
+    #include <basics/Graphics_Context>
+    #include <basics/Non_Copyable>
+
+    namespace basics { namespace benchmarks
+    {
+
+        /**
+         * Conjunto de micro-benchmarks. Cada benchmark es una función que repite la operación
+         * medida el número de veces que se le indica. La suite ajusta ese número hasta que cada
+         * muestra dura lo suficiente como para que la resolución del reloj no importe, toma varias
+         * muestras y calcula el tiempo por iteración de cada una.
+         */
+        class Benchmark_Suite : Non_Copyable
+        {
+        public:
+
+            typedef std::function< void (unsigned iterations) > Body;
+
+            struct Options
+            {
+                unsigned samples;               ///< Número de muestras que se toman.
+                unsigned max_batch;             ///< Máximo de iteraciones por muestra.
+            };
+
+            struct Result
+            {
+                std::string name;
+                unsigned    samples;
+                unsigned    batch;              ///< Iteraciones por muestra.
+                double      min;                ///< Nanosegundos por iteración.
+                double      median;
+                double      mean;
+                double      max;
+            };
+
+            typedef std::vector< Result > Result_List;
+
+            static constexpr unsigned default_samples   = 15;
+            static constexpr unsigned default_max_batch = 1u << 24;
+
+            /// Duración mínima de cada muestra en nanosegundos.
+            static constexpr uint64_t min_sample_time   = 10000000;
+
+        private:
+
+            struct Benchmark
+            {
+                std::string name;
+                Body        body;
+                Options     options;
+            };
+
+            typedef std::vector< Benchmark > Benchmark_List;
+
+        private:
+
+            Benchmark_List benchmarks;
+            Result_List    results;
+
+        public:
+
+            void add (const std::string & name, const Body & body)
+            {
+                add (name, body, { default_samples, default_max_batch });
+            }
+
+            void add (const std::string & name, const Body & body, const Options & options)
+            {
+                benchmarks.push_back ({ name, body, options });
+            }
+
+            /**
+             * Ejecuta los benchmarks cuyo nombre contiene el texto indicado (todos si está vacío).
+             * @return El número de benchmarks ejecutados.
+             */
+            unsigned run (const std::string & filter = std::string());
+
+            const Result_List & get_results () const
+            {
+                return results;
+            }
+
+            /**
+             * Guarda los resultados en formato JSON para poder compararlos con los de otras
+             * ejecuciones.
+             */
+            bool write_json (const std::string & path) const;
+
+        private:
+
+            Result measure (const Benchmark & benchmark);
+
+        };
+
+        /**
+         * Evita que el compilador elimine el cálculo de un valor que no se usa después.
+         */
+        template< typename TYPE >
+        inline void keep (const TYPE & value)
+        {
+            #if defined(__GNUC__)
+                asm volatile ("" : : "r"(&value) : "memory");
+            #else
+                static volatile const void * sink; sink = &value;
+            #endif
+        }
+
+        // Funciones que añaden cada grupo de benchmarks a la suite:
+
+        void add_asset_benchmarks (Benchmark_Suite & suite, Graphics_Context::Accessor & context);
+        void add_event_benchmarks (Benchmark_Suite & suite);
+        void add_math_benchmarks  (Benchmark_Suite & suite);
+
+    }}
+
+#endif
@@ -0,0 +1,447 @@
+/*
+ * ASSET BENCHMARKS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <basics/Asset>
+#include <basics/Asset_Cache>
+#include <basics/Atlas>
+#include <basics/Color_Buffer>
+#include <basics/Log>
+#include <basics/png_decode>
+#include <basics/Raster_Font>
+#include <basics/Text_Layout>
+#include "Benchmark_Suite.hpp"
+
+namespace basics { namespace benchmarks
+{
+
+    namespace
+    {
+
+        typedef std::vector< byte > Buffer;
+
+        const char * const atlas_paths[] =
+        {
+            "game-scene/game.atlas",
+            "game-scene/pause.atlas",
+            "menu-scene/menu.atlas",
+        };
+
+        // Las definiciones de los atlas en XML y compiladas, para comparar su lectura:
+
+        const char * const definition_paths[] =
+        {
+            "game-scene/game.sprites",
+            "game-scene/game.atlas",
+            "menu-scene/menu.sprites",
+            "menu-scene/menu.atlas",
+        };
+
+        const char * const image_paths[] =
+        {
+            "game-scene/game.png",
+            "game-scene/pause-spritesheet.png",
+            "menu-scene/menu.png",
+        };
+
+        bool load (const std::string & path, Buffer & buffer)
+        {
+            std::shared_ptr< Asset > asset = Asset::open (path);
+
+            return asset->good () && asset->read_all (buffer);
+        }
+
+        /**
+         * Carpeta temporal con los archivos de la fuente de prueba, que se borran al terminar.
+         */
+        struct Temporary_Folder
+        {
+            std::string                path;
+            std::vector< std::string > files;
+
+           ~Temporary_Folder()
+            {
+                for (const std::string & file : files) unlink (file.c_str ());
+
+                if (!path.empty ()) rmdir (path.c_str ());
+            }
+        };
+
+        Temporary_Folder test_font_folder;
+
+        struct Test_Glyph
+        {
+            unsigned code, page, x, y, width, height;
+        };
+
+        bool write_file (const std::string & path, const Buffer & data)
+        {
+            std::FILE * file = std::fopen (path.c_str (), "wb");
+
+            if (!file) return false;
+
+            test_font_folder.files.push_back (path);
+
+            bool written = std::fwrite (data.data (), 1, data.size (), file) == data.size ();
+
+            return std::fclose (file) == 0 && written;
+        }
+
+        void put (Buffer & data, uint32_t value, unsigned size)
+        {
+            for (unsigned index = 0; index < size; ++index, value >>= 8) data.push_back (byte(value));
+        }
+
+        void put_block (Buffer & data, unsigned type, const Buffer & block)
+        {
+            put (data, type, 1);
+            put (data, uint32_t(block.size ()), 4);
+
+            data.insert (data.end (), block.begin (), block.end ());
+        }
+
+        /**
+         * Los assets del juego no incluyen ninguna fuente, por lo que se genera una en formato
+         * BMFont, tanto en XML (test.fnt) como en binario (test-binary.fnt), con dos páginas que
+         * usan test.png: la primera con los caracteres ASCII dispuestos en una rejilla (el espacio
+         * sin imagen) y la segunda con las letras griegas, que quedan fuera de la tabla directa.
+         * @return La carpeta con los archivos o una cadena vacía si no se pudieron crear.
+         */
+        std::string make_test_font ()
+        {
+            char folder[] = "/tmp/basics-benchmarks-XXXXXX";
+
+            if (!mkdtemp (folder)) return std::string();
+
+            test_font_folder.path = folder;
+
+            Buffer image;
+
+            if (!load ("test.png", image) || !write_file (test_font_folder.path + "/test.png", image)) return std::string();
+
+            std::vector< Test_Glyph > glyphs;
+
+            for (unsigned code = 32; code < 127; ++code)
+            {
+                unsigned cell = code - 32;
+
+                glyphs.push_back ({ code, 0, cell % 16 * 16, cell / 16 * 24, code == 32 ? 0u : 16u, code == 32 ? 0u : 24u });
+            }
+
+            for (unsigned code = 0x391; code <= 0x3C9; ++code)
+            {
+                unsigned cell = code - 0x391;
+
+                glyphs.push_back ({ code, 1, cell % 16 * 16, cell / 16 * 24, 16, 24 });
+            }
+
+            // Versión XML:
+
+            std::string xml;
+            char        line[256];
+
+            xml += "<?xml version=\"1.0\"?>\n<font>\n";
+            xml += "  <info face=\"test\" size=\"24\"/>\n";
+            xml += "  <common lineHeight=\"24\" base=\"20\" scaleW=\"300\" scaleH=\"300\" pages=\"2\"/>\n";
+            xml += "  <pages><page id=\"0\" file=\"test.png\"/><page id=\"1\" file=\"test.png\"/></pages>\n";
+            xml += "  <chars count=\"" + std::to_string (glyphs.size ()) + "\">\n";
+
+            for (const Test_Glyph & glyph : glyphs)
+            {
+                std::snprintf
+                (
+                    line, sizeof(line),
+                    "    <char id=\"%u\" x=\"%u\" y=\"%u\" width=\"%u\" height=\"%u\" xoffset=\"0\" yoffset=\"0\" xadvance=\"16\" page=\"%u\"/>\n",
+                    glyph.code, glyph.x, glyph.y, glyph.width, glyph.height, glyph.page
+                );
+
+                xml += line;
+            }
+
+            xml += "  </chars>\n</font>\n";
+
+            // Versión binaria (BMFont versión 3):
+
+            Buffer binary { 'B', 'M', 'F', 3 }, block;
+
+            put (block, 24, 2);                                 // fontSize
+            put (block,  0, 12);                                // bitField, charSet, stretchH, aa, padding, spacing, outline
+            block.insert (block.end (), { 't', 'e', 's', 't', 0 });
+            put_block (binary, 1, block);
+
+            block.clear ();
+            put (block,  24, 2);                                // lineHeight
+            put (block,  20, 2);                                // base
+            put (block, 300, 2);                                // scaleW
+            put (block, 300, 2);                                // scaleH
+            put (block,   2, 2);                                // pages
+            put (block,   0, 5);                                // bitField, alphaChnl, redChnl, greenChnl, blueChnl
+            put_block (binary, 2, block);
+
+            block.clear ();
+            for (unsigned page = 0; page < 2; ++page) block.insert (block.end (), { 't', 'e', 's', 't', '.', 'p', 'n', 'g', 0 });
+            put_block (binary, 3, block);
+
+            block.clear ();
+
+            for (const Test_Glyph & glyph : glyphs)
+            {
+                put (block, glyph.code,   4);
+                put (block, glyph.x,      2);
+                put (block, glyph.y,      2);
+                put (block, glyph.width,  2);
+                put (block, glyph.height, 2);
+                put (block, 0,            4);                   // xoffset, yoffset
+                put (block, 16,           2);                   // xadvance
+                put (block, glyph.page,   1);
+                put (block, 15,           1);                   // chnl
+            }
+
+            put_block (binary, 4, block);
+
+            bool written =
+                write_file (test_font_folder.path + "/test.fnt", Buffer(xml.begin (), xml.end ())) &&
+                write_file (test_font_folder.path + "/test-binary.fnt", binary);
+
+            return written ? test_font_folder.path : std::string();
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void add_asset_benchmarks (Benchmark_Suite & suite, Graphics_Context::Accessor & context)
+    {
+        // Cada atlas creado deja su textura en el contexto gráfico, por lo que se limita el
+        // número de veces que se construye:
+
+        for (const char * path : atlas_paths)
+        {
+            suite.add
+            (
+                std::string("Atlas::Atlas/") + path,
+                [path, &context] (unsigned iterations)
+                {
+                    for (unsigned iteration = 0; iteration < iterations; ++iteration)
+                    {
+                        Atlas atlas(path, context);
+
+                        keep (atlas);
+                    }
+                },
+                { 5, 1 }
+            );
+        }
+
+        // Una vez guardado en la caché, volver a pedir un atlas (como al reiniciar una escena) solo
+        // cuesta buscar su ruta normalizada:
+
+        std::shared_ptr< Asset_Cache > cache(new Asset_Cache);
+
+        if (cache->load_atlas (atlas_paths[0], context))
+        {
+            const char * path = atlas_paths[0];
+
+            suite.add
+            (
+                std::string("Asset_Cache::load_atlas/hit/") + path,
+                [cache, path, &context] (unsigned iterations)
+                {
+                    for (unsigned iteration = 0; iteration < iterations; ++iteration)
+                    {
+                        keep (cache->load_atlas (path, context));
+                    }
+                }
+            );
+        }
+
+        for (const char * path : definition_paths)
+        {
+            suite.add
+            (
+                std::string("Atlas::read/") + path,
+                [path] (unsigned iterations)
+                {
+                    for (unsigned iteration = 0; iteration < iterations; ++iteration)
+                    {
+                        Atlas atlas(path);
+
+                        keep (atlas);
+                    }
+                }
+            );
+        }
+
+        // Búsqueda de slices existentes e inexistentes en el atlas del juego:
+
+        std::shared_ptr< Atlas > atlas(new Atlas(atlas_paths[0], context));
+
+        if (atlas->good ())
+        {
+            static const Id ids[] =
+            {
+                ID(left), ID(right), ID(background), ID(character), ID(down),
+                ID(loading), ID(pause), ID(platform), ID(top), ID(missing),
+            };
+
+            suite.add
+            (
+                "Atlas::get_slice",
+                [atlas] (unsigned iterations)
+                {
+                    for (unsigned iteration = 0; iteration < iterations; ++iteration)
+                    {
+                        keep (atlas->get_slice (ids[iteration % (sizeof(ids) / sizeof(ids[0]))]));
+                    }
+                }
+            );
+
+            // Los handles se resuelven una vez y después se accede directamente al slice:
+
+            std::shared_ptr< std::vector< Atlas::Slice_Handle > > handles(new std::vector< Atlas::Slice_Handle >);
+
+            for (Id id : ids)
+            {
+                if (atlas->get_slice_handle (id) != Atlas::no_slice) handles->push_back (atlas->get_slice_handle (id));
+            }
+
+            suite.add
+            (
+                "Atlas::operator[]",
+                [atlas, handles] (unsigned iterations)
+                {
+                    for (unsigned iteration = 0; iteration < iterations; ++iteration)
+                    {
+                        keep ((*atlas)[(*handles)[iteration % handles->size ()]]);
+                    }
+                }
+            );
+        }
+        else
+            log.e ("ERROR: the game atlas could not be loaded.");
+
+        // Decodificación de los PNG de los atlas ya cargados en memoria:
+
+        for (const char * path : image_paths)
+        {
+            std::shared_ptr< Buffer > encoded(new Buffer);
+
+            if (!load (path, *encoded))
+            {
+                log.e ((std::string("ERROR: failed to read ") + path).c_str ());
+                continue;
+            }
+
+            suite.add
+            (
+                std::string("png_decode/") + path,
+                [encoded] (unsigned iterations)
+                {
+                    for (unsigned iteration = 0; iteration < iterations; ++iteration)
+                    {
+                        Color_Buffer< Rgba8888 > color_buffer;
+                        unsigned width, height;
+
+                        png_decode (*encoded, color_buffer, width, height);
+
+                        keep (color_buffer);
+                    }
+                },
+                { 5, 64 }
+            );
+        }
+
+        // Fuentes:
+
+        std::string font_folder = make_test_font ();
+
+        if (font_folder.empty ())
+        {
+            log.e ("ERROR: the test font could not be created.");
+            return;
+        }
+
+        for (const char * name : { "test.fnt", "test-binary.fnt" })
+        {
+            std::string path = font_folder + '/' + name;
+
+            suite.add
+            (
+                std::string("Raster_Font::read/") + name,
+                [path] (unsigned iterations)
+                {
+                    for (unsigned iteration = 0; iteration < iterations; ++iteration)
+                    {
+                        Raster_Font font(path);
+
+                        keep (font);
+                    }
+                }
+            );
+        }
+
+        std::shared_ptr< Raster_Font > font(new Raster_Font(font_folder + "/test-binary.fnt", context));
+
+        if (!font->good ())
+        {
+            log.e ("ERROR: the test font could not be loaded.");
+            return;
+        }
+
+        suite.add
+        (
+            "Raster_Font::get_character",
+            [font] (unsigned iterations)
+            {
+                for (unsigned iteration = 0; iteration < iterations; ++iteration)
+                {
+                    keep (font->get_character (32 + iteration % 100));
+                }
+            }
+        );
+
+        suite.add
+        (
+            "Raster_Font::get_character/greek",
+            [font] (unsigned iterations)
+            {
+                for (unsigned iteration = 0; iteration < iterations; ++iteration)
+                {
+                    keep (font->get_character (0x391 + iteration % 64));
+                }
+            }
+        );
+
+        std::shared_ptr< std::wstring > text
+        (
+            new std::wstring(L"The quick brown fox jumps over the lazy dog.\nPACK MY BOX WITH FIVE DOZEN LIQUOR JUGS!\n0123456789 \u0391\u03B2\u03B3")
+        );
+
+        suite.add
+        (
+            "Text_Layout::Text_Layout",
+            [font, text] (unsigned iterations)
+            {
+                for (unsigned iteration = 0; iteration < iterations; ++iteration)
+                {
+                    Text_Layout layout(*font, *text);
+
+                    keep (layout);
+                }
+            }
+        );
+    }
+
+}}
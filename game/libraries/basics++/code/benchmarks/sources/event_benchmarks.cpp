@@ -0,0 +1,101 @@
+/*
+ * EVENT BENCHMARKS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <memory>
+#include <thread>
+#include <basics/Event_Queue>
+#include "Benchmark_Suite.hpp"
+
+namespace basics { namespace benchmarks
+{
+
+    namespace
+    {
+
+        /**
+         * Varios productores añaden en total el número de eventos indicado mientras el hilo que
+         * llama los extrae, como hacen la ventana y la aplicación con el director.
+         */
+        void push_and_poll (Event_Queue & queue, unsigned producers, unsigned events)
+        {
+            std::vector< std::thread > threads;
+
+            unsigned share = events / producers;
+
+            for (unsigned producer = 0; producer < producers; ++producer)
+            {
+                unsigned count = producer + 1 < producers ? share : events - share * (producers - 1);
+
+                threads.emplace_back
+                (
+                    [&queue, count, producer] ()
+                    {
+                        Event event(ID(benchmark));
+
+                        event[ID(producer)] = float(producer);
+
+                        for (unsigned index = 0; index < count; ++index)
+                        {
+                            queue.push (event);
+                        }
+                    }
+                );
+            }
+
+            Event event;
+
+            for (unsigned received = 0; received < events; )
+            {
+                if (queue.poll (event)) ++received;
+                else std::this_thread::yield ();
+            }
+
+            for (auto & thread : threads) thread.join ();
+        }
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void add_event_benchmarks (Benchmark_Suite & suite)
+    {
+        std::shared_ptr< Event_Queue > queue(new Event_Queue(1024));
+
+        suite.add
+        (
+            "Event_Queue::push+poll/1 thread",
+            [queue] (unsigned iterations)
+            {
+                Event event(ID(benchmark));
+
+                for (unsigned iteration = 0; iteration < iterations; ++iteration)
+                {
+                    queue->push (event);
+                    queue->poll (event);
+                }
+
+                keep (event);
+            }
+        );
+
+        for (unsigned producers : { 1u, 2u, 4u })
+        {
+            suite.add
+            (
+                "Event_Queue::push+poll/" + std::to_string (producers) + " producers",
+                [queue, producers] (unsigned iterations)
+                {
+                    push_and_poll (*queue, producers, iterations);
+                }
+            );
+        }
+    }
+
+}}
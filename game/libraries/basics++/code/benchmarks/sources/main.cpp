@@ -0,0 +1,72 @@
+/*
+ * BENCHMARKS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <string>
+#include <basics/enable>
+#include <basics/Log>
+#include <basics/Window>
+#include <basics/opengles/Context>
+#include <basics/opengles/OpenGL_ES2>
+#include "Benchmark_Suite.hpp"
+
+using namespace basics;
+using namespace basics::benchmarks;
+
+/**
+ * Uso: basics-benchmarks [archivo.json [filtro]]
+ *
+ * Ejecuta los micro-benchmarks cuyo nombre contiene el filtro y guarda los resultados en el
+ * archivo JSON indicado (benchmarks.json por defecto). Los assets se buscan en la misma carpeta
+ * que usa el juego, que se puede cambiar con la variable de entorno BASICS_ASSETS_PATH.
+ */
+int main (int argc, char * argv[])
+{
+    std::string output = argc > 1 ? argv[1] : "benchmarks.json";
+    std::string filter = argc > 2 ? argv[2] : "";
+
+    // Los benchmarks de assets necesitan un contexto gráfico para crear las texturas:
+
+    enable< OpenGL_ES2 > ();
+
+    Window::create_window (ID(benchmarks));
+
+    Window::Accessor window = Window::get_window (ID(benchmarks)).lock ();
+
+    if (!window || !opengles::Context::create (window, nullptr))
+    {
+        log.e ("ERROR: failed to create the graphics context.");
+
+        return 1;
+    }
+
+    Benchmark_Suite suite;
+    unsigned        count;
+
+    {
+        Graphics_Context::Accessor context = window->lock_graphics_context ();
+
+        add_asset_benchmarks (suite, context);
+        add_event_benchmarks (suite);
+        add_math_benchmarks  (suite);
+
+        count = suite.run (filter);
+    }
+
+    if (!suite.write_json (output))
+    {
+        log.e (("ERROR: failed to write " + output).c_str ());
+
+        return 1;
+    }
+
+    log.i ((std::to_string (count) + " benchmarks written to " + output).c_str ());
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+/*
+ * MATH BENCHMARKS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <basics/Matrix>
+#include <basics/Transformation>
+#include "Benchmark_Suite.hpp"
+
+namespace basics { namespace benchmarks
+{
+
+    void add_math_benchmarks (Benchmark_Suite & suite)
+    {
+        // Se multiplica por una rotación para que los valores no crezcan sin límite y el resultado
+        // de cada iteración depende de la anterior para que no se pueda sacar del bucle:
+
+        suite.add
+        (
+            "Matrix<3,3,float>::operator*",
+            [] (unsigned iterations)
+            {
+                Matrix33f product  = Matrix33f::identity;
+                Matrix33f rotation = rotate_then_translate_2d (0.01f, Vector2f{ 1.f, 2.f }).matrix;
+
+                for (unsigned iteration = 0; iteration < iterations; ++iteration)
+                {
+                    product = product * rotation;
+
+                    keep (product);
+                }
+            }
+        );
+
+        // Composición de la transformación típica de un sprite (traslación, rotación y escalado)
+        // con la de la cámara:
+
+        suite.add
+        (
+            "Transformation2f composition",
+            [] (unsigned iterations)
+            {
+                Transformation2f camera = scale_then_translate_2d (0.5f, Vector2f{ -360.f, -640.f });
+                Transformation2f result;
+
+                for (unsigned iteration = 0; iteration < iterations; ++iteration)
+                {
+                    float offset = float(iteration & 255);
+
+                    result = camera
+                           * rotate_then_translate_2d (offset * 0.01f, Vector2f{ offset, offset })
+                           * scale_then_translate_2d  (2.f, Vector2f{ 0.f, 0.f });
+
+                    keep (result);
+                }
+            }
+        );
+    }
+
+}}
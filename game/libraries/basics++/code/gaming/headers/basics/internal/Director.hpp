@@ -14,10 +14,20 @@
 #define BASICS_DIRECTOR_HEADER
 
     #include <memory>
+    #include <utility>
+    #include <vector>
+    #include <basics/Allocation_Tracker>
+    #include <basics/Asset_Cache>
+    #include <basics/Asset_Loader>
     #include <basics/declarations>
     #include <basics/Event_Queue>
+    #include <basics/Event_Signal>
+    #include <basics/Frame_Pacer>
     #include <basics/Graphics_Context>
     #include <basics/Graphics_Resource_Cache>
+    #include <basics/Render_Thread>
+    #include <basics/Session_Recorder>
+    #include <basics/Session_Replayer>
     #include <basics/Window>
 
     namespace basics
@@ -28,6 +38,32 @@
         public:
 
             typedef bool (* Graphics_Context_Factory) (Window::Accessor & window, Graphics_Resource_Cache * cache);
+            typedef std::vector< Event > Event_List;
+
+            /**
+             * Fases de cada fotograma cuyo tiempo se mide por separado.
+             */
+            enum Phase
+            {
+                POLL,                           ///< Extracción de eventos de la aplicación, la ventana y la entrada.
+                HANDLE,                         ///< Entrega de los eventos de entrada a la escena.
+                UPDATE,                         ///< Actualización de la escena.
+                RENDER,                         ///< Dibujado o registro del fotograma.
+                PRESENT,                        ///< Envío del fotograma a la pantalla o al hilo de render.
+                PHASE_COUNT
+            };
+
+            /**
+             * Evento de entrada que se entrega en un fotograma concreto de una ejecución sin ventana
+             * ni usuario. Las coordenadas de los toques se indican en píxeles de la ventana.
+             */
+            struct Scripted_Event
+            {
+                unsigned frame;                 ///< Fotograma en el que se entrega (el primero es el 0).
+                Event    event;
+            };
+
+            typedef std::vector< Scripted_Event > Event_Script;
 
         public:
 
@@ -62,14 +98,59 @@
             std::shared_ptr< Scene > current_scene;
             std::shared_ptr< Scene >  target_scene;
 
-            Event_Queue event_queue;
+            Event_Queue  event_queue;           ///< Descarta los eventos que llegan con la cola llena.
+            Event_List   input_events;          ///< Eventos de entrada extraídos en el fotograma en curso.
+            Event_List   recorded_events;       ///< Copia sin adaptar de input_events mientras se graba.
+            Event_Signal event_signal;          ///< Se activa al llegar eventos de la aplicación o de la ventana.
+            Frame_Pacer  frame_pacer;
 
             float surface_width;
             float surface_height;
 
+            float time_accumulator;             ///< Tiempo pendiente de simular con paso fijo.
+
+            struct
+            {
+                bool         enabled;
+                unsigned     frame_count;           ///< Fotogramas que se ejecutan antes de terminar.
+                float        frame_time;            ///< Tiempo simulado que dura cada fotograma.
+                Event_Script script;
+                size_t       next_event;            ///< Siguiente evento del guion por entregar.
+                unsigned     frame;
+                Session_Replayer * replayer;        ///< Si no es nullptr, sustituye al guion y a frame_time.
+            }
+            headless;
+
+            Session_Recorder * session_recorder;
+
+            uint32_t random_seed;                   ///< Semilla de la que se derivan las de las escenas.
+            uint32_t derived_seeds;                 ///< Número de semillas derivadas hasta el momento.
+
+            double   phase_times[PHASE_COUNT];      ///< Segundos acumulados en cada fase.
+            unsigned measured_frames;
+
+            // Memoria reservada en cada fase mientras Allocation_Tracker está activado:
+
+            Allocation_Tracker::Counters phase_allocations[PHASE_COUNT];
+            uint64_t                     max_frame_allocations;
+            unsigned                     allocating_frames;      ///< Fotogramas que reservaron memoria.
+            unsigned                     last_allocating_frame;  ///< Número (desde 1) del último de ellos.
+
+            // Hitos de Startup_Timeline: cada escena marca su inicialización y su primer fotograma:
+
+            unsigned                 initialized_scenes;
+            bool                     first_frame_pending;
+
             Graphics_Context_Factory graphics_context_factory;
             Graphics_Resource_Cache  graphics_resource_cache;
 
+            bool                     threaded_rendering;
+            Render_Thread            render_thread;
+
+            Asset_Cache              asset_cache;
+            Asset_Loader             asset_loader;          ///< Busca y guarda los assets en asset_cache.
+            float                    upload_budget;         ///< Segundos por fotograma para subir texturas.
+
         private:
 
             Director();
@@ -81,8 +162,163 @@
                 graphics_context_factory = factory;
             }
 
+            /**
+             * Activa o desactiva el modo de dos hilos. En ese modo, las escenas que lo admiten (ver
+             * Scene::is_recordable()) registran cada fotograma tras actualizarse y un hilo de render
+             * lo envía a la GPU y lo presenta mientras se simula el siguiente.
+             */
+            void set_threaded_rendering (bool enabled)
+            {
+                threaded_rendering = enabled;
+            }
+
+            /**
+             * Retorna el cargador con el que las escenas pueden cargar assets sin detener los
+             * fotogramas. El director sube sus texturas en el hilo que tiene el contexto gráfico
+             * antes de dibujar cada fotograma. En el modo sin usuario espera a que terminen todas
+             * las peticiones de cada fotograma para que la ejecución sea reproducible.
+             */
+            Asset_Loader & get_asset_loader ()
+            {
+                return asset_loader;
+            }
+
+            /**
+             * Retorna la caché de assets compartida por todas las escenas, en la que el cargador
+             * busca y guarda lo que carga. Las escenas que cargan assets sin el cargador la pueden
+             * usar directamente para no volver a cargar lo que ya está en la GPU.
+             */
+            Asset_Cache & get_asset_cache ()
+            {
+                return asset_cache;
+            }
+
+            /**
+             * Establece los segundos de cada fotograma que se pueden dedicar a subir texturas del
+             * cargador (siempre se sube al menos una si hay alguna lista).
+             */
+            void set_upload_budget (float seconds)
+            {
+                upload_budget = seconds;
+            }
+
+            /**
+             * Bloquea el contexto gráfico. Si el hilo de render está en marcha, primero lo detiene
+             * para que el contexto vuelva a estar activo en el hilo del director (se pone en marcha
+             * de nuevo en el siguiente fotograma). Solo se debe llamar desde el hilo del director.
+             */
             Graphics_Context::Accessor lock_graphics_context ();
 
+            /**
+             * Hace que la siguiente ejecución no dependa de una ventana visible ni de un usuario:
+             * la escena se considera activa desde el principio, cada fotograma simula el mismo
+             * tiempo sin esperar al reloj y la entrada procede únicamente del guion de eventos.
+             * Tras el número de fotogramas indicado, el director termina y escribe en el log el
+             * tiempo empleado en cada fase. Sirve para medir el coste de las escenas de forma
+             * reproducible.
+             * Si existe una ventana (por ejemplo, la ventana fuera de pantalla en Linux), se sigue
+             * dibujando en ella. Si no, solo se actualiza la escena.
+             */
+            void enable_headless_mode (unsigned frame_count, float frame_time = 1.f / 60.f, const Event_Script & script = Event_Script());
+
+            /**
+             * Igual que la versión anterior, pero los eventos y el tiempo de cada fotograma se toman
+             * de una sesión grabada, que se repite completa con la misma semilla aleatoria. Al
+             * terminar se indica en el log si el estado de la escena difirió del grabado.
+             * El replayer debe existir hasta que termine la ejecución.
+             */
+            void enable_headless_mode (Session_Replayer & replayer);
+
+            void disable_headless_mode ()
+            {
+                headless.enabled  = false;
+                headless.replayer = nullptr;
+            }
+
+            bool is_headless () const
+            {
+                return headless.enabled;
+            }
+
+            /**
+             * Retorna los segundos empleados en la fase indicada durante la última ejecución.
+             */
+            double get_phase_time (Phase phase) const
+            {
+                return phase_times[phase];
+            }
+
+            /**
+             * Retorna las reservas de memoria que el hilo del director hizo en la fase indicada
+             * durante la última ejecución mientras Allocation_Tracker estaba activado.
+             */
+            const Allocation_Tracker::Counters & get_phase_allocations (Phase phase) const
+            {
+                return phase_allocations[phase];
+            }
+
+            /**
+             * Retorna el mayor número de reservas de memoria que se hicieron en un fotograma.
+             */
+            uint64_t get_max_frame_allocations () const
+            {
+                return max_frame_allocations;
+            }
+
+            /**
+             * Retorna cuántos fotogramas reservaron memoria. Las medias por fotograma de las fases
+             * incluyen los primeros, en los que se crean el contexto gráfico, los shaders y el
+             * canvas y se cargan los assets, por lo que este número (junto con el del último de
+             * esos fotogramas) indica si además se reserva memoria una vez que la escena está en
+             * marcha.
+             */
+            unsigned get_allocating_frames () const
+            {
+                return allocating_frames;
+            }
+
+            unsigned get_last_allocating_frame () const
+            {
+                return last_allocating_frame;
+            }
+
+            /**
+             * Retorna el número de fotogramas en los que se simuló la escena durante la última
+             * ejecución.
+             */
+            unsigned get_measured_frames () const
+            {
+                return measured_frames;
+            }
+
+            /**
+             * Hace que cada fotograma se grabe (ver Session_Recorder) mientras el recorder esté
+             * abierto. Se debe abrir con la semilla que retorna get_random_seed(). nullptr deja de
+             * grabar.
+             */
+            void set_session_recorder (Session_Recorder * recorder)
+            {
+                session_recorder = recorder;
+            }
+
+            uint32_t get_random_seed () const
+            {
+                return random_seed;
+            }
+
+            void set_random_seed (uint32_t seed)
+            {
+                random_seed   = seed;
+                derived_seeds = 0;
+            }
+
+            /**
+             * Retorna una semilla para los números aleatorios de una escena (por ejemplo, para
+             * std::srand()). Se deriva de la semilla del director, de modo que cada llamada da una
+             * semilla distinta pero la secuencia se repite al repetir una sesión grabada.
+             */
+            uint32_t make_random_seed ();
+
         public:
 
             void run_scene (const std::shared_ptr< Scene > & new_scene);
@@ -97,12 +333,25 @@
                 event_queue.push (event);
             }
 
+            void handle (Event && event)
+            {
+                event_queue.push (std::move (event));
+            }
+
         private:
 
             void run_kernel ();
             bool check_scene ();
+            void update_scene (float time);
             void reset_viewport (Window::Accessor & window);
 
+            void reset_phase_times ();
+            void log_phase_times   ();
+            void mark_first_frame  ();
+
+            bool start_render_thread (Window::Accessor & window, bool reset_canvas);
+            void stop_render_thread  ();
+
         };
 
         extern Director & director;
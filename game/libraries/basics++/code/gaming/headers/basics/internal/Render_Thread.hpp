@@ -0,0 +1,146 @@
+/*
+ * RENDER THREAD
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_RENDER_THREAD_HEADER
+#define BASICS_RENDER_THREAD_HEADER
+
+    #include <condition_variable>
+    #include <mutex>
+    #include <thread>
+    #include <basics/Asset_Loader>
+    #include <basics/Display_List>
+    #include <basics/Non_Copyable>
+    #include <basics/Triple_Buffer>
+    #include <basics/Window>
+
+    namespace basics
+    {
+
+        /**
+         * Hilo que se encarga de enviar los fotogramas a la GPU y de presentarlos.
+         *
+         * Otro hilo registra cada fotograma en una Display_List y lo publica. El hilo de render
+         * reproduce siempre el último fotograma publicado sobre el canvas ID(canvas) del contexto
+         * gráfico de la ventana, de modo que quien publica nunca espera a que termine la
+         * presentación de los fotogramas anteriores.
+         *
+         * Mientras el hilo está en marcha el contexto gráfico está activo en él, por lo que ningún
+         * otro hilo debe usarlo. Para usarlo desde otro hilo hay que detener antes el hilo de
+         * render y después activar el contexto con make_current(). Por eso también es el hilo de
+         * render el que sube las texturas que tenga pendientes el Asset_Loader indicado.
+         */
+        class Render_Thread : Non_Copyable
+        {
+        private:
+
+            Window::Handle                window;
+            std::thread                   thread;
+            std::mutex                    mutex;
+            std::condition_variable       frame_published;
+            std::condition_variable       frame_presented;
+            bool                          exit;
+            unsigned                      published_count;  ///< Fotogramas publicados.
+            unsigned                      presented_count;  ///< Publicados hasta el último presentado.
+
+            Triple_Buffer< Display_List > frames;
+
+            Asset_Loader                * asset_loader;
+            float                         upload_budget;
+
+        public:
+
+            Render_Thread()
+            :
+                exit           (false),
+                published_count(0),
+                presented_count(0),
+                asset_loader   (nullptr),
+                upload_budget  (0.f)
+            {
+            }
+
+           ~Render_Thread()
+            {
+                stop ();
+            }
+
+        public:
+
+            bool is_running () const
+            {
+                return thread.joinable ();
+            }
+
+            /**
+             * Indica si el hilo que llama es el hilo de render.
+             */
+            bool is_current_thread () const
+            {
+                return std::this_thread::get_id () == thread.get_id ();
+            }
+
+        public:
+
+            /**
+             * Indica el cargador cuyas texturas se deben subir antes de cada fotograma y los
+             * segundos que se pueden dedicar a ello. Solo se debe llamar con el hilo detenido.
+             */
+            void set_asset_loader (Asset_Loader * loader, float budget)
+            {
+                asset_loader  = loader;
+                upload_budget = budget;
+            }
+
+            /**
+             * Pone en marcha el hilo. El contexto gráfico de la ventana no debe estar activo en
+             * ningún otro hilo. Los fotogramas publicados antes se descartan.
+             */
+            void start (const Window::Handle & window);
+
+            /**
+             * Espera a que el hilo termine de presentar el fotograma en curso y lo detiene. Al
+             * terminar, el contexto gráfico ya no está activo en ningún hilo.
+             */
+            void stop ();
+
+        public:
+
+            /**
+             * Retorna la lista en la que se debe registrar el siguiente fotograma. Puede contener
+             * un fotograma anterior, por lo que se debe vaciar con discard() antes de usarla.
+             */
+            Display_List & get_back_frame ()
+            {
+                return frames.get_back ();
+            }
+
+            /**
+             * Publica el fotograma registrado en la lista que retornó get_back_frame().
+             */
+            void publish_frame ();
+
+            /**
+             * Espera a que el hilo de render presente el último fotograma publicado. Normalmente
+             * no se debe esperar, pero permite que una ejecución sin usuario, que nunca se detiene
+             * entre fotogramas, dibuje y mida todos los fotogramas.
+             */
+            void wait_for_presentation ();
+
+        private:
+
+            void run          ();
+            void render_frame ();
+            void release      ();
+
+        };
+
+    }
+
+#endif
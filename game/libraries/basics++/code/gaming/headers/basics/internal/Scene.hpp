@@ -13,24 +13,35 @@
 #ifndef BASICS_SCENE_HEADER
 #define BASICS_SCENE_HEADER
 
+    #include <basics/Display_List>
     #include <basics/Event>
     #include <basics/Graphics_Context>
     #include <basics/Size>
+    #include <basics/types>
 
     namespace basics
     {
 
         class Scene
         {
+
+            friend class Director;
+
         private:
 
-            float frame_duration;
+            float    frame_duration;
+            float    time_step;
+            unsigned max_steps_per_frame;
+            float    interpolation;
 
         public:
 
             Scene()
             {
-                frame_duration = -1.f;
+                frame_duration      = -1.f;
+                time_step           = -1.f;
+                max_steps_per_frame =  0;
+                interpolation       =  1.f;
             }
 
             virtual ~Scene() = default;
@@ -46,8 +57,31 @@
             virtual void update     (float time) { }
             virtual void render     (Graphics_Context::Accessor & context) { }
 
+            /**
+             * Las escenas que retornan true pueden dibujarse desde un hilo de render cuando el
+             * director lo tiene activado (ver Director::set_threaded_rendering()). En ese caso el
+             * director no llama a render(), sino a record().
+             */
+            virtual bool is_recordable () const { return false; }
+
+            /**
+             * Registra en la lista lo mismo que render() dibujaría en el canvas ID(canvas). La lista
+             * se reproduce después en el hilo de render, pero este método se llama en el mismo hilo
+             * que update(), por lo que puede leer el estado de la escena sin sincronización.
+             * También se debe llamar a set_size() en la lista con el tamaño que tendría el canvas.
+             */
+            virtual void record     (Display_List & display_list) { }
+
             virtual Size2u get_view_size () = 0;
 
+            /**
+             * Retorna una suma de comprobación del estado de la simulación (por ejemplo, con
+             * basics::fnv32()). El director la guarda al grabar una sesión y la compara al
+             * repetirla para detectar cualquier cambio de comportamiento. Debe depender solo de
+             * datos que no varíen de una ejecución a otra (no de punteros, por ejemplo).
+             */
+            virtual uint32_t get_checksum () { return 0; }
+
         public:
 
             bool set_frame_rate (int fps)
@@ -60,6 +94,51 @@
                 return frame_duration;
             }
 
+            /**
+             * Hace que el director llame a update() siempre con el mismo incremento de tiempo
+             * (1 / ups), tantas veces por fotograma como pasos completos hayan transcurrido, de
+             * modo que la simulación no dependa de la frecuencia de los fotogramas.
+             * @param ups Número de actualizaciones por segundo. Si es 0, update() vuelve a recibir el
+             *     tiempo transcurrido desde el fotograma anterior.
+             * @param max_steps Máximo de actualizaciones por fotograma. El tiempo que no cabe en ellas
+             *     se descarta para que un fotograma lento no obligue a simular aún más en el siguiente.
+             */
+            bool set_update_rate (int ups, unsigned max_steps = 5)
+            {
+                if (ups >= 0 && max_steps > 0)
+                {
+                    time_step           = ups > 0 ? 1.f / float(ups) : -1.f;
+                    max_steps_per_frame = max_steps;
+
+                    return true;
+                }
+
+                return false;
+            }
+
+            /**
+             * Retorna el incremento de tiempo fijo o un valor negativo si no se ha establecido.
+             */
+            float get_time_step () const
+            {
+                return time_step;
+            }
+
+            unsigned get_max_steps_per_frame () const
+            {
+                return max_steps_per_frame;
+            }
+
+            /**
+             * Con un incremento de tiempo fijo, retorna la fracción del siguiente paso que ya ha
+             * transcurrido al dibujar (entre 0 y 1). render() y record() pueden usarla para
+             * interpolar entre el estado anterior y el actual. Sin incremento fijo siempre vale 1.
+             */
+            float get_interpolation () const
+            {
+                return interpolation;
+            }
+
         };
 
     }
@@ -0,0 +1,121 @@
+/*
+ * SESSION RECORDER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_SESSION_RECORDER_HEADER
+#define BASICS_SESSION_RECORDER_HEADER
+
+    #include <cstdio>
+    #include <string>
+    #include <vector>
+    #include <basics/Event>
+    #include <basics/Non_Copyable>
+    #include <basics/Timer>
+    #include <basics/types>
+
+    namespace basics
+    {
+
+        /**
+         * Guarda en un archivo binario todo lo que hace falta para repetir una sesión de juego
+         * exactamente igual (ver Session_Replayer): la semilla de los números aleatorios y, por
+         * cada fotograma, el tiempo simulado, los eventos de entrada recibidos y una suma de
+         * comprobación del estado de la escena.
+         *
+         * Formato (enteros y floats en el orden de bytes de la máquina):
+         *
+         *     cabecera:   "BSES" · versión u32 · semilla u32
+         *     fotograma:  índice u32 · instante f32 · incremento f32 · suma u32 · eventos u16
+         *     evento:     id u32 · prioridad i32 · propiedades u8
+         *     propiedad:  id u32 · tipo u8 (0 vacío, 1 bool, 2 float) · valor (0, 1 o 4 bytes)
+         */
+        class Session_Recorder : Non_Copyable
+        {
+        public:
+
+            static constexpr uint32_t magic   = 0x53455342u;        ///< "BSES" en little endian.
+            static constexpr uint32_t version = 1;
+
+            enum Property_Type
+            {
+                VOID_PROPERTY  = 0,
+                BOOL_PROPERTY  = 1,
+                FLOAT_PROPERTY = 2
+            };
+
+        private:
+
+            std::FILE * file;
+            Timer       timer;
+            unsigned    recorded_frames;
+            bool        failed;
+
+        public:
+
+            Session_Recorder() : file(nullptr), recorded_frames(0), failed(false)
+            {
+            }
+
+           ~Session_Recorder()
+            {
+                close ();
+            }
+
+        public:
+
+            /**
+             * Crea el archivo (o lo vacía si ya existía) y escribe la cabecera.
+             * @param seed Semilla de la que la sesión obtiene sus números aleatorios.
+             */
+            bool open (const std::string & path, uint32_t seed);
+
+            void close ();
+
+            bool is_open () const
+            {
+                return file != nullptr;
+            }
+
+            /**
+             * Retorna false si alguna escritura ha fallado.
+             */
+            bool good () const
+            {
+                return !failed;
+            }
+
+            unsigned get_recorded_frames () const
+            {
+                return recorded_frames;
+            }
+
+        public:
+
+            /**
+             * Añade un fotograma. Las propiedades de los eventos de tipos que no se pueden guardar
+             * se graban como vacías.
+             * @param delta Tiempo que se simuló en el fotograma.
+             * @param events Eventos de entrada tal como llegaron al director.
+             * @param checksum Suma de comprobación del estado de la escena tras actualizarla.
+             */
+            void record_frame (unsigned frame, float delta, const std::vector< Event > & events, uint32_t checksum);
+
+        private:
+
+            template< typename TYPE >
+            void write (const TYPE & value)
+            {
+                if (!failed && std::fwrite (&value, sizeof(TYPE), 1, file) != 1) failed = true;
+            }
+
+        };
+
+    }
+
+#endif
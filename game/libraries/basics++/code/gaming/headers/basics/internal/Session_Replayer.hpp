@@ -0,0 +1,126 @@
+/*
+ * SESSION REPLAYER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_SESSION_REPLAYER_HEADER
+#define BASICS_SESSION_REPLAYER_HEADER
+
+    #include <string>
+    #include <vector>
+    #include <basics/Event>
+    #include <basics/Non_Copyable>
+    #include <basics/types>
+
+    namespace basics
+    {
+
+        /**
+         * Repite una sesión guardada por Session_Recorder. El director le pide en cada fotograma
+         * los eventos de entrada y el tiempo que debe simular (ver Director::enable_headless_mode())
+         * y le entrega la suma de comprobación del estado de la escena para compararla con la que
+         * se grabó. Si alguna no coincide, la escena no se ha comportado igual que en la sesión
+         * original.
+         */
+        class Session_Replayer : Non_Copyable
+        {
+        private:
+
+            struct Frame
+            {
+                float    timestamp;
+                float    delta;
+                uint32_t checksum;
+                size_t   first_event;
+                size_t   event_count;
+            };
+
+            typedef std::vector< Frame > Frame_List;
+            typedef std::vector< Event > Event_List;
+
+        private:
+
+            Frame_List frames;
+            Event_List events;
+            uint32_t   seed;
+            size_t     next_frame;
+            unsigned   mismatch_count;
+            unsigned   first_mismatch;              ///< Índice del primer fotograma que no coincidió.
+
+        public:
+
+            Session_Replayer()
+            {
+                seed = 0;
+
+                rewind ();
+            }
+
+        public:
+
+            /**
+             * Carga la sesión completa del archivo indicado y la prepara para repetirla desde el
+             * principio.
+             */
+            bool load (const std::string & path);
+
+            /**
+             * Vuelve al primer fotograma y olvida las comprobaciones realizadas.
+             */
+            void rewind ()
+            {
+                next_frame     = 0;
+                mismatch_count = 0;
+                first_mismatch = 0;
+            }
+
+        public:
+
+            uint32_t get_seed () const
+            {
+                return seed;
+            }
+
+            unsigned get_frame_count () const
+            {
+                return unsigned(frames.size ());
+            }
+
+            bool at_end () const
+            {
+                return next_frame >= frames.size ();
+            }
+
+            /**
+             * Añade a la lista los eventos del siguiente fotograma y pasa a él.
+             * @param delta Recibe el tiempo que se simuló en el fotograma.
+             * @return false si ya no quedan fotogramas.
+             */
+            bool play_frame (std::vector< Event > & frame_events, float & delta);
+
+            /**
+             * Compara la suma de comprobación del estado de la escena en el último fotograma
+             * repetido con la que se grabó.
+             */
+            bool verify (uint32_t checksum);
+
+            unsigned get_mismatch_count () const
+            {
+                return mismatch_count;
+            }
+
+            unsigned get_first_mismatch () const
+            {
+                return first_mismatch;
+            }
+
+        };
+
+    }
+
+#endif
@@ -10,10 +10,15 @@
  * C1801072305
  */
 
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
 #include <basics/Application>
 #include <basics/Director>
 #include <basics/Log>
+#include <basics/Profiler>
 #include <basics/Scene>
+#include <basics/Startup_Timeline>
 #include <basics/Timer>
 #include <basics/Window>
 #include <basics/opengles/Canvas_ES2>
@@ -24,12 +29,90 @@ namespace basics
 
     Director & director = Director::get_instance ();
 
+    namespace
+    {
+
+        // Also used as the names of the profiling zones of each phase:
+
+        const char * const phase_names[Director::PHASE_COUNT] =
+        {
+            "Director::poll", "Director::handle", "Director::update", "Director::render", "Director::present"
+        };
+
+    }
+
     // ---------------------------------------------------------------------------------------------
 
     Director::Director()
     {
         kernel.running           = false;
         graphics_context_factory = opengles::Context::create;
+        threaded_rendering       = false;
+        time_accumulator         = 0.f;
+        surface_width            = 1.f;
+        surface_height           = 1.f;
+        headless.enabled         = false;
+        headless.replayer        = nullptr;
+        session_recorder         = nullptr;
+        initialized_scenes       = 0;
+        first_frame_pending      = false;
+        upload_budget            = 0.004f;
+
+        asset_loader.set_cache (&asset_cache);
+
+        // Only the kernel thread takes events from the queue, and it does not while the scene is
+        // inactive, so a producer must never wait for room in it:
+
+        event_queue.set_overflow_policy (Event_Queue::DISCARD);
+
+        set_random_seed (uint32_t(std::time (nullptr)));
+
+        reset_phase_times ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::enable_headless_mode (unsigned frame_count, float frame_time, const Event_Script & script)
+    {
+        headless.enabled     = true;
+        headless.frame_count = frame_count;
+        headless.frame_time  = frame_time;
+        headless.script      = script;
+        headless.replayer    = nullptr;
+
+        // The events are delivered in frame order, keeping the given order within each frame:
+
+        std::stable_sort
+        (
+            headless.script.begin (),
+            headless.script.end   (),
+            [] (const Scripted_Event & a, const Scripted_Event & b) { return a.frame < b.frame; }
+        );
+    }
+
+    void Director::enable_headless_mode (Session_Replayer & replayer)
+    {
+        enable_headless_mode (replayer.get_frame_count ());
+
+        headless.replayer = &replayer;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    uint32_t Director::make_random_seed ()
+    {
+        // The seeds are spread with the finalizer of MurmurHash3 so that consecutive ones are not
+        // correlated:
+
+        uint32_t seed = random_seed + 0x9e3779b9u * ++derived_seeds;
+
+        seed ^= seed >> 16;
+        seed *= 0x85ebca6bu;
+        seed ^= seed >> 13;
+        seed *= 0xc2b2ae35u;
+        seed ^= seed >> 16;
+
+        return seed;
     }
 
     // ---------------------------------------------------------------------------------------------
@@ -40,6 +123,11 @@ namespace basics
 
         if (window)
         {
+            if (render_thread.is_running () && !render_thread.is_current_thread ())
+            {
+                stop_render_thread ();
+            }
+
             return window->lock_graphics_context ();
         }
 
@@ -79,21 +167,55 @@ namespace basics
             Window::create_window (default_window_id);
         }
 
-        float time = 1.f / 60.f;
+        if (headless.enabled)
+        {
+            // Nobody is going to resume the application or focus the window, and without a
+            // window there is no graphics context to wait for:
+
+            state.active   = true;
+            state.focused  = true;
+            state.graphics = !Window::can_be_instantiated;
+
+            headless.next_event = 0;
+            headless.frame      = 0;
+
+            if (headless.replayer)
+            {
+                headless.replayer->rewind ();
+
+                set_random_seed (headless.replayer->get_seed ());
+            }
+        }
+
+        reset_phase_times ();
+
+        application.set_event_signal (&event_signal);
+
+        float frame_duration = 1.f / 60.f;
+        float time           = frame_duration;
         Event event;
 
         do
         {
             Timer timer;
             bool  reset_canvas = false;
+            bool  frame_done   = false;
 
             // Check if the current scene must be replaced:
 
             if (target_scene)
             {
-                // If the current scene must be replaced, then it is first finalized:
+                // If the current scene must be replaced, then it is first finalized once the
+                // render thread, which could be using its resources, is stopped:
 
-                if (current_scene) current_scene->finalize ();
+                stop_render_thread ();
+
+                if (current_scene)
+                {
+                    BASICS_PROFILE_ZONE ("Scene::finalize");
+
+                    current_scene->finalize ();
+                }
 
                 // And then possibly destroyed:
 
@@ -101,7 +223,15 @@ namespace basics
 
                 // The new scene is then initialized:
 
-                if (target_scene->initialize ())
+                bool initialized;
+
+                {
+                    BASICS_PROFILE_ZONE ("Scene::initialize");
+
+                    initialized = target_scene->initialize ();
+                }
+
+                if (initialized)
                 {
                     // If the initialization succeeded, then it is made current:
 
@@ -115,16 +245,53 @@ namespace basics
 
                     if (state) current_scene->resume (); else current_scene->suspend ();
 
-                    // Initialize the frame time limit:
+                    // Initialize the frame time limit. The frames are only paced when the scene
+                    // sets a frame rate:
+
+                    frame_duration = current_scene->get_frame_duration ();
+
+                    frame_pacer.set_frame_duration (frame_duration);
+
+                    if (frame_duration <= 0.f) frame_duration = 1.f / 60.f;
 
-                    time = current_scene->get_frame_duration ();
+                    time = frame_duration;
 
-                    if (time <= 0.f) time = 1.f / 60.f;
+                    time_accumulator = 0.f;
 
                     reset_canvas = true;
+
+                    Startup_Timeline::mark ("scene " + std::to_string (++initialized_scenes) + " initialized");
+
+                    first_frame_pending = true;
                 }
             }
 
+            uint64_t                     phase_start    = Profiler::now ();
+            Allocation_Tracker::Counters phase_counters = Allocation_Tracker::get_thread_counters ();
+            Allocation_Tracker::Counters frame_counters = phase_counters;
+
+            // Adds the time elapsed and the memory allocated since the previous phase ended to the
+            // given phase:
+
+            auto end_phase = [this, &phase_start, &phase_counters] (Phase phase)
+            {
+                uint64_t                     phase_end = Profiler::now ();
+                Allocation_Tracker::Counters counters  = Allocation_Tracker::get_thread_counters ();
+                uint64_t                     allocated = counters.allocations - phase_counters.allocations;
+                uint64_t                     bytes     = counters.bytes       - phase_counters.bytes;
+
+                phase_times[phase] += double(phase_end - phase_start) * 1e-9;
+
+                phase_allocations[phase].allocations   += allocated;
+                phase_allocations[phase].deallocations += counters.deallocations - phase_counters.deallocations;
+                phase_allocations[phase].bytes         += bytes;
+
+                if (Profiler::is_enabled ()) Profiler::record (phase_names[phase], phase_start, phase_end, allocated, bytes);
+
+                phase_start    = phase_end;
+                phase_counters = counters;
+            };
+
             bool previously_active = state;
 
             while (application.poll (event))
@@ -145,10 +312,14 @@ namespace basics
 
                     case Application::Event_Id::WINDOW_CREATED:
                     {
+                        stop_render_thread ();
+
                         window_handle = Window::get_window (default_window_id);
 
                         Window::Accessor window = window_handle.lock ();
 
+                        window->set_event_signal (&event_signal);
+
                         if (graphics_context_factory)
                         {
                             if (!window->has_graphics_context ())
@@ -171,6 +342,8 @@ namespace basics
 
                     case Application::Event_Id::WINDOW_DESTROYED:
                     {
+                        stop_render_thread ();
+
                         state.graphics = false;
                         break;
                     }
@@ -209,45 +382,157 @@ namespace basics
                             case Window::VIEWPORT_RESIZED:      reset_viewport (window); break;
                         }
                     }
+                }
+
+                // A headless run goes on without a window, in which case the scene is only
+                // updated:
+
+                if (current_scene && (window || headless.enabled))
+                {
+                    bool  currently_active = state;
 
-                    if (current_scene)
+                    if (!previously_active &&  currently_active) current_scene->resume  (); else
+                    if ( previously_active && !currently_active) current_scene->suspend ();
+
+                    if (currently_active)
                     {
-                        bool  currently_active = state;
+                        Size2u scene_view_size = current_scene->get_view_size ();
+
+                        float  h_ratio = float(scene_view_size.width ) / surface_width;
+                        float  v_ratio = float(scene_view_size.height) / surface_height;
 
-                        if (!previously_active &&  currently_active) current_scene->resume  (); else
-                        if ( previously_active && !currently_active) current_scene->suspend ();
+                        // In a headless run the input comes only from the script or the replayed
+                        // session. It goes straight to the list, as the queue is only drained here
+                        // and could not make room for a burst of events:
 
-                        if (currently_active)
+                        float frame_time = headless.enabled ? headless.frame_time : time;
+
+                        if (headless.enabled)
+                        {
+                            event_queue.clear ();
+
+                            input_events.clear ();
+
+                            if (headless.replayer)
+                            {
+                                headless.replayer->play_frame (input_events, frame_time);
+                            }
+                            else
+                            for ( ; headless.next_event < headless.script.size (); ++headless.next_event)
+                            {
+                                const Scripted_Event & scripted = headless.script[headless.next_event];
+
+                                if (scripted.frame > headless.frame) break;
+
+                                input_events.push_back (scripted.event);
+                            }
+                        }
+                        else
                         {
-                            Size2u scene_view_size = current_scene->get_view_size ();
+                            // The input events are taken all at once so that the input thread
+                            // never waits for the scene to handle them:
+
+                            event_queue.drain (input_events);
+                        }
+
+                        // The events are recorded as they arrived, before being adapted to the
+                        // scene view, so that replaying them goes through the same steps:
+
+                        bool recording = session_recorder && session_recorder->is_open ();
 
-                            float  h_ratio = float(scene_view_size.width ) / surface_width;
-                            float  v_ratio = float(scene_view_size.height) / surface_height;
+                        if (recording) recorded_events = input_events;
 
-                            while (event_queue.poll (event))
+                        end_phase (POLL);
+
+                        for (Event & input_event : input_events)
+                        {
+                            switch (input_event.id)
                             {
-                                switch (event.id)
+                                case ID(touch-started):
+                                case ID(touch-moved):
+                                case ID(touch-ended):
                                 {
-                                    case ID(touch-started):
-                                    case ID(touch-moved):
-                                    case ID(touch-ended):
+                                    if (window)
                                     {
-                                        float x = *event.properties[ID(x)].as< var::Float > ();
-                                        float y = *event.properties[ID(y)].as< var::Float > ();
+                                        float x = *input_event.properties[ID(x)].as< var::Float > ();
+                                        float y = *input_event.properties[ID(y)].as< var::Float > ();
 
-                                        event.properties[ID(x)] = x * h_ratio;
-                                        event.properties[ID(y)] = (surface_height - y) * v_ratio;
-
-                                        break;
+                                        input_event.properties[ID(x)] = x * h_ratio;
+                                        input_event.properties[ID(y)] = (surface_height - y) * v_ratio;
                                     }
-                                }
 
-                                current_scene->handle (event);
+                                    break;
+                                }
                             }
 
-                            current_scene->update (time);
+                            current_scene->handle (input_event);
+                        }
+
+                        end_phase (HANDLE);
+
+                        update_scene (frame_time);
 
-                            Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
+                        // When the run has to be reproducible, the assets requested during this
+                        // frame are available from the next one no matter how long they take:
+
+                        if ((headless.enabled || recording) && asset_loader.get_pending_count () > 0)
+                        {
+                            Graphics_Context::Accessor graphics_context = lock_graphics_context ();
+
+                            if (graphics_context) asset_loader.finish (graphics_context);
+                        }
+
+                        if (recording || headless.replayer)
+                        {
+                            uint32_t checksum = current_scene->get_checksum ();
+
+                            if (recording         ) session_recorder->record_frame (measured_frames, frame_time, recorded_events, checksum);
+                            if (headless.replayer ) headless.replayer->verify (checksum);
+                        }
+
+                        end_phase (UPDATE);
+
+                        if (window && threaded_rendering && current_scene->is_recordable ())
+                        {
+                            // The frame is recorded and handed over to the render thread,
+                            // which presents it while the next one is simulated:
+
+                            if (render_thread.is_running () || start_render_thread (window, reset_canvas))
+                            {
+                                Display_List & frame = render_thread.get_back_frame ();
+
+                                frame.discard ();
+
+                                {
+                                    BASICS_PROFILE_ZONE ("Scene::record");
+
+                                    current_scene->record (frame);
+                                }
+
+                                end_phase (RENDER);
+
+                                render_thread.publish_frame ();
+
+                                // A headless run never waits between frames, so it could get far
+                                // ahead of the render thread (or starve it on a single core). Each
+                                // frame is presented before the next one is simulated instead:
+
+                                if (headless.enabled) render_thread.wait_for_presentation ();
+
+                                end_phase (PRESENT);
+
+                                // With the render thread the frame is marked when it's handed
+                                // over, not when it's actually presented:
+
+                                mark_first_frame ();
+                            }
+                        }
+                        else
+                        {
+                            // lock_graphics_context() stops the render thread if the scene
+                            // cannot be recorded:
+
+                            Graphics_Context::Accessor graphics_context = lock_graphics_context ();
 
                             if (graphics_context)
                             {
@@ -258,19 +543,84 @@ namespace basics
                                     if (canvas) canvas->reset_state ();
                                 }
 
-                                current_scene->render (graphics_context);
+                                asset_loader.upload (graphics_context, upload_budget);
+
+                                {
+                                    BASICS_PROFILE_ZONE ("Scene::render");
+
+                                    current_scene->render (graphics_context);
+                                }
+
+                                end_phase (RENDER);
 
                                 graphics_context->flush_and_display ();
+
+                                end_phase (PRESENT);
+
+                                mark_first_frame ();
                             }
                         }
+
+                        frame_done = true;
                     }
                 }
             }
 
-            time = timer.get_elapsed_seconds ();
+            if (frame_done)
+            {
+                ++measured_frames;
+
+                uint64_t frame_allocations = Allocation_Tracker::get_thread_counters ().allocations - frame_counters.allocations;
+
+                if (frame_allocations > max_frame_allocations) max_frame_allocations = frame_allocations;
+
+                if (frame_allocations > 0)
+                {
+                    allocating_frames++;
+                    last_allocating_frame = measured_frames;
+                }
+
+                if (headless.enabled && ++headless.frame >= headless.frame_count)
+                {
+                    kernel.exit = true;
+                }
+            }
+
+            if (headless.enabled)
+            {
+                // The simulated time does not depend on the clock, so there is nothing to wait for:
+
+                time = headless.frame_time;
+            }
+            else
+            if (!kernel.exit && current_scene && !target_scene && !state)
+            {
+                // While the scene is not active there is nothing to simulate or to render, so the
+                // kernel sleeps until an application or window event arrives:
+
+                event_signal.wait ();
+
+                // The input that arrived while the scene was inactive is stale:
+
+                event_queue.clear ();
+
+                frame_pacer.reset ();
+
+                time = frame_duration;
+            }
+            else
+            {
+                frame_pacer.wait ();
+
+                time = timer.get_elapsed_seconds ();
+            }
         }
         while (!kernel.exit && current_scene);
 
+        application.set_event_signal (nullptr);
+
+        stop_render_thread ();
+
         if (current_scene)
         {
             current_scene->finalize ();
@@ -278,13 +628,186 @@ namespace basics
             current_scene.reset ();
         }
 
+        Asset_Cache::Statistics cache_statistics = asset_cache.get_statistics ();
+
+        // The cached textures are released while the graphics context still exists:
+
+        {
+            Graphics_Context::Accessor graphics_context = lock_graphics_context ();
+
+            asset_cache.clear (graphics_context);
+        }
+
+        if (headless.enabled)
+        {
+            log_phase_times ();
+
+            char cache_line[160];
+
+            std::snprintf
+            (
+                cache_line, sizeof(cache_line), "asset cache: %u hits, %u misses, %u evictions, %u entries using %.1f of %.1f MiB",
+                cache_statistics.hits, cache_statistics.misses, cache_statistics.evictions, cache_statistics.entries,
+                double(cache_statistics.memory) / 1048576.0, double(cache_statistics.budget) / 1048576.0
+            );
+
+            log.i (cache_line);
+
+            if (headless.replayer)
+            {
+                char line[128];
+
+                if (headless.replayer->get_mismatch_count () == 0)
+                {
+                    std::snprintf (line, sizeof(line), "replay: the scene state matched the recording in all frames");
+                }
+                else
+                {
+                    std::snprintf
+                    (
+                        line, sizeof(line), "replay: the scene state differed in %u frames (first: %u)",
+                        headless.replayer->get_mismatch_count (),
+                        headless.replayer->get_first_mismatch ()
+                    );
+                }
+
+                log.i (line);
+            }
+        }
+
         kernel.running = false;
     }
 
     // ---------------------------------------------------------------------------------------------
 
+    void Director::update_scene (float time)
+    {
+        float step = current_scene->get_time_step ();
+
+        if (step > 0.f)
+        {
+            // The elapsed time is consumed in fixed steps. The remainder is carried over to the
+            // next frame and tells how far the rendered frame is between two steps:
+
+            float max_time = step * float(current_scene->get_max_steps_per_frame ());
+
+            time_accumulator += time;
+
+            // If the simulation cannot keep up, the time that exceeds the maximum number of steps
+            // is dropped. Otherwise each slow frame would require even more steps in the next one:
+
+            if (time_accumulator > max_time) time_accumulator = max_time;
+
+            while (time_accumulator >= step && !target_scene)
+            {
+                BASICS_PROFILE_ZONE ("Scene::update");
+
+                current_scene->update (step);
+
+                time_accumulator -= step;
+            }
+
+            current_scene->interpolation = time_accumulator / step;
+        }
+        else
+        {
+            BASICS_PROFILE_ZONE ("Scene::update");
+
+            current_scene->update (time);
+
+            current_scene->interpolation = 1.f;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::mark_first_frame ()
+    {
+        if (first_frame_pending)
+        {
+            Startup_Timeline::mark ("scene " + std::to_string (initialized_scenes) + " first frame presented");
+
+            first_frame_pending = false;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::reset_phase_times ()
+    {
+        std::fill (phase_times, phase_times + PHASE_COUNT, 0.0);
+
+        for (Allocation_Tracker::Counters & counters : phase_allocations)
+        {
+            counters.allocations   = 0;
+            counters.deallocations = 0;
+            counters.bytes         = 0;
+        }
+
+        measured_frames       = 0;
+        max_frame_allocations = 0;
+        allocating_frames     = 0;
+        last_allocating_frame = 0;
+    }
+
+    void Director::log_phase_times ()
+    {
+        char     line[160];
+        double   total        = 0.0;
+        uint64_t total_allocs = 0;
+        uint64_t total_bytes  = 0;
+        double   frames       = measured_frames > 0 ? double(measured_frames) : 1.0;
+
+        std::snprintf (line, sizeof(line), "headless run: %u frames of %.3f ms", measured_frames, headless.frame_time * 1000.f);
+
+        log.i (line);
+
+        for (unsigned phase = 0; phase < PHASE_COUNT; ++phase)
+        {
+            std::snprintf
+            (
+                line, sizeof(line), "  %-18s %10.3f ms total %8.4f ms/frame %8.2f allocs/frame %10.1f bytes/frame",
+                phase_names[phase], phase_times[phase] * 1000.0, phase_times[phase] * 1000.0 / frames,
+                double(phase_allocations[phase].allocations) / frames,
+                double(phase_allocations[phase].bytes      ) / frames
+            );
+
+            log.i (line);
+
+            total        += phase_times[phase];
+            total_allocs += phase_allocations[phase].allocations;
+            total_bytes  += phase_allocations[phase].bytes;
+        }
+
+        std::snprintf
+        (
+            line, sizeof(line), "  %-18s %10.3f ms total %8.4f ms/frame %8.2f allocs/frame %10.1f bytes/frame",
+            "all", total * 1000.0, total * 1000.0 / frames, double(total_allocs) / frames, double(total_bytes) / frames
+        );
+
+        log.i (line);
+
+        // The averages above include the start-up frames (graphics context, shaders, canvas and
+        // assets), so the frames that allocated tell whether the steady state is allocation free:
+
+        if (Allocation_Tracker::is_enabled ())
+        {
+            std::snprintf
+            (
+                line, sizeof(line), "  most allocations in one frame: %llu, frames that allocated: %u (last: %u)",
+                (unsigned long long)max_frame_allocations, allocating_frames, last_allocating_frame
+            );
+
+            log.i (line);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
     void Director::reset_viewport (Window::Accessor & window)
     {
+        stop_render_thread ();
+
         Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
 
         if (graphics_context)
@@ -296,4 +819,54 @@ namespace basics
         }
     }
 
+    // ---------------------------------------------------------------------------------------------
+
+    bool Director::start_render_thread (Window::Accessor & window, bool reset_canvas)
+    {
+        {
+            Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
+
+            if (!graphics_context) return false;
+
+            // The canvas state is reset here because the render thread only replays frames:
+
+            if (reset_canvas)
+            {
+                Canvas * canvas = graphics_context->get_renderer< Canvas > (ID(canvas));
+
+                if (canvas) canvas->reset_state ();
+            }
+
+            // The context must not be current in this thread so that the render thread can use it:
+
+            graphics_context->release_current ();
+        }
+
+        render_thread.set_asset_loader (&asset_loader, upload_budget);
+        render_thread.start (Window::get_window (default_window_id));
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Director::stop_render_thread ()
+    {
+        if (render_thread.is_running ())
+        {
+            render_thread.stop ();
+
+            // The context is made current again in this thread:
+
+            Window::Accessor window = Window::get_window (default_window_id).lock ();
+
+            if (window)
+            {
+                Graphics_Context::Accessor graphics_context = window->lock_graphics_context ();
+
+                if (graphics_context) graphics_context->make_current ();
+            }
+        }
+    }
+
 }
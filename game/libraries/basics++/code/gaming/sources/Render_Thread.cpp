@@ -0,0 +1,178 @@
+/*
+ * RENDER THREAD
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <basics/Canvas>
+#include <basics/Log>
+#include <basics/Profiler>
+#include <basics/Render_Thread>
+
+namespace basics
+{
+
+    void Render_Thread::start (const Window::Handle & new_window)
+    {
+        if (!is_running ())
+        {
+            window          = new_window;
+            exit            = false;
+            published_count = 0;
+            presented_count = 0;
+
+            frames.reset ();
+
+            thread = std::thread(&Render_Thread::run, this);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Thread::stop ()
+    {
+        if (is_running ())
+        {
+            {
+                std::lock_guard< std::mutex > lock(mutex);
+
+                exit = true;
+            }
+
+            frame_published.notify_one ();
+
+            thread.join ();
+
+            frame_presented.notify_all ();
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Thread::publish_frame ()
+    {
+        frames.publish ();
+
+        // Se toma el mutex para que el aviso no se pierda si el hilo de render acaba de comprobar
+        // que no había nada publicado y todavía no ha empezado a esperar:
+
+        {
+            std::lock_guard< std::mutex > lock(mutex);
+
+            published_count++;
+        }
+
+        frame_published.notify_one ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Thread::wait_for_presentation ()
+    {
+        std::unique_lock< std::mutex > lock(mutex);
+
+        frame_presented.wait (lock, [this] () { return exit || presented_count == published_count; });
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Thread::run ()
+    {
+        std::unique_lock< std::mutex > lock(mutex);
+
+        for (;;)
+        {
+            frame_published.wait (lock, [this] () { return exit || frames.has_fresh (); });
+
+            if (exit) break;
+
+            // Lo publicado hasta ahora queda presentado con el fotograma que se va a adquirir:
+
+            unsigned acquired_count = published_count;
+
+            lock.unlock ();
+
+            render_frame ();
+
+            lock.lock ();
+
+            presented_count = acquired_count;
+
+            frame_presented.notify_all ();
+        }
+
+        lock.unlock ();
+
+        release ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Thread::render_frame ()
+    {
+        Window::Accessor window_accessor = window.lock ();
+
+        if (window_accessor)
+        {
+            Graphics_Context::Accessor context = window_accessor->lock_graphics_context ();
+
+            if (context)
+            {
+                if (!context->is_current () && !context->make_current ())
+                {
+                    log.e ("ERROR: the render thread failed to make the graphics context current!");
+
+                    return;
+                }
+
+                if (asset_loader) asset_loader->upload (context, upload_budget);
+
+                frames.acquire ();
+
+                const Display_List & display_list = frames.get_front ();
+
+                Canvas * canvas = context->get_renderer< Canvas > (ID(canvas));
+
+                if (!canvas)
+                {
+                    canvas = Canvas::create (ID(canvas), context, { display_list.get_size () });
+                }
+
+                if (canvas)
+                {
+                    BASICS_PROFILE_ZONE ("Render_Thread::replay");
+
+                    display_list.replay (*canvas);
+                }
+
+                BASICS_PROFILE_ZONE ("Render_Thread::present");
+
+                context->flush_and_display ();
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Thread::release ()
+    {
+        Window::Accessor window_accessor = window.lock ();
+
+        if (window_accessor)
+        {
+            Graphics_Context::Accessor context = window_accessor->lock_graphics_context ();
+
+            // Aunque el contexto ya no esté disponible, se debe soltar antes de que el hilo termine:
+
+            if (context.has_context ())
+            {
+                context->release_current ();
+            }
+        }
+    }
+
+}
@@ -0,0 +1,96 @@
+/*
+ * SESSION RECORDER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <basics/Session_Recorder>
+
+namespace basics
+{
+
+    constexpr uint32_t Session_Recorder::magic;
+    constexpr uint32_t Session_Recorder::version;
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Session_Recorder::open (const std::string & path, uint32_t seed)
+    {
+        close ();
+
+        file            = std::fopen (path.c_str (), "wb");
+        failed          = file == nullptr;
+        recorded_frames = 0;
+
+        if (file)
+        {
+            write (magic  );
+            write (version);
+            write (seed   );
+
+            timer.reset ();
+        }
+
+        return !failed;
+    }
+
+    void Session_Recorder::close ()
+    {
+        if (file)
+        {
+            if (std::fclose (file) != 0) failed = true;
+
+            file = nullptr;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Session_Recorder::record_frame (unsigned frame, float delta, const std::vector< Event > & events, uint32_t checksum)
+    {
+        if (!file) return;
+
+        write (uint32_t(frame));
+        write (timer.get_elapsed_seconds ());
+        write (delta);
+        write (checksum);
+        write (uint16_t(events.size ()));
+
+        for (const Event & event : events)
+        {
+            write (uint32_t(event.id));
+            write (int32_t (event.priority));
+            write (uint8_t (event.properties.size ()));
+
+            for (Event::Property_List::Const_Iterator property = event.properties.begin (); property != event.properties.end (); ++property)
+            {
+                const Var & value = property.value ();
+
+                write (uint32_t(property.key ()));
+
+                if (const var::Bool * boolean = value.as< var::Bool > ())
+                {
+                    write (uint8_t(BOOL_PROPERTY));
+                    write (uint8_t(*boolean ? 1 : 0));
+                }
+                else
+                if (const var::Float * number = value.as< var::Float > ())
+                {
+                    write (uint8_t(FLOAT_PROPERTY));
+                    write (float(*number));
+                }
+                else
+                {
+                    write (uint8_t(VOID_PROPERTY));
+                }
+            }
+        }
+
+        ++recorded_frames;
+    }
+
+}
@@ -0,0 +1,165 @@
+/*
+ * SESSION REPLAYER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <cstdio>
+#include <memory>
+#include <basics/Session_Recorder>
+#include <basics/Session_Replayer>
+
+namespace basics
+{
+
+    namespace
+    {
+
+        class Reader
+        {
+
+            std::FILE * file;
+
+        public:
+
+            bool good;
+
+            Reader(std::FILE * file) : file(file), good(true)
+            {
+            }
+
+            template< typename TYPE >
+            TYPE read ()
+            {
+                TYPE value = TYPE();
+
+                if (good && std::fread (&value, sizeof(TYPE), 1, file) != 1) good = false;
+
+                return value;
+            }
+
+        };
+
+        struct File_Closer
+        {
+            void operator () (std::FILE * file) const { std::fclose (file); }
+        };
+
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Session_Replayer::load (const std::string & path)
+    {
+        frames.clear ();
+        events.clear ();
+
+        rewind ();
+
+        std::unique_ptr< std::FILE, File_Closer > file(std::fopen (path.c_str (), "rb"));
+
+        if (!file) return false;
+
+        Reader reader(file.get ());
+
+        if (reader.read< uint32_t > () != Session_Recorder::magic  ) return false;
+        if (reader.read< uint32_t > () != Session_Recorder::version) return false;
+
+        seed = reader.read< uint32_t > ();
+
+        for (;;)
+        {
+            Frame frame;
+
+            reader.read< uint32_t > ();                 // El índice solo sirve para inspeccionar el archivo
+
+            if (!reader.good) break;                    // Fin del archivo
+
+            frame.timestamp   = reader.read< float    > ();
+            frame.delta       = reader.read< float    > ();
+            frame.checksum    = reader.read< uint32_t > ();
+            frame.event_count = reader.read< uint16_t > ();
+            frame.first_event = events.size ();
+
+            for (size_t index = 0; index < frame.event_count && reader.good; ++index)
+            {
+                Event event(reader.read< uint32_t > ());
+
+                event.priority = reader.read< int32_t > ();
+
+                unsigned property_count = reader.read< uint8_t > ();
+
+                for (unsigned property = 0; property < property_count && reader.good; ++property)
+                {
+                    Id  key   = reader.read< uint32_t > ();
+                    Var value;
+
+                    switch (reader.read< uint8_t > ())
+                    {
+                        case Session_Recorder::BOOL_PROPERTY:  value = reader.read< uint8_t > () != 0; break;
+                        case Session_Recorder::FLOAT_PROPERTY: value = reader.read< float   > ();      break;
+                        case Session_Recorder::VOID_PROPERTY:                                          break;
+                        default:                               reader.good = false;                    break;
+                    }
+
+                    event[key] = value;
+                }
+
+                events.push_back (std::move (event));
+            }
+
+            if (!reader.good)
+            {
+                // Un fotograma incompleto indica que el archivo está dañado:
+
+                frames.clear ();
+                events.clear ();
+
+                return false;
+            }
+
+            frames.push_back (frame);
+        }
+
+        return true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Session_Replayer::play_frame (std::vector< Event > & frame_events, float & delta)
+    {
+        if (at_end ()) return false;
+
+        const Frame & frame = frames[next_frame++];
+
+        frame_events.insert
+        (
+            frame_events.end (),
+            events.begin () + frame.first_event,
+            events.begin () + frame.first_event + frame.event_count
+        );
+
+        delta = frame.delta;
+
+        return true;
+    }
+
+    bool Session_Replayer::verify (uint32_t checksum)
+    {
+        if (next_frame == 0) return false;
+
+        if (frames[next_frame - 1].checksum != checksum)
+        {
+            if (mismatch_count++ == 0) first_mismatch = unsigned(next_frame - 1);
+
+            return false;
+        }
+
+        return true;
+    }
+
+}
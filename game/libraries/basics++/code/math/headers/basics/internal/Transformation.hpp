@@ -30,7 +30,7 @@
             static  constexpr unsigned dimension = DIMENSION;
             static  constexpr unsigned size      = dimension + 1;
 
-            typedef Matrix< size, size, Numeric_Type > Matrix;
+            typedef basics::Matrix< size, size, Numeric_Type > Matrix;
 
         public:
 
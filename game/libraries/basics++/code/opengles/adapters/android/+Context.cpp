@@ -15,6 +15,7 @@
 #if defined(BASICS_ANDROID_OS)
 
     #include "Android_OpenGL_ES_Context.hpp"
+    #include <basics/Startup_Timeline>
     #include "../../../base/adapters/android/Native_Window.hpp"
 
     namespace basics { namespace opengles
@@ -22,6 +23,8 @@
 
         bool Context::create (basics::Window::Accessor & window, Graphics_Resource_Cache * cache)
         {
+            BASICS_STARTUP_SPAN ("create graphics context");
+
             if (window && window->is_available () && !window->has_graphics_context ())
             {
                 std::shared_ptr< Graphics_Context > context
@@ -22,6 +22,7 @@
 
 #if defined(BASICS_ANDROID_OS)
 
+    #include <basics/opengles/GL_State>
     #include <basics/opengles/OpenGL_ES1>
     #include "Android_OpenGL_ES_Context.hpp"
     #include "../../../base/adapters/android/Native_Window.hpp"
@@ -101,9 +102,23 @@
 
         bool Android_OpenGL_ES_Context::make_current ()
         {
-            if (available)
+            if (available && eglMakeCurrent (display, surface, surface, context) == EGL_TRUE)
+            {
+                // El estado que se conocía puede pertenecer a otro contexto:
+
+                GL_State::invalidate ();
+
+                return true;
+            }
+
+            return false;
+        }
+
+        bool Android_OpenGL_ES_Context::release_current ()
+        {
+            if (display != EGL_NO_DISPLAY)
             {
-                return eglMakeCurrent (display, surface, surface, context) == EGL_TRUE;
+                return eglMakeCurrent (display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT) == EGL_TRUE;
             }
 
             return false;
@@ -113,6 +128,10 @@
         {
             if (available)
             {
+                flush_renderers ();
+
+                GL_State::end_frame ();
+
                 //return eglSwapBuffers (display, surface) == EGL_TRUE;
 
                 if (!eglSwapBuffers (display, surface))
@@ -70,6 +70,7 @@
 
             bool is_current () const override;
             bool make_current () override;
+            bool release_current () override;
 
             bool set_sync_swap (bool activated) override;
             bool flush_and_display () override;
@@ -0,0 +1,273 @@
+/*
+ * LINUX OPENGL ES CONTEXT
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+// https://www.khronos.org/registry/EGL/sdk/docs/man/html/eglCreatePbufferSurface.xhtml
+// https://www.khronos.org/registry/EGL/extensions/MESA/EGL_MESA_platform_surfaceless.txt
+
+#include <basics/macros>
+
+#if defined(BASICS_LINUX_OS)
+
+    #include <basics/opengles/GL_State>
+    #include <basics/opengles/OpenGL_ES2>
+    #include "Linux_OpenGL_ES_Context.hpp"
+    #include "../../../base/adapters/linux/Offscreen_Window.hpp"
+
+    #define  EGL_ATTRIBUTE(ATTRIBUTE, VALUE) ATTRIBUTE, VALUE
+
+    #ifndef  EGL_PLATFORM_SURFACELESS_MESA
+    #define  EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+    #endif
+
+    namespace basics { namespace opengles { namespace internal
+    {
+
+        Linux_OpenGL_ES_Context::Linux_OpenGL_ES_Context(basics::internal::Offscreen_Window & window, Graphics_Resource_Cache * cache) : basics::opengles::Context(window, cache)
+        {
+            display        = EGL_NO_DISPLAY;
+            surface        = EGL_NO_SURFACE;
+            context        = EGL_NO_CONTEXT;
+            config         = nullptr;
+            surface_width  = EGLint(window.get_width  ());
+            surface_height = EGLint(window.get_height ());
+            available      = initialized = initialize_display () && initialize_surface () && initialize_context ();
+            version        = VERSION_2_0;
+        }
+
+        void Linux_OpenGL_ES_Context::suspend ()
+        {
+            // La superficie no depende de ninguna ventana real, por lo que se conserva:
+
+            available = false;
+        }
+
+        bool Linux_OpenGL_ES_Context::resume ()
+        {
+            return available = initialized && display != EGL_NO_DISPLAY;
+        }
+
+        void Linux_OpenGL_ES_Context::finalize ()
+        {
+            Graphics_Context::finalize ();
+
+            available = false;
+
+            if (display != EGL_NO_DISPLAY)
+            {
+                eglWaitClient  ();
+                eglMakeCurrent (display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+                finalize_context ();
+                finalize_surface ();
+                finalize_display ();
+            }
+        }
+
+        bool Linux_OpenGL_ES_Context::is_current () const
+        {
+            if (available)
+            {
+                return eglGetCurrentContext () == context;
+            }
+
+            return false;
+        }
+
+        bool Linux_OpenGL_ES_Context::set_sync_swap (bool activated)
+        {
+            if (available)
+            {
+                return eglSwapInterval (display, activated ? 1 : 0) == EGL_TRUE;
+            }
+
+            return false;
+        }
+
+        bool Linux_OpenGL_ES_Context::make_current ()
+        {
+            if (available && eglMakeCurrent (display, surface, surface, context) == EGL_TRUE)
+            {
+                // El estado que se conocía puede pertenecer a otro contexto:
+
+                GL_State::invalidate ();
+
+                return true;
+            }
+
+            return false;
+        }
+
+        bool Linux_OpenGL_ES_Context::release_current ()
+        {
+            if (display != EGL_NO_DISPLAY)
+            {
+                return eglMakeCurrent (display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT) == EGL_TRUE;
+            }
+
+            return false;
+        }
+
+        bool Linux_OpenGL_ES_Context::flush_and_display ()
+        {
+            if (available)
+            {
+                flush_renderers ();
+
+                GL_State::end_frame ();
+
+                return eglSwapBuffers (display, surface) == EGL_TRUE;
+            }
+
+            return false;
+        }
+
+        void Linux_OpenGL_ES_Context::reset_viewport ()
+        {
+            if (available)
+            {
+                eglQuerySurface (display, surface, EGL_WIDTH,  &surface_width );
+                eglQuerySurface (display, surface, EGL_HEIGHT, &surface_height);
+                glViewport      (0, 0, surface_width, surface_height);
+            }
+        }
+
+        void Linux_OpenGL_ES_Context::set_viewport (const Point2u & bottom_left, const Size2u & size)
+        {
+            if (available)
+            {
+                glViewport (bottom_left[0], bottom_left[1], size.width, size.height);
+            }
+        }
+
+        bool Linux_OpenGL_ES_Context::initialize_display ()
+        {
+            EGLint egl_version_major = 0;
+            EGLint egl_version_minor = 0;
+
+            display = eglGetDisplay (EGL_DEFAULT_DISPLAY);
+
+            if (display != EGL_NO_DISPLAY && eglInitialize (display, &egl_version_major, &egl_version_minor) == EGL_TRUE)
+            {
+                return egl_version_major > 1 || (egl_version_major == 1 && egl_version_minor >= 4);
+            }
+
+            // Si no hay pantalla se recurre a la plataforma surfaceless de Mesa:
+
+            typedef EGLDisplay (EGLAPIENTRY * Get_Platform_Display)(EGLenum, void *, const EGLint *);
+
+            Get_Platform_Display get_platform_display = reinterpret_cast< Get_Platform_Display >
+            (
+                eglGetProcAddress ("eglGetPlatformDisplayEXT")
+            );
+
+            if (get_platform_display)
+            {
+                display = get_platform_display (EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+
+                if (display != EGL_NO_DISPLAY && eglInitialize (display, &egl_version_major, &egl_version_minor) == EGL_TRUE)
+                {
+                    return egl_version_major > 1 || (egl_version_major == 1 && egl_version_minor >= 4);
+                }
+            }
+
+            display = EGL_NO_DISPLAY;
+
+            return false;
+        }
+
+        bool Linux_OpenGL_ES_Context::initialize_surface ()
+        {
+            const EGLint desired_attributes[] =
+            {
+                EGL_ATTRIBUTE( EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT ),
+                EGL_ATTRIBUTE( EGL_SURFACE_TYPE,    EGL_PBUFFER_BIT    ),
+                EGL_ATTRIBUTE( EGL_RED_SIZE,        8                  ),
+                EGL_ATTRIBUTE( EGL_GREEN_SIZE,      8                  ),
+                EGL_ATTRIBUTE( EGL_BLUE_SIZE,       8                  ),
+                EGL_ATTRIBUTE( EGL_DEPTH_SIZE,      0                  ),
+                EGL_NONE
+            };
+
+            EGLint number_of_suitable_configurations = 0;
+
+            if
+            (
+                eglBindAPI (EGL_OPENGL_ES_API) &&
+                eglChooseConfig (display, desired_attributes, &config, 1, &number_of_suitable_configurations) &&
+                number_of_suitable_configurations > 0
+            )
+            {
+                const EGLint surface_attributes[] =
+                {
+                    EGL_ATTRIBUTE( EGL_WIDTH,  surface_width  ),
+                    EGL_ATTRIBUTE( EGL_HEIGHT, surface_height ),
+                    EGL_NONE
+                };
+
+                surface = eglCreatePbufferSurface (display, config, surface_attributes);
+
+                if (surface != EGL_NO_SURFACE)
+                {
+                    eglQuerySurface (display, surface, EGL_WIDTH,  &surface_width );
+                    eglQuerySurface (display, surface, EGL_HEIGHT, &surface_height);
+
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        bool Linux_OpenGL_ES_Context::initialize_context ()
+        {
+            const EGLint context_attributes[] =
+            {
+                EGL_ATTRIBUTE( EGL_CONTEXT_CLIENT_VERSION, 2 ),
+                EGL_NONE
+            };
+
+            context = eglCreateContext (display, config, EGL_NO_CONTEXT, context_attributes);
+
+            return context != EGL_NO_CONTEXT;
+        }
+
+        void Linux_OpenGL_ES_Context::finalize_display ()
+        {
+            if (display != EGL_NO_DISPLAY)
+            {
+                eglTerminate (display);
+
+                display  = EGL_NO_DISPLAY;
+            }
+        }
+
+        void Linux_OpenGL_ES_Context::finalize_surface ()
+        {
+            if (surface != EGL_NO_SURFACE)
+            {
+                eglDestroySurface (display, surface);
+
+                surface  = EGL_NO_SURFACE;
+            }
+        }
+
+        void Linux_OpenGL_ES_Context::finalize_context ()
+        {
+            if (context != EGL_NO_CONTEXT)
+            {
+                eglDestroyContext (display, context);
+
+                context  = EGL_NO_CONTEXT;
+            }
+        }
+
+    }}}
+
+#endif
@@ -20,7 +20,10 @@
     namespace basics { namespace opengles
     {
 
+        class Quad_Batch;
+        class Render_Queue;
         class Shader_Program;
+        class Texture_2D;
 
         class Canvas_ES2 : public basics::Canvas
         {
@@ -66,6 +69,14 @@
             unsigned   vertex_position_location_t;
             unsigned vertex_texture_uv_location_t;
 
+            float    opacity;
+            Blending blending;
+            unsigned layer;
+
+            std::shared_ptr< Quad_Batch   > quad_batch;
+            std::shared_ptr< Render_Queue > render_queue;
+            bool                            batching;
+
         public:
 
             Canvas_ES2(Graphics_Context::Accessor & context, const Size2u & viewport_size);
@@ -73,6 +84,8 @@
         public:
 
             void reset_state     () override;
+            void set_batching    (bool enabled) override;
+            void flush           () override;
 
         public:
 
@@ -83,6 +96,8 @@
             void set_clear_color (float r, float g, float b) override;
             void set_color       (float r, float g, float b) override;
             void set_opacity     (float opacity) override;
+            void set_blending    (Blending blending) override;
+            void set_layer       (unsigned layer) override;
             void set_transform   (const Transformation2f & transform) override;
             void apply_transform (const Transformation2f & transform) override;
 
@@ -98,6 +113,15 @@
             void fill_rectangle  (const Point2f & where, const Size2f & size, const basics::Texture_2D * texture, int handling = CENTER) override;
             void fill_rectangle  (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling = CENTER) override;
 
+        private:
+
+            void draw_textured_quad (const Texture_2D * texture, const Point2f * coordinates, const Point2f * texture_uvs);
+            void flush_queue        ();
+            void draw_quad_batch    ();
+            void apply_blending     (Blending mode);
+            void use_program_f      ();
+            void use_program_t      ();
+
         };
 
     }}
@@ -0,0 +1,138 @@
+/*
+ * GL STATE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_OPENGLES_GL_STATE_HEADER
+#define BASICS_OPENGLES_GL_STATE_HEADER
+
+    #include <basics/Non_Instantiable>
+    #include <basics/opengles/OpenGL_ES2>
+
+    namespace basics { namespace opengles
+    {
+
+        /**
+         * Copia en la CPU del estado de OpenGL ES que cambia con más frecuencia (textura vinculada,
+         * programa activo, arrays de atributos habilitados, blending y buffers vinculados). Las
+         * llamadas que no cambiarían nada no se envían al driver.
+         *
+         * Todo el código del módulo opengles debe cambiar ese estado a través de esta clase para
+         * que la copia no se desincronice. Cuando se crea o se vuelve a activar un contexto hay que
+         * llamar a invalidate() para que la siguiente llamada de cada tipo se envíe sí o sí.
+         */
+        class GL_State : Non_Instantiable
+        {
+        public:
+
+            /**
+             * Contadores de llamadas a OpenGL enviadas (issued) y evitadas (elided). Incluyen las
+             * subidas de valores de uniforms que realiza Shader_Program.
+             */
+            struct Statistics
+            {
+                unsigned issued_calls;
+                unsigned elided_calls;
+            };
+
+            /// Número de atributos de vértice que se controlan. Es el mínimo que garantiza OpenGL ES 2.0
+            /// para GL_MAX_VERTEX_ATTRIBS.
+            static constexpr unsigned max_vertex_attributes = 8;
+
+        private:
+
+            static bool       valid;                    ///< false si el estado real es desconocido.
+
+            static GLenum     active_texture_unit;
+            static GLuint     bound_texture;
+            static GLuint     used_program;
+            static GLuint     bound_array_buffer;
+            static GLuint     bound_element_array_buffer;
+            static unsigned   enabled_vertex_attributes;    ///< Un bit por cada índice de atributo.
+            static unsigned   unknown_vertex_attributes;    ///< Bits cuyo estado real se desconoce.
+            static bool       blending_known;
+            static bool       blending_enabled;
+            static GLenum     blending_source_factor;
+            static GLenum     blending_target_factor;
+
+            static Statistics statistics;
+            static Statistics frame_statistics;
+
+        public:
+
+            /**
+             * Olvida el estado conocido. Las siguientes llamadas se enviarán al driver aunque
+             * coincidan con los valores anteriores.
+             */
+            static void invalidate ()
+            {
+                valid = false;
+            }
+
+            /**
+             * Cierra los contadores del fotograma en curso. Se debe llamar una vez por fotograma.
+             */
+            static void end_frame ()
+            {
+                statistics       = frame_statistics;
+                frame_statistics = { 0, 0 };
+            }
+
+            /**
+             * Retorna los contadores del último fotograma completado.
+             */
+            static const Statistics & get_statistics ()
+            {
+                return statistics;
+            }
+
+            static void count_issued_call ()
+            {
+                frame_statistics.issued_calls++;
+            }
+
+            static void count_elided_call ()
+            {
+                frame_statistics.elided_calls++;
+            }
+
+        public:
+
+            static void set_active_texture_unit  (GLenum unit);
+            static void bind_texture             (GLuint texture_object_id);
+            static void use_program              (GLuint program_object_id);
+            static void bind_array_buffer        (GLuint buffer_id);
+            static void bind_element_array_buffer(GLuint buffer_id);
+
+            /**
+             * Deja habilitados únicamente los arrays de atributos de vértice cuyo bit está activo
+             * en la máscara (el bit i corresponde al índice de atributo i).
+             */
+            static void set_vertex_attribute_arrays (unsigned mask);
+
+            static void set_blending             (bool enabled, GLenum source_factor = GL_ONE, GLenum target_factor = GL_ZERO);
+
+        public:
+
+            /**
+             * Se debe llamar antes de eliminar objetos de OpenGL para que la copia del estado no
+             * conserve identificadores que el driver podría reutilizar.
+             */
+            static void forget_texture (GLuint texture_object_id);
+            static void forget_program (GLuint program_object_id);
+            static void forget_buffer  (GLuint buffer_id);
+
+        private:
+
+            static void revalidate ();
+
+        };
+
+    }}
+
+#endif
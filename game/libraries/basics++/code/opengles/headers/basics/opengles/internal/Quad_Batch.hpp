@@ -0,0 +1,137 @@
+/*
+ * QUAD BATCH
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_OPENGLES_QUAD_BATCH_HEADER
+#define BASICS_OPENGLES_QUAD_BATCH_HEADER
+
+    #include <vector>
+    #include <basics/Graphics_Resource>
+    #include <basics/Point>
+    #include <basics/opengles/OpenGL_ES2>
+
+    namespace basics { namespace opengles
+    {
+
+        /**
+         * Acumula quads texturizados en memoria de la CPU para enviarlos a la GPU mediante una sola
+         * llamada de dibujado. Los vértices se suben a un vertex buffer de tipo "stream" que se
+         * reescribe en cada volcado, mientras que los índices de los quads se guardan una sola vez
+         * en un index buffer estático compartido por todos los volcados.
+         */
+        class Quad_Batch : public Graphics_Resource
+        {
+        public:
+
+            struct Vertex
+            {
+                GLfloat x, y;
+                GLfloat u, v;
+            };
+
+            /// Número máximo de quads que caben en un lote. Se limita para que los índices quepan
+            /// en 16 bits (4 vértices por quad).
+            static constexpr unsigned max_quads = 2048;
+
+        private:
+
+            std::vector< Vertex > vertices;
+
+            GLuint  vertex_buffer_id;
+            GLuint   index_buffer_id;
+
+        public:
+
+            Quad_Batch()
+            {
+                vertices.reserve (max_quads * 4);
+            }
+
+            Quad_Batch(const Quad_Batch & ) = delete;
+
+           ~Quad_Batch()
+            {
+                finalize ();
+            }
+
+        public:
+
+            bool initialize () override;
+            void finalize   () override;
+
+        public:
+
+            bool is_usable () const
+            {
+                return initialized;
+            }
+
+            bool is_empty () const
+            {
+                return vertices.empty ();
+            }
+
+            bool is_full () const
+            {
+                return vertices.size () >= max_quads * 4;
+            }
+
+            unsigned size () const
+            {
+                return unsigned(vertices.size () / 4);
+            }
+
+        public:
+
+            /**
+             * Añade un quad al lote. Los vértices se esperan en el mismo orden que usa un triangle
+             * strip: inferior izquierdo, superior izquierdo, inferior derecho y superior derecho.
+             * @param positions Coordenadas de los cuatro vértices.
+             * @param texture_uvs Coordenadas de textura de los cuatro vértices.
+             */
+            void add (const Point2f * positions, const Point2f * texture_uvs)
+            {
+                for (unsigned index = 0; index < 4; ++index)
+                {
+                    vertices.push_back
+                    ({
+                        positions  [index][0], positions  [index][1],
+                        texture_uvs[index][0], texture_uvs[index][1]
+                    });
+                }
+            }
+
+            /**
+             * Añade un quad cuyos cuatro vértices ya están preparados (en el mismo orden que en la
+             * versión anterior).
+             */
+            void add (const Vertex * quad_vertices)
+            {
+                vertices.insert (vertices.end (), quad_vertices, quad_vertices + 4);
+            }
+
+            /**
+             * Sube los vértices acumulados y los dibuja con el shader program y la textura que estén
+             * en uso, dejando el lote vacío.
+             * @param position_location Índice del atributo de posición del shader program.
+             * @param texture_uv_location Índice del atributo de coordenadas de textura.
+             * @return Número de llamadas de dibujado realizadas (0 si el lote estaba vacío).
+             */
+            unsigned flush (GLuint position_location, GLuint texture_uv_location);
+
+            void clear ()
+            {
+                vertices.clear ();
+            }
+
+        };
+
+    }}
+
+#endif
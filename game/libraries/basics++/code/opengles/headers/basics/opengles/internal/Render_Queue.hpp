@@ -0,0 +1,145 @@
+/*
+ * RENDER QUEUE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_OPENGLES_RENDER_QUEUE_HEADER
+#define BASICS_OPENGLES_RENDER_QUEUE_HEADER
+
+    #include <cstdint>
+    #include <vector>
+    #include <basics/Canvas>
+    #include <basics/Size>
+    #include <basics/opengles/Quad_Batch>
+
+    namespace basics { namespace opengles
+    {
+
+        class Shader_Program;
+        class Texture_2D;
+
+        /**
+         * Cola de quads texturizados que se ordena antes de dibujarse para agrupar los que comparten
+         * estado (blending, shader program, textura y opacidad) y reducir así los cambios de estado
+         * y las llamadas de dibujado.
+         *
+         * Cada quad recibe una clave de 64 bits. De más a menos significativo contiene:
+         *
+         *   - La capa explícita (8 bits). Las capas se dibujan siempre en orden creciente.
+         *   - La profundidad (16 bits), que se calcula automáticamente para que un quad se dibuje
+         *     siempre después de los quads anteriores con distinto estado que puedan solaparse con
+         *     él. Así el resultado es el mismo que si se dibujasen en el orden en que se añadieron.
+         *   - El estado (32 bits): blending, shader program, textura y opacidad.
+         *
+         * La ordenación es estable, de modo que los quads con la misma clave conservan su orden.
+         */
+        class Render_Queue
+        {
+        public:
+
+            struct Quad
+            {
+                Quad_Batch::Vertex     vertices[4];         ///< Posiciones ya transformadas.
+                const Texture_2D     * texture;
+                const Shader_Program * program;
+                Canvas::Blending       blending;
+                float                  opacity;
+            };
+
+            /// Número de celdas por lado de la rejilla con la que se detectan los solapamientos.
+            static constexpr unsigned grid_size = 16;
+
+            /// Quads para los que se reserva memoria de antemano, de modo que un fotograma normal
+            /// no tenga que hacer crecer las listas.
+            static constexpr unsigned initial_capacity = 512;
+
+        private:
+
+            struct Entry
+            {
+                uint64_t key;
+                unsigned index;                     ///< Posición del quad en la lista de quads.
+            };
+
+            /**
+             * Mayor profundidad que se ha asignado a los quads que tocan una celda y estado de los
+             * quads que tienen esa profundidad (mixed_state si son varios).
+             */
+            struct Cell
+            {
+                unsigned depth;
+                uint32_t state;
+            };
+
+            typedef std::vector< Quad  > Quad_List;
+            typedef std::vector< Entry > Entry_List;
+
+            static constexpr uint32_t empty_state = 0xFFFFFFFE;
+            static constexpr uint32_t mixed_state = 0xFFFFFFFF;
+
+        private:
+
+            Quad_List  quads;
+            Entry_List entries;
+            Entry_List sorted_entries;
+
+            std::vector< const Texture_2D     * > textures;    ///< Dan su índice a cada textura...
+            std::vector< const Shader_Program * > programs;    ///< ...y a cada shader program.
+
+            Cell   cells[grid_size * grid_size];
+            Size2f area;
+
+        public:
+
+            Render_Queue();
+
+        public:
+
+            /**
+             * Establece el tamaño del área en la que se dibuja, que es la que se reparte entre las
+             * celdas de la rejilla. Solo se debe llamar con la cola vacía.
+             */
+            void set_area (const Size2f & new_area)
+            {
+                area = new_area;
+            }
+
+            bool is_empty () const
+            {
+                return quads.empty ();
+            }
+
+            unsigned size () const
+            {
+                return unsigned(quads.size ());
+            }
+
+        public:
+
+            void add   (unsigned layer, const Quad & quad);
+            void sort  ();
+            void clear ();
+
+            /**
+             * Retorna el quad que ocupa la posición indicada tras ordenar la cola.
+             */
+            const Quad & operator [] (unsigned index) const
+            {
+                return quads[sorted_entries[index].index];
+            }
+
+        private:
+
+            uint32_t make_state   (const Quad & quad);
+            unsigned assign_depth (const Quad & quad, uint32_t state);
+
+        };
+
+    }}
+
+#endif
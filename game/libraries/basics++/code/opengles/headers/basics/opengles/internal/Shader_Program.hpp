@@ -19,6 +19,7 @@
     #include <basics/Matrix>
     #include <basics/Point>
     #include <basics/Vector>
+    #include <basics/opengles/GL_State>
     #include <basics/opengles/Shader>
 
     namespace basics { namespace opengles
@@ -30,6 +31,32 @@
 
             typedef std::map< std::string, GLint > Uniform_Map;
 
+            /**
+             * Último valor asignado a un uniform. Los valores no se envían a OpenGL al asignarlos,
+             * sino la próxima vez que se usa el programa, y solo si han cambiado.
+             */
+            struct Uniform_Value
+            {
+                enum Type
+                {
+                    UNDEFINED,
+                    INTEGER,
+                    FLOATS,
+                    MATRIX_2,
+                    MATRIX_3,
+                    MATRIX_4
+                };
+
+                GLint   location;                       ///< Valor opaco que asigna el driver.
+                Type    type;
+                GLint   integer;
+                GLsizei count;                          ///< Número de floats usados en values.
+                GLfloat values[16];
+                bool    dirty;
+            };
+
+            typedef std::vector< Uniform_Value > Uniform_Value_List;
+
         private:
 
             static const Shader_Program * active_shader_program;
@@ -44,7 +71,9 @@
 
             static void disable ()
             {
-                glUseProgram (0);
+                GL_State::use_program (0);
+
+                active_shader_program = nullptr;
             }
 
         private:
@@ -55,9 +84,17 @@
             GLuint      program_object_id;
             std::string log_string;
 
+            // Los valores de los uniforms forman parte del estado de OpenGL y no del objeto, por lo
+            // que se pueden modificar a través de referencias constantes:
+
+            mutable Uniform_Value_List uniform_values;  ///< Ordenados por location (hay muy pocos).
+            mutable bool               dirty_uniforms;
+
         public:
 
             Shader_Program()
+            :
+                dirty_uniforms(false)
             {
                 instance_id = instance_count++;
             }
@@ -77,7 +114,13 @@
             {
                 if (initialized)
                 {
+                    GL_State::forget_program (program_object_id);
+
                     glDeleteProgram (program_object_id);
+
+                    if (active_shader_program == this) active_shader_program = nullptr;
+
+                    initialized = false;
                 }
             }
 
@@ -104,18 +147,28 @@
 
         public:
 
+            /**
+             * Activa el programa y le envía los valores de uniforms que hayan cambiado desde la
+             * última vez que se usó. Se debe llamar justo antes de dibujar.
+             */
             void use () const
             {
                 assert(is_usable ());
 
-                if (this != active_shader_program)
-                {
-                    glUseProgram (program_object_id);
+                GL_State::use_program (program_object_id);
 
-                    active_shader_program = this;
-                }
+                active_shader_program = this;
+
+                if (dirty_uniforms) upload_uniforms ();
             }
 
+        private:
+
+            void            upload_uniforms () const;
+            Uniform_Value & get_uniform     (GLint uniform_id) const;
+            void store_uniform   (GLint uniform_id, Uniform_Value::Type type, const GLfloat * values, GLsizei count) const;
+            void store_uniform   (GLint uniform_id, GLint value) const;
+
         public:
 
             int get_uniform_id (const char * identifier) const
@@ -129,20 +182,20 @@
                 return (uniform_id);
             }
 
-            void set_uniform_value (GLint uniform_id, const GLint     & value     ) const { glUniform1i  (uniform_id, value); }
-            void set_uniform_value (GLint uniform_id, const float     & value     ) const { glUniform1f  (uniform_id, value); }
-            void set_uniform_value (GLint uniform_id, const float    (& vector)[2]) const { glUniform2f  (uniform_id, vector[0], vector[1]); }
-            void set_uniform_value (GLint uniform_id, const float    (& vector)[3]) const { glUniform3f  (uniform_id, vector[0], vector[1], vector[2]); }
-            void set_uniform_value (GLint uniform_id, const float    (& vector)[4]) const { glUniform4f  (uniform_id, vector[0], vector[1], vector[2], vector[3]); }
-            void set_uniform_value (GLint uniform_id, const Point2f   & point     ) const { glUniform2f  (uniform_id,  point[0],  point[1]); }
-            void set_uniform_value (GLint uniform_id, const Point3f   & point     ) const { glUniform3f  (uniform_id,  point[0],  point[1],  point[2]); }
-            void set_uniform_value (GLint uniform_id, const Point4f   & point     ) const { glUniform4f  (uniform_id,  point[0],  point[1],  point[2],  point[3]); }
-            void set_uniform_value (GLint uniform_id, const Vector2f  & vector    ) const { glUniform2f  (uniform_id, vector[0], vector[1]); }
-            void set_uniform_value (GLint uniform_id, const Vector3f  & vector    ) const { glUniform3f  (uniform_id, vector[0], vector[1], vector[2]); }
-            void set_uniform_value (GLint uniform_id, const Vector4f  & vector    ) const { glUniform4f  (uniform_id, vector[0], vector[1], vector[2], vector[3]); }
-            void set_uniform_value (GLint uniform_id, const Matrix22f & matrix    ) const { glUniformMatrix2fv (uniform_id, 1, GL_FALSE, matrix.values); }
-            void set_uniform_value (GLint uniform_id, const Matrix33f & matrix    ) const { glUniformMatrix3fv (uniform_id, 1, GL_FALSE, matrix.values); }
-            void set_uniform_value (GLint uniform_id, const Matrix44f & matrix    ) const { glUniformMatrix4fv (uniform_id, 1, GL_FALSE, matrix.values); }
+            void set_uniform_value (GLint uniform_id, const GLint     & value     ) const { store_uniform (uniform_id, value); }
+            void set_uniform_value (GLint uniform_id, const float     & value     ) const { store_uniform (uniform_id, Uniform_Value::FLOATS,   &value,        1); }
+            void set_uniform_value (GLint uniform_id, const float    (& vector)[2]) const { store_uniform (uniform_id, Uniform_Value::FLOATS,   vector,        2); }
+            void set_uniform_value (GLint uniform_id, const float    (& vector)[3]) const { store_uniform (uniform_id, Uniform_Value::FLOATS,   vector,        3); }
+            void set_uniform_value (GLint uniform_id, const float    (& vector)[4]) const { store_uniform (uniform_id, Uniform_Value::FLOATS,   vector,        4); }
+            void set_uniform_value (GLint uniform_id, const Point2f   & point     ) const { const float values[] = {  point[0],  point[1] };                       store_uniform (uniform_id, Uniform_Value::FLOATS, values, 2); }
+            void set_uniform_value (GLint uniform_id, const Point3f   & point     ) const { const float values[] = {  point[0],  point[1],  point[2] };            store_uniform (uniform_id, Uniform_Value::FLOATS, values, 3); }
+            void set_uniform_value (GLint uniform_id, const Point4f   & point     ) const { const float values[] = {  point[0],  point[1],  point[2],  point[3] }; store_uniform (uniform_id, Uniform_Value::FLOATS, values, 4); }
+            void set_uniform_value (GLint uniform_id, const Vector2f  & vector    ) const { const float values[] = { vector[0], vector[1] };                       store_uniform (uniform_id, Uniform_Value::FLOATS, values, 2); }
+            void set_uniform_value (GLint uniform_id, const Vector3f  & vector    ) const { const float values[] = { vector[0], vector[1], vector[2] };            store_uniform (uniform_id, Uniform_Value::FLOATS, values, 3); }
+            void set_uniform_value (GLint uniform_id, const Vector4f  & vector    ) const { const float values[] = { vector[0], vector[1], vector[2], vector[3] }; store_uniform (uniform_id, Uniform_Value::FLOATS, values, 4); }
+            void set_uniform_value (GLint uniform_id, const Matrix22f & matrix    ) const { store_uniform (uniform_id, Uniform_Value::MATRIX_2, matrix.values,  4); }
+            void set_uniform_value (GLint uniform_id, const Matrix33f & matrix    ) const { store_uniform (uniform_id, Uniform_Value::MATRIX_3, matrix.values,  9); }
+            void set_uniform_value (GLint uniform_id, const Matrix44f & matrix    ) const { store_uniform (uniform_id, Uniform_Value::MATRIX_4, matrix.values, 16); }
 
         public:
 
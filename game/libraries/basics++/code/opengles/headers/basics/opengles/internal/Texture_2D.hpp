@@ -15,6 +15,7 @@
 
     #include <basics/Color_Buffer>
     #include <basics/Graphics_Resource>
+    #include <basics/opengles/GL_State>
     #include <basics/opengles/OpenGL_ES2>
     #include <basics/Texture_2D>
 
@@ -39,7 +40,9 @@
 
             static void unuse ()
             {
-                glBindTexture (GL_TEXTURE_2D, 0);
+                GL_State::bind_texture (0);
+
+                active_texture = nullptr;
             }
 
         private:
@@ -73,7 +76,11 @@
             {
                 if (initialized)
                 {
+                    GL_State::forget_texture (texture_object_id);
+
                     glDeleteTextures (1, &texture_object_id);
+
+                    initialized = false;
                 }
             }
 
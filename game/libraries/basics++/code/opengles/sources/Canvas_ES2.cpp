@@ -10,9 +10,13 @@
  * C1801091703
  */
 
+#include <basics/Profiler>
 #include <basics/Transformation>
 #include <basics/opengles/OpenGL_ES2>
 #include <basics/opengles/Canvas_ES2>
+#include <basics/opengles/GL_State>
+#include <basics/opengles/Quad_Batch>
+#include <basics/opengles/Render_Queue>
 #include <basics/opengles/Shader_Program>
 #include <basics/opengles/Texture_2D>
 
@@ -107,7 +111,11 @@ namespace basics { namespace opengles
 
     Canvas_ES2::Canvas_ES2(Graphics_Context::Accessor & context, const Size2u & size)
     :
-        size{ float(size.width), float(size.height) }
+        size{ float(size.width), float(size.height) },
+        opacity (1.f),
+        blending(TRANSPARENCY),
+        layer   (0),
+        batching(false)
     {
         shader_program_f.reset (new Shader_Program);
 
@@ -118,12 +126,12 @@ namespace basics { namespace opengles
 
         if (shader_program_f->is_usable ())
         {
-            shader_program_f->use ();
-
              transform_f_id = shader_program_f->get_uniform_id ("transform" );
             projection_f_id = shader_program_f->get_uniform_id ("projection");
                  color_f_id = shader_program_f->get_uniform_id ("color"     );
                opacity_f_id = shader_program_f->get_uniform_id ("opacity"   );
+
+            vertex_position_location_f = shader_program_f->get_vertex_attribute_id ("vertex_position");
         }
 
         shader_program_t.reset (new Shader_Program);
@@ -135,8 +143,6 @@ namespace basics { namespace opengles
 
         if (shader_program_t->is_usable ())
         {
-            shader_program_t->use ();
-
              transform_t_id = shader_program_t->get_uniform_id ("transform" );
             projection_t_id = shader_program_t->get_uniform_id ("projection");
                sampler_t_id = shader_program_t->get_uniform_id ("sampler"   );
@@ -148,13 +154,24 @@ namespace basics { namespace opengles
             shader_program_t->set_uniform_value (sampler_t_id, 0);
         }
 
+        quad_batch.reset (new Quad_Batch);
+
+        context->add (quad_batch);
+
+        render_queue.reset (new Render_Queue);
+
+        batching = quad_batch->is_usable ();
+
         reset_state ();
     }
 
     void Canvas_ES2::reset_state ()
     {
-        glEnable      (GL_BLEND);
-        glBlendFunc   (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        flush_queue   ();
+
+        blending = TRANSPARENCY;
+        layer    = 0;
+
         glClearColor  (0.f, 0.f, 0.f, 1.f);
 
         set_size      ({ unsigned(size.width), unsigned(size.height) });
@@ -163,17 +180,33 @@ namespace basics { namespace opengles
         set_opacity   (1.f);
     }
 
+    void Canvas_ES2::set_batching (bool enabled)
+    {
+        if (!enabled) flush_queue ();
+
+        batching = enabled && quad_batch->is_usable ();
+    }
+
+    void Canvas_ES2::flush ()
+    {
+        flush_queue ();
+
+        Canvas::flush ();
+    }
+
     void Canvas_ES2::set_size (const Size2u & new_viewport_size)
     {
+        flush_queue ();
+
         size.width  = float(new_viewport_size.width );
         size.height = float(new_viewport_size.height);
         half_size   = size * 0.5f;
+
+        render_queue->set_area (size);
+
         projection  = translate_then_scale_2d (Vector2f{ -half_size.width, -half_size.height }, 2.f / size.width, 2.f / size.height);
 
-        shader_program_f->use ();
         shader_program_f->set_uniform_value (projection_f_id, projection.matrix);
-
-        shader_program_t->use ();
         shader_program_t->set_uniform_value (projection_t_id, projection.matrix);
     }
 
@@ -182,96 +215,116 @@ namespace basics { namespace opengles
         glClearColor (r, g, b, 1.f);
     }
 
-    void Canvas_ES2::set_opacity (float opacity)
+    void Canvas_ES2::set_opacity (float new_opacity)
     {
-        shader_program_f->use ();
+        // Los quads texturizados guardan su propia opacidad al añadirse a la cola:
+
+        opacity = new_opacity;
+
         shader_program_f->set_uniform_value (opacity_f_id, opacity);
-        shader_program_t->use ();
-        shader_program_t->set_uniform_value (opacity_t_id, opacity);
+    }
+
+    void Canvas_ES2::set_blending (Blending new_blending)
+    {
+        // El blending se aplica al dibujar, ya que los quads de la cola pueden usar otro:
+
+        blending = new_blending;
+    }
+
+    void Canvas_ES2::set_layer (unsigned new_layer)
+    {
+        layer = new_layer;
     }
 
     void Canvas_ES2::set_color (float r, float g, float b)
     {
-        shader_program_f->use ();
         shader_program_f->set_uniform_value (color_f_id, Vector3f{ r, g, b });
     }
 
     void Canvas_ES2::set_transform (const Transformation2f & new_transform)
     {
+        // Los quads texturizados se transforman al añadirse a la cola:
+
         transform = new_transform;
 
-        shader_program_f->use ();
         shader_program_f->set_uniform_value (transform_f_id, transform.matrix);
-
-        shader_program_t->use ();
-        shader_program_t->set_uniform_value (transform_t_id, transform.matrix);
     }
 
     void Canvas_ES2::apply_transform (const Transformation2f & t)
     {
         transform = t * transform;
 
-        shader_program_f->use ();
         shader_program_f->set_uniform_value (transform_f_id, transform.matrix);
-
-        shader_program_t->use ();
-        shader_program_t->set_uniform_value (transform_t_id, transform.matrix);
     }
 
     void Canvas_ES2::clear ()
     {
+        // Lo que quede en la cola quedaría tapado, así que se descarta sin dibujarlo:
+
+        render_queue->clear ();
+
         glClear (GL_COLOR_BUFFER_BIT);
     }
 
     void Canvas_ES2::draw_point (const Point2f & position)
     {
-        shader_program_f->use ();
+        flush_queue ();
+
+        use_program_f ();
+
+        glVertexAttribPointer (vertex_position_location_f, 2, GL_FLOAT, GL_FALSE, 0, position.coordinates);
+        glDrawArrays          (GL_POINTS, 0, 1);
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, position.coordinates);
-        glDrawArrays               (GL_POINTS, 0, 1);
+        frame_statistics.draw_calls++;
     }
 
     void Canvas_ES2::draw_segment (const Point2f & a, const Point2f & b)
     {
-        shader_program_f->use ();
+        flush_queue ();
+
+        use_program_f ();
 
         const Point2f coordinates[] = { a, b };
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-        glDrawArrays               (GL_LINES, 0, 2);
+        glVertexAttribPointer (vertex_position_location_f, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
+        glDrawArrays          (GL_LINES, 0, 2);
+
+        frame_statistics.draw_calls++;
     }
 
     void Canvas_ES2::draw_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
     {
-        shader_program_f->use ();
+        flush_queue ();
+
+        use_program_f ();
 
         const Point2f coordinates[] = { a, b, c, a };
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-        glDrawArrays               (GL_LINE_STRIP, 0, 4);
+        glVertexAttribPointer (vertex_position_location_f, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
+        glDrawArrays          (GL_LINE_STRIP, 0, 4);
+
+        frame_statistics.draw_calls++;
     }
 
     void Canvas_ES2::fill_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
     {
-        shader_program_f->use ();
+        flush_queue ();
+
+        use_program_f ();
 
         const Point2f coordinates[] = { a, b, c };
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-        glDrawArrays               (GL_TRIANGLES, 0, 3);
+        glVertexAttribPointer (vertex_position_location_f, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
+        glDrawArrays          (GL_TRIANGLES, 0, 3);
+
+        frame_statistics.draw_calls++;
     }
 
     void Canvas_ES2::draw_rectangle (const Point2f & bottom_left, const Size2f & size)
     {
-        shader_program_f->use ();
+        flush_queue ();
+
+        use_program_f ();
 
         Point2f top_right{ bottom_left.coordinates.x () + size.width, bottom_left.coordinates.y () + size.height };
 
@@ -284,15 +337,17 @@ namespace basics { namespace opengles
               bottom_left
         };
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-        glDrawArrays               (GL_LINE_STRIP, 0, 5);
+        glVertexAttribPointer (vertex_position_location_f, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
+        glDrawArrays          (GL_LINE_STRIP, 0, 5);
+
+        frame_statistics.draw_calls++;
     }
 
     void Canvas_ES2::fill_rectangle (const Point2f & bottom_left, const Size2f & size)
     {
-        shader_program_f->use ();
+        flush_queue ();
+
+        use_program_f ();
 
         Point2f top_right{ bottom_left.coordinates.x () + size.width, bottom_left.coordinates.y () + size.height };
 
@@ -304,14 +359,16 @@ namespace basics { namespace opengles
                 top_right,
         };
 
-        glEnableVertexAttribArray  (0);
-        glDisableVertexAttribArray (1);
-        glVertexAttribPointer      (0, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-        glDrawArrays               (GL_TRIANGLE_STRIP, 0, 4);
+        glVertexAttribPointer (vertex_position_location_f, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
+        glDrawArrays          (GL_TRIANGLE_STRIP, 0, 4);
+
+        frame_statistics.draw_calls++;
     }
 
     void Canvas_ES2::fill_rectangle (const Point2f & where, const Size2f & size, const basics::Texture_2D * texture, int handling)
     {
+        BASICS_PROFILE_ZONE ("Canvas_ES2::fill_rectangle");
+
         const opengles::Texture_2D * opengl_es_texture = dynamic_cast< const opengles::Texture_2D * >(texture);
 
         if (opengl_es_texture)
@@ -356,19 +413,14 @@ namespace basics { namespace opengles
                     top_right,
             };
 
-            opengl_es_texture->use ();
-            shader_program_t ->use ();
-
-            glEnableVertexAttribArray (  vertex_position_location_t);
-            glEnableVertexAttribArray (vertex_texture_uv_location_t);
-            glVertexAttribPointer     (  vertex_position_location_t, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-            glVertexAttribPointer     (vertex_texture_uv_location_t, 2, GL_FLOAT, GL_FALSE, 0, texture_uvs);
-            glDrawArrays              (GL_TRIANGLE_STRIP, 0, 4);
+            draw_textured_quad (opengl_es_texture, coordinates, texture_uvs);
         }
     }
 
     void Canvas_ES2::fill_rectangle (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling)
     {
+        BASICS_PROFILE_ZONE ("Canvas_ES2::fill_rectangle");
+
         if (!slice || !slice->atlas)
         {
             return;
@@ -378,20 +430,15 @@ namespace basics { namespace opengles
 
         if (opengl_es_texture)
         {
-            float   horizontal_ratio  = 1.f / opengl_es_texture->get_width  ();
-            float     vertical_ratio  = 1.f / opengl_es_texture->get_height ();
-            float   normalized_left   = slice->left   * horizontal_ratio;
-            float   normalized_right  = slice->right  * horizontal_ratio;
-            float   normalized_top    = slice->top    *   vertical_ratio;
-            float   normalized_bottom = slice->bottom *   vertical_ratio;
+            // Las coordenadas normalizadas del slice se calculan al asignar la textura al atlas:
 
             Point2f bottom_left;
             Point2f texture_uvs[] =
             {
-                { normalized_left,  normalized_top    },
-                { normalized_left,  normalized_bottom },
-                { normalized_right, normalized_top    },
-                { normalized_right, normalized_bottom },
+                { slice->normalized_left,  slice->normalized_top    },
+                { slice->normalized_left,  slice->normalized_bottom },
+                { slice->normalized_right, slice->normalized_top    },
+                { slice->normalized_right, slice->normalized_bottom },
             };
 
             switch (handling & 0x03)
@@ -434,15 +481,161 @@ namespace basics { namespace opengles
                     top_right,
             };
 
-            opengl_es_texture->use ();
-            shader_program_t ->use ();
+            draw_textured_quad (opengl_es_texture, coordinates, texture_uvs);
+        }
+    }
+
+    void Canvas_ES2::draw_textured_quad (const Texture_2D * texture, const Point2f * coordinates, const Point2f * texture_uvs)
+    {
+        frame_statistics.quads++;
+
+        if (batching)
+        {
+            // Los vértices se transforman en la CPU para que los quads con distinta transformación
+            // puedan compartir lote. La cola los reordena y agrupa al volcarse:
+
+            const Transformation2f::Matrix & matrix = transform.matrix;
+
+            Render_Queue::Quad quad;
+
+            for (unsigned index = 0; index < 4; ++index)
+            {
+                float x = coordinates[index][0];
+                float y = coordinates[index][1];
+
+                quad.vertices[index] =
+                {
+                    matrix[0][0] * x + matrix[0][1] * y + matrix[0][2],
+                    matrix[1][0] * x + matrix[1][1] * y + matrix[1][2],
+                    texture_uvs[index][0],
+                    texture_uvs[index][1]
+                };
+            }
+
+            quad.texture  = texture;
+            quad.program  = shader_program_t.get ();
+            quad.blending = blending;
+            quad.opacity  = opacity;
+
+            render_queue->add (layer, quad);
+        }
+        else
+        {
+            apply_blending (blending);
+
+            shader_program_t->set_uniform_value (transform_t_id, transform.matrix);
+            shader_program_t->set_uniform_value (  opacity_t_id, opacity);
+
+            texture->use ();
+
+            use_program_t ();
+
+            glVertexAttribPointer (  vertex_position_location_t, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
+            glVertexAttribPointer (vertex_texture_uv_location_t, 2, GL_FLOAT, GL_FALSE, 0, texture_uvs);
+            glDrawArrays          (GL_TRIANGLE_STRIP, 0, 4);
+
+            frame_statistics.batches++;
+            frame_statistics.draw_calls++;
+        }
+    }
+
+    void Canvas_ES2::flush_queue ()
+    {
+        BASICS_PROFILE_ZONE ("Canvas_ES2::flush_queue");
+
+        if (render_queue->is_empty ())
+        {
+            return;
+        }
+
+        render_queue->sort ();
+
+        // Se recorren los quads ya ordenados y se abre un lote nuevo cada vez que cambia el estado
+        // (o cuando el lote se llena):
+
+        const Render_Queue::Quad * previous = nullptr;
+
+        for (unsigned index = 0, count = render_queue->size (); index < count; ++index)
+        {
+            const Render_Queue::Quad & quad = (*render_queue)[index];
+
+            bool state_changed = !previous
+                || quad.texture  != previous->texture
+                || quad.program  != previous->program
+                || quad.blending != previous->blending
+                || quad.opacity  != previous->opacity;
+
+            if (state_changed || quad_batch->is_full ())
+            {
+                draw_quad_batch ();
+
+                apply_blending (quad.blending);
 
-            glEnableVertexAttribArray (  vertex_position_location_t);
-            glEnableVertexAttribArray (vertex_texture_uv_location_t);
-            glVertexAttribPointer     (  vertex_position_location_t, 2, GL_FLOAT, GL_FALSE, 0, coordinates);
-            glVertexAttribPointer     (vertex_texture_uv_location_t, 2, GL_FLOAT, GL_FALSE, 0, texture_uvs);
-            glDrawArrays              (GL_TRIANGLE_STRIP, 0, 4);
+                quad.program->set_uniform_value (transform_t_id, Transformation2f().matrix);
+                quad.program->set_uniform_value (  opacity_t_id, quad.opacity);
+
+                quad.texture->use ();
+
+                use_program_t ();
+            }
+
+            quad_batch->add (quad.vertices);
+
+            previous = &quad;
+        }
+
+        draw_quad_batch ();
+
+        render_queue->clear ();
+    }
+
+    void Canvas_ES2::draw_quad_batch ()
+    {
+        if (!quad_batch->is_empty ())
+        {
+            BASICS_PROFILE_ZONE ("Canvas_ES2::draw_quad_batch");
+
+            unsigned draw_calls = quad_batch->flush (vertex_position_location_t, vertex_texture_uv_location_t);
+
+            frame_statistics.batches    += draw_calls;
+            frame_statistics.draw_calls += draw_calls;
+        }
+    }
+
+    void Canvas_ES2::apply_blending (Blending mode)
+    {
+        switch (mode)
+        {
+            case NONE:         GL_State::set_blending (false); break;
+            case TRANSPARENCY: GL_State::set_blending (true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); break;
+            case MULTIPLY:     GL_State::set_blending (true, GL_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA); break;
+            case ADD:          GL_State::set_blending (true, GL_SRC_ALPHA, GL_ONE                ); break;
         }
     }
 
+    void Canvas_ES2::use_program_f ()
+    {
+        // Las primitivas sin textura usan arrays de vértices en memoria de la CPU:
+
+        apply_blending (blending);
+
+        GL_State::bind_array_buffer (0);
+
+        shader_program_f->use ();
+
+        GL_State::set_vertex_attribute_arrays (1u << vertex_position_location_f);
+    }
+
+    void Canvas_ES2::use_program_t ()
+    {
+        // Quad_Batch vincula su propio vertex buffer al volcarse. Los quads que se dibujan de
+        // inmediato usan arrays de vértices en memoria de la CPU:
+
+        if (!batching) GL_State::bind_array_buffer (0);
+
+        shader_program_t->use ();
+
+        GL_State::set_vertex_attribute_arrays ((1u << vertex_position_location_t) | (1u << vertex_texture_uv_location_t));
+    }
+
 }}
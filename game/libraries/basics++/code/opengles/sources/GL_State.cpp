@@ -0,0 +1,215 @@
+/*
+ * GL STATE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <basics/opengles/GL_State>
+
+namespace basics { namespace opengles
+{
+
+    // Valor que se guarda en la copia del estado cuando no se sabe qué objeto hay vinculado:
+
+    static constexpr GLuint unknown_object = ~GLuint(0);
+
+    bool               GL_State::valid                      = false;
+    GLenum             GL_State::active_texture_unit        = GL_NONE;
+    GLuint             GL_State::bound_texture              = unknown_object;
+    GLuint             GL_State::used_program               = unknown_object;
+    GLuint             GL_State::bound_array_buffer         = unknown_object;
+    GLuint             GL_State::bound_element_array_buffer = unknown_object;
+    unsigned           GL_State::enabled_vertex_attributes  = 0;
+    unsigned           GL_State::unknown_vertex_attributes  = 0;
+    bool               GL_State::blending_known             = false;
+    bool               GL_State::blending_enabled           = false;
+    GLenum             GL_State::blending_source_factor     = GL_NONE;
+    GLenum             GL_State::blending_target_factor     = GL_NONE;
+    GL_State::Statistics GL_State::statistics               = { 0, 0 };
+    GL_State::Statistics GL_State::frame_statistics         = { 0, 0 };
+
+    // ---------------------------------------------------------------------------------------------
+
+    void GL_State::revalidate ()
+    {
+        active_texture_unit        = GL_NONE;
+        bound_texture              = unknown_object;
+        used_program               = unknown_object;
+        bound_array_buffer         = unknown_object;
+        bound_element_array_buffer = unknown_object;
+        unknown_vertex_attributes  = (1u << max_vertex_attributes) - 1;
+        blending_known             = false;
+        blending_source_factor     = GL_NONE;
+        blending_target_factor     = GL_NONE;
+
+        valid = true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void GL_State::set_active_texture_unit (GLenum unit)
+    {
+        if (!valid) revalidate ();
+
+        if (unit != active_texture_unit)
+        {
+            glActiveTexture (unit);
+
+            // Cada unidad tiene su propia textura vinculada, que no se conoce:
+
+            active_texture_unit = unit;
+            bound_texture       = unknown_object;
+
+            count_issued_call ();
+        }
+        else
+            count_elided_call ();
+    }
+
+    void GL_State::bind_texture (GLuint texture_object_id)
+    {
+        if (!valid) revalidate ();
+
+        if (texture_object_id != bound_texture)
+        {
+            glBindTexture (GL_TEXTURE_2D, bound_texture = texture_object_id);
+
+            count_issued_call ();
+        }
+        else
+            count_elided_call ();
+    }
+
+    void GL_State::use_program (GLuint program_object_id)
+    {
+        if (!valid) revalidate ();
+
+        if (program_object_id != used_program)
+        {
+            glUseProgram (used_program = program_object_id);
+
+            count_issued_call ();
+        }
+        else
+            count_elided_call ();
+    }
+
+    void GL_State::bind_array_buffer (GLuint buffer_id)
+    {
+        if (!valid) revalidate ();
+
+        if (buffer_id != bound_array_buffer)
+        {
+            glBindBuffer (GL_ARRAY_BUFFER, bound_array_buffer = buffer_id);
+
+            count_issued_call ();
+        }
+        else
+            count_elided_call ();
+    }
+
+    void GL_State::bind_element_array_buffer (GLuint buffer_id)
+    {
+        if (!valid) revalidate ();
+
+        if (buffer_id != bound_element_array_buffer)
+        {
+            glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, bound_element_array_buffer = buffer_id);
+
+            count_issued_call ();
+        }
+        else
+            count_elided_call ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void GL_State::set_vertex_attribute_arrays (unsigned mask)
+    {
+        if (!valid) revalidate ();
+
+        unsigned changes = (mask ^ enabled_vertex_attributes) | unknown_vertex_attributes;
+
+        for (unsigned index = 0; index < max_vertex_attributes; ++index)
+        {
+            unsigned bit = 1u << index;
+
+            if (changes & bit)
+            {
+                if (mask & bit) glEnableVertexAttribArray  (index);
+                else            glDisableVertexAttribArray (index);
+
+                count_issued_call ();
+            }
+            else if (mask & bit)
+            {
+                count_elided_call ();
+            }
+        }
+
+        enabled_vertex_attributes = mask;
+        unknown_vertex_attributes = 0;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void GL_State::set_blending (bool enabled, GLenum source_factor, GLenum target_factor)
+    {
+        if (!valid) revalidate ();
+
+        if (!blending_known || enabled != blending_enabled)
+        {
+            if (enabled) glEnable  (GL_BLEND);
+            else         glDisable (GL_BLEND);
+
+            blending_known   = true;
+            blending_enabled = enabled;
+
+            count_issued_call ();
+        }
+        else
+            count_elided_call ();
+
+        // Los factores solo se envían cuando van a tener efecto:
+
+        if (enabled)
+        {
+            if (source_factor != blending_source_factor || target_factor != blending_target_factor)
+            {
+                glBlendFunc (blending_source_factor = source_factor, blending_target_factor = target_factor);
+
+                count_issued_call ();
+            }
+            else
+                count_elided_call ();
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void GL_State::forget_texture (GLuint texture_object_id)
+    {
+        // Al eliminar la textura vinculada OpenGL vincula la textura 0:
+
+        if (bound_texture == texture_object_id) bound_texture = 0;
+    }
+
+    void GL_State::forget_program (GLuint program_object_id)
+    {
+        // Un programa en uso no se elimina hasta que deja de usarse, por lo que se marca como
+        // desconocido para forzar el siguiente glUseProgram():
+
+        if (used_program == program_object_id) used_program = unknown_object;
+    }
+
+    void GL_State::forget_buffer (GLuint buffer_id)
+    {
+        if (bound_array_buffer         == buffer_id) bound_array_buffer         = 0;
+        if (bound_element_array_buffer == buffer_id) bound_element_array_buffer = 0;
+    }
+
+}}
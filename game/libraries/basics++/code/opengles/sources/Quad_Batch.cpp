@@ -0,0 +1,102 @@
+/*
+ * QUAD BATCH
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <cstddef>
+#include <basics/assert>
+#include <basics/opengles/GL_State>
+#include <basics/opengles/Quad_Batch>
+
+namespace basics { namespace opengles
+{
+
+    bool Quad_Batch::initialize ()
+    {
+        if (!initialized)
+        {
+            // Se generan de antemano los índices de todos los quads posibles. Cada quad se dibuja
+            // como dos triángulos que comparten la diagonal (1, 2):
+
+            std::vector< GLushort > indices(max_quads * 6);
+
+            for (unsigned quad = 0, vertex = 0; quad < max_quads; ++quad, vertex += 4)
+            {
+                GLushort * index = &indices[quad * 6];
+
+                index[0] = GLushort(vertex + 0);
+                index[1] = GLushort(vertex + 1);
+                index[2] = GLushort(vertex + 2);
+                index[3] = GLushort(vertex + 2);
+                index[4] = GLushort(vertex + 1);
+                index[5] = GLushort(vertex + 3);
+            }
+
+            glGenBuffers (1, &vertex_buffer_id);
+            glGenBuffers (1, & index_buffer_id);
+
+            GL_State::bind_element_array_buffer (index_buffer_id);
+            glBufferData (GL_ELEMENT_ARRAY_BUFFER, indices.size () * sizeof(GLushort), indices.data (), GL_STATIC_DRAW);
+
+            GL_State::bind_array_buffer (vertex_buffer_id);
+            glBufferData (GL_ARRAY_BUFFER, max_quads * 4 * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+            GL_State::bind_array_buffer (0);
+
+            initialized = glGetError () == GL_NO_ERROR;
+        }
+
+        return initialized;
+    }
+
+    void Quad_Batch::finalize ()
+    {
+        if (initialized)
+        {
+            GL_State::forget_buffer (vertex_buffer_id);
+            GL_State::forget_buffer ( index_buffer_id);
+
+            glDeleteBuffers (1, &vertex_buffer_id);
+            glDeleteBuffers (1, & index_buffer_id);
+
+            initialized = false;
+        }
+    }
+
+    unsigned Quad_Batch::flush (GLuint position_location, GLuint texture_uv_location)
+    {
+        if (vertices.empty ())
+        {
+            return 0;
+        }
+
+        assert(is_usable ());
+
+        GLsizei quad_count = GLsizei(vertices.size () / 4);
+
+        GL_State::bind_array_buffer         (vertex_buffer_id);
+        GL_State::bind_element_array_buffer ( index_buffer_id);
+
+        // Se descarta el contenido anterior del buffer antes de reescribirlo para que el driver no
+        // tenga que esperar a que la GPU termine de leerlo:
+
+        glBufferData    (GL_ARRAY_BUFFER, max_quads * 4 * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+        glBufferSubData (GL_ARRAY_BUFFER, 0, vertices.size () * sizeof(Vertex), vertices.data ());
+
+        glVertexAttribPointer (  position_location, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast< const void * >(offsetof(Vertex, x)));
+        glVertexAttribPointer (texture_uv_location, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast< const void * >(offsetof(Vertex, u)));
+        glDrawElements        (GL_TRIANGLES, quad_count * 6, GL_UNSIGNED_SHORT, nullptr);
+
+        // Los buffers se quedan vinculados. Quien vaya a dibujar con arrays de vértices en memoria
+        // de la CPU debe desvincular antes el vertex buffer con GL_State::bind_array_buffer (0).
+
+        vertices.clear ();
+
+        return 1;
+    }
+
+}}
@@ -0,0 +1,208 @@
+/*
+ * RENDER QUEUE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <basics/opengles/Render_Queue>
+
+namespace basics { namespace opengles
+{
+
+    Render_Queue::Render_Queue()
+    :
+        area{ 1.f, 1.f }
+    {
+        quads         .reserve (initial_capacity);
+        entries       .reserve (initial_capacity);
+        sorted_entries.reserve (initial_capacity);
+        textures      .reserve (16);
+        programs      .reserve (16);
+
+        clear ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::add (unsigned layer, const Quad & quad)
+    {
+        uint32_t state = make_state   (quad);
+        unsigned depth = assign_depth (quad, state);
+
+        uint64_t key = uint64_t(std::min (layer, 0xFFu   )) << 56
+                     | uint64_t(std::min (depth, 0xFFFFu )) << 40
+                     | uint64_t(state                     ) <<  8;
+
+        entries.push_back ({ key, unsigned(quads.size ()) });
+        quads  .push_back (quad);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::sort ()
+    {
+        // Ordenación por radix LSD de 8 bits por pasada. Cada pasada es estable, por lo que el
+        // resultado final también lo es. Se omiten las pasadas en las que todas las claves tienen
+        // el mismo valor en el byte correspondiente (algo habitual en la capa y la profundidad):
+
+        unsigned count = unsigned(entries.size ());
+
+        if (count == 0) return;
+
+        sorted_entries.resize (count);
+
+        Entry_List * source = &entries;
+        Entry_List * target = &sorted_entries;
+
+        for (unsigned shift = 8; shift < 64; shift += 8)
+        {
+            unsigned histogram[256] = { };
+
+            for (const Entry & entry : *source)
+            {
+                histogram[(entry.key >> shift) & 0xFF]++;
+            }
+
+            if (histogram[((*source)[0].key >> shift) & 0xFF] == count)
+            {
+                continue;
+            }
+
+            for (unsigned bucket = 0, offset = 0; bucket < 256; ++bucket)
+            {
+                unsigned bucket_size = histogram[bucket];
+
+                histogram[bucket] = offset;
+                offset += bucket_size;
+            }
+
+            for (const Entry & entry : *source)
+            {
+                (*target)[histogram[(entry.key >> shift) & 0xFF]++] = entry;
+            }
+
+            std::swap (source, target);
+        }
+
+        if (source != &sorted_entries)
+        {
+            sorted_entries.swap (entries);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Render_Queue::clear ()
+    {
+        quads         .clear ();
+        entries       .clear ();
+        sorted_entries.clear ();
+        textures      .clear ();
+        programs      .clear ();
+
+        std::fill_n (cells, grid_size * grid_size, Cell{ 0, empty_state });
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    uint32_t Render_Queue::make_state (const Quad & quad)
+    {
+        // Las texturas y los shader programs se numeran en el orden en que aparecen en el fotograma:
+
+        auto texture = std::find (textures.begin (), textures.end (), quad.texture);
+        auto program = std::find (programs.begin (), programs.end (), quad.program);
+
+        uint32_t texture_index = uint32_t(texture - textures.begin ());
+        uint32_t program_index = uint32_t(program - programs.begin ());
+
+        if (texture == textures.end ()) textures.push_back (quad.texture);
+        if (program == programs.end ()) programs.push_back (quad.program);
+
+        uint32_t opacity = uint32_t(std::max (0.f, std::min (1.f, quad.opacity)) * 255.f + .5f);
+
+        // blending (2 bits) | program (6 bits) | textura (16 bits) | opacidad (8 bits)
+
+        return uint32_t(quad.blending & 0x3) << 30
+             | std::min (program_index, 0x3Fu  ) << 24
+             | std::min (texture_index, 0xFFFFu) <<  8
+             | opacity;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    unsigned Render_Queue::assign_depth (const Quad & quad, uint32_t state)
+    {
+        float left   = quad.vertices[0].x, right = left;
+        float bottom = quad.vertices[0].y, top   = bottom;
+
+        for (unsigned index = 1; index < 4; ++index)
+        {
+            left   = std::min (left,   quad.vertices[index].x);
+            right  = std::max (right,  quad.vertices[index].x);
+            bottom = std::min (bottom, quad.vertices[index].y);
+            top    = std::max (top,    quad.vertices[index].y);
+        }
+
+        // Las celdas cubren el área de dibujo y los quads que se salen se asignan a las celdas del
+        // borde, lo cual solo puede provocar solapamientos de más (nunca de menos):
+
+        auto cell_index = [] (float coordinate, float extent) -> int
+        {
+            int index = int(std::floor (coordinate / extent * grid_size));
+
+            return std::max (0, std::min (index, int(grid_size) - 1));
+        };
+
+        int first_column = cell_index (left,   area.width );
+        int last_column  = cell_index (right,  area.width );
+        int first_row    = cell_index (bottom, area.height);
+        int last_row     = cell_index (top,    area.height);
+
+        // El quad tiene que quedar por encima de cualquier quad anterior con distinto estado con el
+        // que pueda solaparse. Con el mismo estado basta con no quedar por debajo, ya que la
+        // ordenación estable mantiene el orden original entre claves iguales:
+
+        unsigned depth = 0;
+
+        for (int row = first_row; row <= last_row; ++row)
+        {
+            for (int column = first_column; column <= last_column; ++column)
+            {
+                const Cell & cell = cells[row * grid_size + column];
+
+                if (cell.state != empty_state)
+                {
+                    depth = std::max (depth, cell.depth + (cell.state != state ? 1 : 0));
+                }
+            }
+        }
+
+        for (int row = first_row; row <= last_row; ++row)
+        {
+            for (int column = first_column; column <= last_column; ++column)
+            {
+                Cell & cell = cells[row * grid_size + column];
+
+                if (cell.state == empty_state || depth > cell.depth)
+                {
+                    cell.depth = depth;
+                    cell.state = state;
+                }
+                else
+                if (depth == cell.depth && cell.state != state)
+                {
+                    cell.state = mixed_state;
+                }
+            }
+        }
+
+        return depth;
+    }
+
+}}
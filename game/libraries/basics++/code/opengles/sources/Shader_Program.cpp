@@ -8,6 +8,7 @@
  * angel.rodriguez@esne.edu
  */
 
+#include <algorithm>
 #include <basics/opengles/Fragment_Shader>
 #include <basics/opengles/OpenGL_ES2>
 #include <basics/opengles/Shader_Program>
@@ -47,7 +48,17 @@ namespace basics { namespace opengles
                     glAttachShader (program_object_id, *shaders[i]);
                 }
 
-                return (initialized = link ());         // EN CASO DE FALLO HAY QUE LIBERAR EL OBJETO SHADER PROGRAM (LOS SHADERS SE LIBERAN CON SHARED_PTR)
+                initialized = link ();                  // EN CASO DE FALLO HAY QUE LIBERAR EL OBJETO SHADER PROGRAM (LOS SHADERS SE LIBERAN CON SHARED_PTR)
+
+                // Si el programa se ha vuelto a crear (por ejemplo, tras perder el contexto), los
+                // valores de los uniforms que se asignaron antes se tienen que volver a enviar:
+
+                for (auto & uniform : uniform_values)
+                {
+                    if (uniform.type != Uniform_Value::UNDEFINED) uniform.dirty = dirty_uniforms = true;
+                }
+
+                return initialized;
             }
         }
 
@@ -85,4 +96,103 @@ namespace basics { namespace opengles
         return succeeded != 0;
     }
 
+    Shader_Program::Uniform_Value & Shader_Program::get_uniform (GLint uniform_id) const
+    {
+        // Los ids son valores que asigna el driver y pueden ser grandes, por lo que no se usan
+        // como índices. Un programa tiene pocos uniforms y la búsqueda binaria es suficiente:
+
+        Uniform_Value_List::iterator uniform = std::lower_bound
+        (
+            uniform_values.begin (),
+            uniform_values.end   (),
+            uniform_id,
+            [] (const Uniform_Value & uniform, GLint location) { return uniform.location < location; }
+        );
+
+        if (uniform == uniform_values.end () || uniform->location != uniform_id)
+        {
+            uniform = uniform_values.insert (uniform, Uniform_Value{ uniform_id, Uniform_Value::UNDEFINED, 0, 0, { }, false });
+        }
+
+        return *uniform;
+    }
+
+    void Shader_Program::store_uniform (GLint uniform_id, Uniform_Value::Type type, const GLfloat * values, GLsizei count) const
+    {
+        if (uniform_id < 0) return;
+
+        Uniform_Value & uniform = get_uniform (uniform_id);
+
+        if (uniform.type == type && uniform.count == count && std::equal (values, values + count, uniform.values))
+        {
+            if (!uniform.dirty) GL_State::count_elided_call ();
+        }
+        else
+        {
+            uniform.type  = type;
+            uniform.count = count;
+            uniform.dirty = dirty_uniforms = true;
+
+            std::copy_n (values, count, uniform.values);
+        }
+    }
+
+    void Shader_Program::store_uniform (GLint uniform_id, GLint value) const
+    {
+        if (uniform_id < 0) return;
+
+        Uniform_Value & uniform = get_uniform (uniform_id);
+
+        if (uniform.type == Uniform_Value::INTEGER && uniform.integer == value)
+        {
+            if (!uniform.dirty) GL_State::count_elided_call ();
+        }
+        else
+        {
+            uniform.type    = Uniform_Value::INTEGER;
+            uniform.integer = value;
+            uniform.dirty   = dirty_uniforms = true;
+        }
+    }
+
+    void Shader_Program::upload_uniforms () const
+    {
+        // El programa tiene que estar en uso:
+
+        for (Uniform_Value & uniform : uniform_values)
+        {
+            if (uniform.dirty)
+            {
+                const GLint     uniform_id = uniform.location;
+                const GLfloat * values     = uniform.values;
+
+                switch (uniform.type)
+                {
+                    case Uniform_Value::INTEGER:  glUniform1i (uniform_id, uniform.integer); break;
+                    case Uniform_Value::MATRIX_2: glUniformMatrix2fv (uniform_id, 1, GL_FALSE, values); break;
+                    case Uniform_Value::MATRIX_3: glUniformMatrix3fv (uniform_id, 1, GL_FALSE, values); break;
+                    case Uniform_Value::MATRIX_4: glUniformMatrix4fv (uniform_id, 1, GL_FALSE, values); break;
+                    case Uniform_Value::FLOATS:
+                    {
+                        switch (uniform.count)
+                        {
+                            case 1: glUniform1f (uniform_id, values[0]); break;
+                            case 2: glUniform2f (uniform_id, values[0], values[1]); break;
+                            case 3: glUniform3f (uniform_id, values[0], values[1], values[2]); break;
+                            case 4: glUniform4f (uniform_id, values[0], values[1], values[2], values[3]); break;
+                        }
+                        break;
+                    }
+                    case Uniform_Value::UNDEFINED: break;
+                }
+
+                uniform.dirty = false;
+
+                GL_State::count_issued_call ();
+            }
+        }
+
+        dirty_uniforms = false;
+    }
+
 }}
@@ -11,6 +11,8 @@
  */
 
 #include <basics/assert>
+#include <basics/Profiler>
+#include <basics/Startup_Timeline>
 #include <basics/opengles/Texture_2D>
 
 namespace basics { namespace opengles
@@ -25,13 +27,22 @@ namespace basics { namespace opengles
 
     bool Texture_2D::initialize ()
     {
+        BASICS_PROFILE_ZONE ("Texture_2D::initialize");
+
         if (!initialized)
         {
             if (color_buffer.size () > 0)
             {
+                BASICS_STARTUP_SPAN
+                (
+                    "upload " + std::to_string (color_buffer.get_width ()) + "x" + std::to_string (color_buffer.get_height ()) + " texture"
+                );
+
                 glEnable        (GL_TEXTURE_2D);////
                 glGenTextures   (1, &texture_object_id);
-                glBindTexture   (GL_TEXTURE_2D, texture_object_id);
+
+                GL_State::set_active_texture_unit (GL_TEXTURE0);
+                GL_State::bind_texture            (texture_object_id);
 
                 glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
                 glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -67,17 +78,16 @@ namespace basics { namespace opengles
     {
         assert(is_usable ());
 
-        //if (active_texture != this)
-        {
-            glBindTexture   (GL_TEXTURE_2D, texture_object_id);
-            glActiveTexture (GL_TEXTURE0);
+        // GL_State evita las llamadas cuando la textura ya está vinculada a la unidad 0:
 
-            active_texture  = this;
+        GL_State::set_active_texture_unit (GL_TEXTURE0);
+        GL_State::bind_texture            (texture_object_id);
 
-            return true;
-        }
+        bool changed = active_texture != this;
+
+        active_texture = this;
 
-        return false;
+        return changed;
     }
 
 }}
@@ -34,6 +34,16 @@ Rename this file to lodepng.cpp to use it for C++, or to lodepng.c to use it for
 #include <stdio.h>
 #include <stdlib.h>
 
+#ifdef LODEPNG_COMPILE_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LODEPNG_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define LODEPNG_NEON
+#include <arm_neon.h>
+#endif
+#endif /*LODEPNG_COMPILE_SIMD*/
+
 #if defined(_MSC_VER) && (_MSC_VER >= 1310) /*Visual Studio: A few warning types are not desired here.*/
 #pragma warning( disable : 4244 ) /*implicit conversions: not warned by gcc -Wall -Wextra and requires too much casts*/
 #pragma warning( disable : 4996 ) /*VS does not like fopen, but fopen_s is not standard C so unusable here*/
@@ -207,6 +217,7 @@ typedef struct ucvector
   unsigned char* data;
   size_t size; /*used size*/
   size_t allocsize; /*allocated size*/
+  unsigned fixed; /*if 1, data belongs to the caller and can't be reallocated (see lodepng_decode_into)*/
 } ucvector;
 
 /*returns 1 if success, 0 if failure ==> nothing done*/
@@ -214,8 +225,11 @@ static unsigned ucvector_reserve(ucvector* p, size_t allocsize)
 {
   if(allocsize > p->allocsize)
   {
-    size_t newsize = (allocsize > p->allocsize * 2) ? allocsize : (allocsize * 3 / 2);
-    void* data = lodepng_realloc(p->data, newsize);
+    size_t newsize;
+    void* data;
+    if(p->fixed) return 0; /*error: the buffer of the caller is too small*/
+    newsize = (allocsize > p->allocsize * 2) ? allocsize : (allocsize * 3 / 2);
+    data = lodepng_realloc(p->data, newsize);
     if(data)
     {
       p->allocsize = newsize;
@@ -247,6 +261,7 @@ static void ucvector_init(ucvector* p)
 {
   p->data = NULL;
   p->size = p->allocsize = 0;
+  p->fixed = 0;
 }
 #endif /*LODEPNG_COMPILE_PNG*/
 
@@ -257,6 +272,7 @@ static void ucvector_init_buffer(ucvector* p, unsigned char* buffer, size_t size
 {
   p->data = buffer;
   p->allocsize = p->size = size;
+  p->fixed = 0;
 }
 #endif /*LODEPNG_COMPILE_ZLIB*/
 
@@ -508,7 +524,7 @@ Huffman tree struct, containing multiple representations of the tree
 */
 typedef struct HuffmanTree
 {
-  unsigned* tree2d;
+  unsigned* table; /*lookup table used by the decoder, see HuffmanTree_makeTable*/
   unsigned* tree1d;
   unsigned* lengths; /*the lengths of the codes of the 1d-tree*/
   unsigned maxbitlen; /*maximum number of bits a single code can get*/
@@ -530,79 +546,18 @@ static void HuffmanTree_draw(HuffmanTree* tree)
 
 static void HuffmanTree_init(HuffmanTree* tree)
 {
-  tree->tree2d = 0;
+  tree->table = 0;
   tree->tree1d = 0;
   tree->lengths = 0;
 }
 
 static void HuffmanTree_cleanup(HuffmanTree* tree)
 {
-  lodepng_free(tree->tree2d);
+  lodepng_free(tree->table);
   lodepng_free(tree->tree1d);
   lodepng_free(tree->lengths);
 }
 
-/*the tree representation used by the decoder. return value is error*/
-static unsigned HuffmanTree_make2DTree(HuffmanTree* tree)
-{
-  unsigned nodefilled = 0; /*up to which node it is filled*/
-  unsigned treepos = 0; /*position in the tree (1 of the numcodes columns)*/
-  unsigned n, i;
-
-  tree->tree2d = (unsigned*)lodepng_malloc(tree->numcodes * 2 * sizeof(unsigned));
-  if(!tree->tree2d) return 83; /*alloc fail*/
-
-  /*
-  convert tree1d[] to tree2d[][]. In the 2D array, a value of 32767 means
-  uninited, a value >= numcodes is an address to another bit, a value < numcodes
-  is a code. The 2 rows are the 2 possible bit values (0 or 1), there are as
-  many columns as codes - 1.
-  A good huffman tree has N * 2 - 1 nodes, of which N - 1 are internal nodes.
-  Here, the internal nodes are stored (what their 0 and 1 option point to).
-  There is only memory for such good tree currently, if there are more nodes
-  (due to too long length codes), error 55 will happen
-  */
-  for(n = 0; n < tree->numcodes * 2; ++n)
-  {
-    tree->tree2d[n] = 32767; /*32767 here means the tree2d isn't filled there yet*/
-  }
-
-  for(n = 0; n < tree->numcodes; ++n) /*the codes*/
-  {
-    for(i = 0; i != tree->lengths[n]; ++i) /*the bits for this code*/
-    {
-      unsigned char bit = (unsigned char)((tree->tree1d[n] >> (tree->lengths[n] - i - 1)) & 1);
-      /*oversubscribed, see comment in lodepng_error_text*/
-      if(treepos > 2147483647 || treepos + 2 > tree->numcodes) return 55;
-      if(tree->tree2d[2 * treepos + bit] == 32767) /*not yet filled in*/
-      {
-        if(i + 1 == tree->lengths[n]) /*last bit*/
-        {
-          tree->tree2d[2 * treepos + bit] = n; /*put the current code in it*/
-          treepos = 0;
-        }
-        else
-        {
-          /*put address of the next step in here, first that address has to be found of course
-          (it's just nodefilled + 1)...*/
-          ++nodefilled;
-          /*addresses encoded with numcodes added to it*/
-          tree->tree2d[2 * treepos + bit] = nodefilled + tree->numcodes;
-          treepos = nodefilled;
-        }
-      }
-      else treepos = tree->tree2d[2 * treepos + bit] - tree->numcodes;
-    }
-  }
-
-  for(n = 0; n < tree->numcodes * 2; ++n)
-  {
-    if(tree->tree2d[n] == 32767) tree->tree2d[n] = 0; /*remove possible remaining 32767's*/
-  }
-
-  return 0;
-}
-
 /*
 Second step for the ...makeFromLengths and ...makeFromFrequencies functions.
 numcodes, lengths and maxbitlen must already be filled in correctly. return
@@ -644,8 +599,7 @@ static unsigned HuffmanTree_makeFromLengths2(HuffmanTree* tree)
   uivector_cleanup(&blcount);
   uivector_cleanup(&nextcode);
 
-  if(!error) return HuffmanTree_make2DTree(tree);
-  else return error;
+  return error;
 }
 
 /*
@@ -940,6 +894,165 @@ static unsigned generateFixedDistanceTree(HuffmanTree* tree)
 
 #ifdef LODEPNG_COMPILE_DECODER
 
+/*
+The decoder doesn't walk the tree bit by bit, it looks up the next HUFFMAN_FIRSTBITS bits of the stream in a table
+instead. Codes longer than that continue in a second level table. Each entry has the symbol (or the start of the
+second level table) in bits 0-15 and the number of bits to consume (or the index bits of the second level table)
+in bits 24-28. In the literal/length tree, an entry can also hold two literals whose codes fit together in the
+first bits (the second one in bits 16-23), so that frequent runs of literals are decoded two at a time.
+*/
+#define HUFFMAN_FIRSTBITS 10u
+#define HUFFMAN_ENTRY_VALUE(entry) ((entry) & 65535u)
+#define HUFFMAN_ENTRY_SECOND(entry) (((entry) >> 16) & 255u)
+#define HUFFMAN_ENTRY_BITS(entry) (((entry) >> 24) & 31u)
+#define HUFFMAN_ENTRY_PAIR 0x20000000u
+#define HUFFMAN_ENTRY_LINK 0x40000000u
+#define HUFFMAN_ENTRY_INVALID 65535u /*consumes 0 bits: a bit sequence that isn't the code of any symbol*/
+
+static unsigned reverseBits(unsigned bits, unsigned num)
+{
+  unsigned i, result = 0;
+  for(i = 0; i < num; ++i) result |= ((bits >> (num - i - 1u)) & 1u) << i;
+  return result;
+}
+
+/*
+builds the lookup table of a tree from its lengths and codes, with pairs of literals if pairs is 1 (only for the
+literal/length tree). return value is error
+*/
+static unsigned HuffmanTree_makeTable(HuffmanTree* tree, unsigned pairs)
+{
+  static const unsigned headsize = 1u << HUFFMAN_FIRSTBITS;
+  static const unsigned mask = (1u << HUFFMAN_FIRSTBITS) - 1u;
+  unsigned maxlens[1u << HUFFMAN_FIRSTBITS];
+  unsigned blcount[16];
+  unsigned* single = 0;
+  size_t size = headsize, pointer = headsize;
+  long left = 1;
+  unsigned i, j, n;
+
+  if(tree->maxbitlen > 15) return 55;
+
+  /*oversubscribed, see comment in lodepng_error_text*/
+  for(i = 0; i != 16; ++i) blcount[i] = 0;
+  for(n = 0; n != tree->numcodes; ++n) ++blcount[tree->lengths[n]];
+  for(i = 1; i != 16; ++i)
+  {
+    left = left * 2 - (long)blcount[i];
+    if(left < 0) return 55;
+  }
+
+  /*the size of each second level table is given by the longest code that starts with its first bits*/
+  for(i = 0; i != headsize; ++i) maxlens[i] = 0;
+  for(n = 0; n != tree->numcodes; ++n)
+  {
+    unsigned l = tree->lengths[n];
+    if(l <= HUFFMAN_FIRSTBITS) continue;
+    i = reverseBits(tree->tree1d[n], l) & mask;
+    if(maxlens[i] < l) maxlens[i] = l;
+  }
+  for(i = 0; i != headsize; ++i)
+  {
+    if(maxlens[i] > HUFFMAN_FIRSTBITS) size += (size_t)1u << (maxlens[i] - HUFFMAN_FIRSTBITS);
+  }
+
+  lodepng_free(tree->table);
+  tree->table = (unsigned*)lodepng_malloc(size * sizeof(unsigned));
+  if(!tree->table) return 83; /*alloc fail*/
+
+  for(i = 0; i != size; ++i) tree->table[i] = HUFFMAN_ENTRY_INVALID;
+  for(i = 0; i != headsize; ++i)
+  {
+    if(maxlens[i] <= HUFFMAN_FIRSTBITS) continue;
+    tree->table[i] = HUFFMAN_ENTRY_LINK | (unsigned)pointer | ((maxlens[i] - HUFFMAN_FIRSTBITS) << 24);
+    pointer += (size_t)1u << (maxlens[i] - HUFFMAN_FIRSTBITS);
+  }
+
+  /*every code fills all the entries whose index starts with its bits (the stream is read from lsb to msb)*/
+  for(n = 0; n != tree->numcodes; ++n)
+  {
+    unsigned l = tree->lengths[n];
+    unsigned reverse, entry = n | (l << 24);
+    if(l == 0) continue;
+    reverse = reverseBits(tree->tree1d[n], l);
+    if(l <= HUFFMAN_FIRSTBITS)
+    {
+      for(j = 0; j != (1u << (HUFFMAN_FIRSTBITS - l)); ++j) tree->table[reverse | (j << l)] = entry;
+    }
+    else
+    {
+      unsigned link = tree->table[reverse & mask];
+      unsigned indexbits = HUFFMAN_ENTRY_BITS(link);
+      unsigned tail = l - HUFFMAN_FIRSTBITS;
+      unsigned* subtable = &tree->table[HUFFMAN_ENTRY_VALUE(link)];
+      for(j = 0; j != (1u << (indexbits - tail)); ++j) subtable[(reverse >> HUFFMAN_FIRSTBITS) | (j << tail)] = entry;
+    }
+  }
+
+  if(!pairs) return 0;
+
+  single = (unsigned*)lodepng_malloc(headsize * sizeof(unsigned));
+  if(!single) return 83; /*alloc fail*/
+  for(i = 0; i != headsize; ++i) single[i] = tree->table[i];
+
+  for(i = 0; i != headsize; ++i)
+  {
+    unsigned first = single[i], second, l1, l2;
+    if(first & HUFFMAN_ENTRY_LINK) continue;
+    l1 = HUFFMAN_ENTRY_BITS(first);
+    if(l1 == 0 || l1 >= HUFFMAN_FIRSTBITS || HUFFMAN_ENTRY_VALUE(first) > 255) continue;
+    /*the bits that follow the first literal are still in the index, but only HUFFMAN_FIRSTBITS - l1 of them*/
+    second = single[i >> l1];
+    if(second & HUFFMAN_ENTRY_LINK) continue;
+    l2 = HUFFMAN_ENTRY_BITS(second);
+    if(l2 == 0 || l1 + l2 > HUFFMAN_FIRSTBITS || HUFFMAN_ENTRY_VALUE(second) > 255) continue;
+    tree->table[i] = HUFFMAN_ENTRY_PAIR | HUFFMAN_ENTRY_VALUE(first) | (HUFFMAN_ENTRY_VALUE(second) << 16)
+                   | ((l1 + l2) << 24);
+  }
+
+  lodepng_free(single);
+  return 0;
+}
+
+/*
+returns the next bits of the stream starting at bit bp, of which at least the first 57 are valid (the ones beyond
+the end of the input are 0)
+*/
+static unsigned long long peekBits(const unsigned char* in, size_t inlength, size_t bp)
+{
+  size_t start = bp >> 3;
+  unsigned long long result = 0;
+  if(start + 8 <= inlength)
+  {
+    result = (unsigned long long)in[start]
+           | ((unsigned long long)in[start + 1] << 8)
+           | ((unsigned long long)in[start + 2] << 16)
+           | ((unsigned long long)in[start + 3] << 24)
+           | ((unsigned long long)in[start + 4] << 32)
+           | ((unsigned long long)in[start + 5] << 40)
+           | ((unsigned long long)in[start + 6] << 48)
+           | ((unsigned long long)in[start + 7] << 56);
+  }
+  else
+  {
+    size_t i;
+    for(i = 0; i != 8 && start + i < inlength; ++i) result |= (unsigned long long)in[start + i] << (8 * i);
+  }
+  return result >> (bp & 7u);
+}
+
+/*returns the table entry of the symbol that starts with the given bits*/
+static unsigned huffmanLookup(const HuffmanTree* codetree, unsigned long long bits)
+{
+  unsigned entry = codetree->table[(unsigned)bits & ((1u << HUFFMAN_FIRSTBITS) - 1u)];
+  if(entry & HUFFMAN_ENTRY_LINK)
+  {
+    unsigned index = (unsigned)(bits >> HUFFMAN_FIRSTBITS) & ((1u << HUFFMAN_ENTRY_BITS(entry)) - 1u);
+    entry = codetree->table[HUFFMAN_ENTRY_VALUE(entry) + index];
+  }
+  return entry;
+}
+
 /*
 returns the code, or (unsigned)(-1) if error happened
 inbitlength is the length of the complete buffer, in bits (so its byte length times 8)
@@ -947,21 +1060,11 @@ inbitlength is the length of the complete buffer, in bits (so its byte length ti
 static unsigned huffmanDecodeSymbol(const unsigned char* in, size_t* bp,
                                     const HuffmanTree* codetree, size_t inbitlength)
 {
-  unsigned treepos = 0, ct;
-  for(;;)
-  {
-    if(*bp >= inbitlength) return (unsigned)(-1); /*error: end of input memory reached without endcode*/
-    /*
-    decode the symbol from the tree. The "readBitFromStream" code is inlined in
-    the expression below because this is the biggest bottleneck while decoding
-    */
-    ct = codetree->tree2d[(treepos << 1) + READBIT(*bp, in)];
-    ++(*bp);
-    if(ct < codetree->numcodes) return ct; /*the symbol is decoded, return it*/
-    else treepos = ct - codetree->numcodes; /*symbol not yet decoded, instead move tree position*/
-
-    if(treepos >= codetree->numcodes) return (unsigned)(-1); /*error: it appeared outside the codetree*/
-  }
+  unsigned entry = huffmanLookup(codetree, peekBits(in, inbitlength >> 3, *bp));
+  if(HUFFMAN_ENTRY_BITS(entry) == 0) return (unsigned)(-1); /*error: it appeared outside the codetree*/
+  *bp += HUFFMAN_ENTRY_BITS(entry);
+  if(*bp > inbitlength) return (unsigned)(-1); /*error: end of input memory reached without endcode*/
+  return HUFFMAN_ENTRY_VALUE(entry);
 }
 #endif /*LODEPNG_COMPILE_DECODER*/
 
@@ -1022,6 +1125,7 @@ static unsigned getTreeInflateDynamic(HuffmanTree* tree_ll, HuffmanTree* tree_d,
     }
 
     error = HuffmanTree_makeFromLengths(&tree_cl, bitlen_cl, NUM_CODE_LENGTH_CODES, 7);
+    if(!error) error = HuffmanTree_makeTable(&tree_cl, 0);
     if(error) break;
 
     /*now we can use this tree to read the lengths for the tree that this function will return*/
@@ -1142,11 +1246,32 @@ static unsigned inflateHuffmanBlock(ucvector* out, const unsigned char* in, size
   if(btype == 1) getTreeInflateFixed(&tree_ll, &tree_d);
   else if(btype == 2) error = getTreeInflateDynamic(&tree_ll, &tree_d, in, bp, inlength);
 
+  if(!error) error = HuffmanTree_makeTable(&tree_ll, 1);
+  if(!error) error = HuffmanTree_makeTable(&tree_d, 0);
+
   while(!error) /*decode all symbols until end reached, breaks at end code*/
   {
+    /*the longest sequence (length code, its extra bits, distance code and its extra bits) takes 48 bits, so the
+    bits are read from the input only once per symbol*/
+    unsigned long long bits = peekBits(in, inlength, *bp);
+    unsigned entry = huffmanLookup(&tree_ll, bits);
+    unsigned numbits = HUFFMAN_ENTRY_BITS(entry);
     /*code_ll is literal, length or end code*/
-    unsigned code_ll = huffmanDecodeSymbol(in, bp, &tree_ll, inbitlength);
-    if(code_ll <= 255) /*literal symbol*/
+    unsigned code_ll = HUFFMAN_ENTRY_VALUE(entry);
+
+    if(numbits == 0) ERROR_BREAK(11); /*error: it appeared outside the codetree*/
+    *bp += numbits;
+    bits >>= numbits;
+    if(*bp > inbitlength) ERROR_BREAK(10); /*error: end of input memory reached without endcode*/
+
+    if(entry & HUFFMAN_ENTRY_PAIR) /*two literal symbols*/
+    {
+      if(!ucvector_resize(out, (*pos) + 2)) ERROR_BREAK(83 /*alloc fail*/);
+      out->data[*pos] = (unsigned char)code_ll;
+      out->data[*pos + 1] = (unsigned char)HUFFMAN_ENTRY_SECOND(entry);
+      (*pos) += 2;
+    }
+    else if(code_ll <= 255) /*literal symbol*/
     {
       /*ucvector_push_back would do the same, but for some reason the two lines below run 10% faster*/
       if(!ucvector_resize(out, (*pos) + 1)) ERROR_BREAK(83 /*alloc fail*/);
@@ -1164,28 +1289,25 @@ static unsigned inflateHuffmanBlock(ucvector* out, const unsigned char* in, size
 
       /*part 2: get extra bits and add the value of that to length*/
       numextrabits_l = LENGTHEXTRA[code_ll - FIRST_LENGTH_CODE_INDEX];
-      if((*bp + numextrabits_l) > inbitlength) ERROR_BREAK(51); /*error, bit pointer will jump past memory*/
-      length += readBitsFromStream(bp, in, numextrabits_l);
+      length += (size_t)(bits & ((1u << numextrabits_l) - 1u));
+      *bp += numextrabits_l;
+      bits >>= numextrabits_l;
 
       /*part 3: get distance code*/
-      code_d = huffmanDecodeSymbol(in, bp, &tree_d, inbitlength);
-      if(code_d > 29)
-      {
-        if(code_d == (unsigned)(-1)) /*huffmanDecodeSymbol returns (unsigned)(-1) in case of error*/
-        {
-          /*return error code 10 or 11 depending on the situation that happened in huffmanDecodeSymbol
-          (10=no endcode, 11=wrong jump outside of tree)*/
-          error = (*bp) > inlength * 8 ? 10 : 11;
-        }
-        else error = 18; /*error: invalid distance code (30-31 are never used)*/
-        break;
-      }
+      entry = huffmanLookup(&tree_d, bits);
+      numbits = HUFFMAN_ENTRY_BITS(entry);
+      code_d = HUFFMAN_ENTRY_VALUE(entry);
+      if(numbits == 0) ERROR_BREAK(11); /*error: it appeared outside the codetree*/
+      if(code_d > 29) ERROR_BREAK(18); /*error: invalid distance code (30-31 are never used)*/
+      *bp += numbits;
+      bits >>= numbits;
       distance = DISTANCEBASE[code_d];
 
       /*part 4: get extra bits from distance*/
       numextrabits_d = DISTANCEEXTRA[code_d];
-      if((*bp + numextrabits_d) > inbitlength) ERROR_BREAK(51); /*error, bit pointer will jump past memory*/
-      distance += readBitsFromStream(bp, in, numextrabits_d);
+      distance += (unsigned)(bits & ((1u << numextrabits_d) - 1u));
+      *bp += numextrabits_d;
+      if(*bp > inbitlength) ERROR_BREAK(51); /*error, bit pointer will jump past memory*/
 
       /*part 5: fill in all the out[n] values based on the length and dist*/
       start = (*pos);
@@ -1193,27 +1315,24 @@ static unsigned inflateHuffmanBlock(ucvector* out, const unsigned char* in, size
       backward = start - distance;
 
       if(!ucvector_resize(out, (*pos) + length)) ERROR_BREAK(83 /*alloc fail*/);
-      if (distance < length) {
-        for(forward = 0; forward < length; ++forward)
+      if(distance < length)
+      {
+        /*the copy overlaps the bytes it repeats (e.g. a run of equal pixels), so it's done in pieces that double
+        in size, each one a whole number of repetitions of the first distance bytes*/
+        for(forward = 0; forward < length; forward += distance + forward)
         {
-          out->data[(*pos)++] = out->data[backward++];
+          size_t piece = distance + forward < length - forward ? distance + forward : length - forward;
+          memcpy(out->data + *pos + forward, out->data + backward, piece);
         }
-      } else {
-        memcpy(out->data + *pos, out->data + backward, length);
-        *pos += length;
       }
+      else memcpy(out->data + *pos, out->data + backward, length);
+      *pos += length;
     }
     else if(code_ll == 256)
     {
       break; /*end code, break the loop*/
     }
-    else /*if(code == (unsigned)(-1))*/ /*huffmanDecodeSymbol returns (unsigned)(-1) in case of error*/
-    {
-      /*return error code 10 or 11 depending on the situation that happened in huffmanDecodeSymbol
-      (10=no endcode, 11=wrong jump outside of tree)*/
-      error = ((*bp) > inlength * 8) ? 10 : 11;
-      break;
-    }
+    else ERROR_BREAK(11); /*the unused codes 286 and 287*/
   }
 
   HuffmanTree_cleanup(&tree_ll);
@@ -1293,20 +1412,6 @@ unsigned lodepng_inflate(unsigned char** out, size_t* outsize,
   return error;
 }
 
-static unsigned inflate(unsigned char** out, size_t* outsize,
-                        const unsigned char* in, size_t insize,
-                        const LodePNGDecompressSettings* settings)
-{
-  if(settings->custom_inflate)
-  {
-    return settings->custom_inflate(out, outsize, in, insize, settings);
-  }
-  else
-  {
-    return lodepng_inflate(out, outsize, in, insize, settings);
-  }
-}
-
 #endif /*LODEPNG_COMPILE_DECODER*/
 
 #ifdef LODEPNG_COMPILE_ENCODER
@@ -2123,8 +2228,9 @@ static unsigned adler32(const unsigned char* data, unsigned len)
 
 #ifdef LODEPNG_COMPILE_DECODER
 
-unsigned lodepng_zlib_decompress(unsigned char** out, size_t* outsize, const unsigned char* in,
-                                 size_t insize, const LodePNGDecompressSettings* settings)
+/*decompresses into out, which keeps its allocated size, so that it can be reserved in advance or be fixed*/
+static unsigned lodepng_zlib_decompressv(ucvector* out, const unsigned char* in, size_t insize,
+                                         const LodePNGDecompressSettings* settings)
 {
   unsigned error = 0;
   unsigned CM, CINFO, FDICT;
@@ -2155,19 +2261,41 @@ unsigned lodepng_zlib_decompress(unsigned char** out, size_t* outsize, const uns
     return 26;
   }
 
-  error = inflate(out, outsize, in + 2, insize - 2, settings);
+  if(settings->custom_inflate)
+  {
+    unsigned char* data = 0;
+    size_t size = 0;
+    size_t i;
+    error = settings->custom_inflate(&data, &size, in + 2, insize - 2, settings);
+    if(!error && !ucvector_resize(out, size)) error = 83; /*alloc fail*/
+    if(!error) for(i = 0; i != size; ++i) out->data[i] = data[i];
+    lodepng_free(data);
+  }
+  else error = lodepng_inflatev(out, in + 2, insize - 2, settings);
   if(error) return error;
 
   if(!settings->ignore_adler32)
   {
     unsigned ADLER32 = lodepng_read32bitInt(&in[insize - 4]);
-    unsigned checksum = adler32(*out, (unsigned)(*outsize));
+    unsigned checksum = adler32(out->data, (unsigned)(out->size));
     if(checksum != ADLER32) return 58; /*error, adler checksum not correct, data must be corrupted*/
   }
 
   return 0; /*no error*/
 }
 
+unsigned lodepng_zlib_decompress(unsigned char** out, size_t* outsize, const unsigned char* in,
+                                 size_t insize, const LodePNGDecompressSettings* settings)
+{
+  unsigned error;
+  ucvector v;
+  ucvector_init_buffer(&v, *out, *outsize);
+  error = lodepng_zlib_decompressv(&v, in, insize, settings);
+  *out = v.data;
+  *outsize = v.size;
+  return error;
+}
+
 static unsigned zlib_decompress(unsigned char** out, size_t* outsize, const unsigned char* in,
                                 size_t insize, const LodePNGDecompressSettings* settings)
 {
@@ -3968,6 +4096,179 @@ unsigned lodepng_inspect(unsigned* w, unsigned* h, LodePNGState* state,
   return state->error;
 }
 
+#if defined(LODEPNG_SSE2) || defined(LODEPNG_NEON)
+/*
+Vectorized filters. Sub, Average and Paeth depend on the previous pixel, so these only handle 4 bytes per pixel
+(the 4 bytes of a pixel are processed together), while Up processes 16 bytes at a time with any bytewidth. Like in
+unfilterScanline, recon and scanline may be the same memory address: each chunk is loaded before it's stored.
+*/
+#define LODEPNG_SIMD_UNFILTER
+
+#ifdef LODEPNG_SSE2
+
+static __m128i simdLoad4(const unsigned char* p)
+{
+  int value;
+  memcpy(&value, p, 4);
+  return _mm_cvtsi32_si128(value);
+}
+
+static void simdStore4(unsigned char* p, __m128i v)
+{
+  int value = _mm_cvtsi128_si32(v);
+  memcpy(p, &value, 4);
+}
+
+static void unfilterUp(unsigned char* recon, const unsigned char* scanline, const unsigned char* precon,
+                       size_t length)
+{
+  size_t i = 0;
+  for(; i + 16 <= length; i += 16)
+  {
+    __m128i x = _mm_loadu_si128((const __m128i*)&scanline[i]);
+    __m128i b = _mm_loadu_si128((const __m128i*)&precon[i]);
+    _mm_storeu_si128((__m128i*)&recon[i], _mm_add_epi8(x, b));
+  }
+  for(; i != length; ++i) recon[i] = scanline[i] + precon[i];
+}
+
+static void unfilterSub4(unsigned char* recon, const unsigned char* scanline, size_t length)
+{
+  __m128i a = _mm_setzero_si128();
+  size_t i;
+  for(i = 0; i + 4 <= length; i += 4)
+  {
+    a = _mm_add_epi8(a, simdLoad4(&scanline[i]));
+    simdStore4(&recon[i], a);
+  }
+}
+
+static void unfilterAverage4(unsigned char* recon, const unsigned char* scanline, const unsigned char* precon,
+                             size_t length)
+{
+  const __m128i one = _mm_set1_epi8(1);
+  __m128i a = _mm_setzero_si128();
+  size_t i;
+  for(i = 0; i + 4 <= length; i += 4)
+  {
+    __m128i b = simdLoad4(&precon[i]);
+    /*_mm_avg_epu8 rounds up, the filter rounds down*/
+    __m128i average = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), one));
+    a = _mm_add_epi8(simdLoad4(&scanline[i]), average);
+    simdStore4(&recon[i], a);
+  }
+}
+
+static __m128i simdAbs16(__m128i v)
+{
+  return _mm_max_epi16(v, _mm_sub_epi16(_mm_setzero_si128(), v));
+}
+
+static __m128i simdSelect(__m128i mask, __m128i a, __m128i b)
+{
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+static void unfilterPaeth4(unsigned char* recon, const unsigned char* scanline, const unsigned char* precon,
+                           size_t length)
+{
+  /*same choice as paethPredictor, with each byte in a 16 bit lane*/
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i bytemask = _mm_set1_epi16(255);
+  __m128i a = zero, c = zero;
+  size_t i;
+  for(i = 0; i + 4 <= length; i += 4)
+  {
+    __m128i b = _mm_unpacklo_epi8(simdLoad4(&precon[i]), zero);
+    __m128i x = _mm_unpacklo_epi8(simdLoad4(&scanline[i]), zero);
+    __m128i pa = _mm_sub_epi16(b, c);
+    __m128i pb = _mm_sub_epi16(a, c);
+    __m128i pc = _mm_add_epi16(pa, pb);
+    __m128i smallest, nearest;
+    pa = simdAbs16(pa);
+    pb = simdAbs16(pb);
+    pc = simdAbs16(pc);
+    smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+    nearest = simdSelect(_mm_cmpeq_epi16(smallest, pa), a, simdSelect(_mm_cmpeq_epi16(smallest, pb), b, c));
+    a = _mm_and_si128(_mm_add_epi16(x, nearest), bytemask);
+    simdStore4(&recon[i], _mm_packus_epi16(a, a));
+    c = b;
+  }
+}
+
+#else /*LODEPNG_NEON*/
+
+static uint8x8_t simdLoad4(const unsigned char* p)
+{
+  uint32_t value;
+  memcpy(&value, p, 4);
+  return vreinterpret_u8_u32(vdup_n_u32(value));
+}
+
+static void simdStore4(unsigned char* p, uint8x8_t v)
+{
+  uint32_t value = vget_lane_u32(vreinterpret_u32_u8(v), 0);
+  memcpy(p, &value, 4);
+}
+
+static void unfilterUp(unsigned char* recon, const unsigned char* scanline, const unsigned char* precon,
+                       size_t length)
+{
+  size_t i = 0;
+  for(; i + 16 <= length; i += 16)
+  {
+    vst1q_u8(&recon[i], vaddq_u8(vld1q_u8(&scanline[i]), vld1q_u8(&precon[i])));
+  }
+  for(; i != length; ++i) recon[i] = scanline[i] + precon[i];
+}
+
+static void unfilterSub4(unsigned char* recon, const unsigned char* scanline, size_t length)
+{
+  uint8x8_t a = vdup_n_u8(0);
+  size_t i;
+  for(i = 0; i + 4 <= length; i += 4)
+  {
+    a = vadd_u8(a, simdLoad4(&scanline[i]));
+    simdStore4(&recon[i], a);
+  }
+}
+
+static void unfilterAverage4(unsigned char* recon, const unsigned char* scanline, const unsigned char* precon,
+                             size_t length)
+{
+  uint8x8_t a = vdup_n_u8(0);
+  size_t i;
+  for(i = 0; i + 4 <= length; i += 4)
+  {
+    /*vhadd_u8 rounds down like the filter*/
+    a = vadd_u8(simdLoad4(&scanline[i]), vhadd_u8(a, simdLoad4(&precon[i])));
+    simdStore4(&recon[i], a);
+  }
+}
+
+static void unfilterPaeth4(unsigned char* recon, const unsigned char* scanline, const unsigned char* precon,
+                           size_t length)
+{
+  /*same choice as paethPredictor, with the distances in 16 bit lanes*/
+  uint8x8_t a = vdup_n_u8(0), c = a;
+  size_t i;
+  for(i = 0; i + 4 <= length; i += 4)
+  {
+    uint8x8_t b = simdLoad4(&precon[i]);
+    uint16x8_t pa = vabdl_u8(b, c);
+    uint16x8_t pb = vabdl_u8(a, c);
+    uint16x8_t pc = vabdq_u16(vaddl_u8(a, b), vaddl_u8(c, c));
+    uint8x8_t use_a = vmovn_u16(vandq_u16(vcleq_u16(pa, pb), vcleq_u16(pa, pc)));
+    uint8x8_t use_b = vmovn_u16(vcleq_u16(pb, pc));
+    a = vadd_u8(simdLoad4(&scanline[i]), vbsl_u8(use_a, a, vbsl_u8(use_b, b, c)));
+    simdStore4(&recon[i], a);
+    c = b;
+  }
+}
+
+#endif /*LODEPNG_SSE2*/
+#endif /*defined(LODEPNG_SSE2) || defined(LODEPNG_NEON)*/
+
 static unsigned unfilterScanline(unsigned char* recon, const unsigned char* scanline, const unsigned char* precon,
                                  size_t bytewidth, unsigned char filterType, size_t length)
 {
@@ -3984,16 +4285,27 @@ static unsigned unfilterScanline(unsigned char* recon, const unsigned char* scan
   switch(filterType)
   {
     case 0:
-      for(i = 0; i != length; ++i) recon[i] = scanline[i];
+      if(recon != scanline) memmove(recon, scanline, length);
       break;
     case 1:
+#ifdef LODEPNG_SIMD_UNFILTER
+      if(bytewidth == 4)
+      {
+        unfilterSub4(recon, scanline, length);
+        break;
+      }
+#endif /*LODEPNG_SIMD_UNFILTER*/
       for(i = 0; i != bytewidth; ++i) recon[i] = scanline[i];
       for(i = bytewidth; i < length; ++i) recon[i] = scanline[i] + recon[i - bytewidth];
       break;
     case 2:
       if(precon)
       {
+#ifdef LODEPNG_SIMD_UNFILTER
+        unfilterUp(recon, scanline, precon, length);
+#else /*LODEPNG_SIMD_UNFILTER*/
         for(i = 0; i != length; ++i) recon[i] = scanline[i] + precon[i];
+#endif /*LODEPNG_SIMD_UNFILTER*/
       }
       else
       {
@@ -4001,6 +4313,13 @@ static unsigned unfilterScanline(unsigned char* recon, const unsigned char* scan
       }
       break;
     case 3:
+#ifdef LODEPNG_SIMD_UNFILTER
+      if(precon && bytewidth == 4)
+      {
+        unfilterAverage4(recon, scanline, precon, length);
+        break;
+      }
+#endif /*LODEPNG_SIMD_UNFILTER*/
       if(precon)
       {
         for(i = 0; i != bytewidth; ++i) recon[i] = scanline[i] + (precon[i] >> 1);
@@ -4013,6 +4332,15 @@ static unsigned unfilterScanline(unsigned char* recon, const unsigned char* scan
       }
       break;
     case 4:
+#ifdef LODEPNG_SIMD_UNFILTER
+      if(bytewidth == 4)
+      {
+        /*without the previous scanline, Paeth is the same as Sub*/
+        if(precon) unfilterPaeth4(recon, scanline, precon, length);
+        else unfilterSub4(recon, scanline, length);
+        break;
+      }
+#endif /*LODEPNG_SIMD_UNFILTER*/
       if(precon)
       {
         for(i = 0; i != bytewidth; ++i)
@@ -4521,18 +4849,36 @@ static unsigned readChunk_pHYs(LodePNGInfo* info, const unsigned char* data, siz
 #endif /*LODEPNG_COMPILE_ANCILLARY_CHUNKS*/
 
 /*read a PNG, the result will be in the same color type as the PNG (hence "generic")*/
-static void decodeGeneric(unsigned char** out, unsigned* w, unsigned* h,
-                          LodePNGState* state,
-                          const unsigned char* in, size_t insize)
+/*decompresses the zlib data into out, which keeps its reserved size (or stays fixed) unless a custom zlib is used*/
+static unsigned zlib_decompressv(ucvector* out, const unsigned char* in, size_t insize,
+                                 const LodePNGDecompressSettings* settings)
+{
+  unsigned char* data = 0;
+  size_t size = 0;
+  size_t i;
+  unsigned error;
+#ifdef LODEPNG_COMPILE_ZLIB
+  if(!settings->custom_zlib) return lodepng_zlib_decompressv(out, in, insize, settings);
+#endif /*LODEPNG_COMPILE_ZLIB*/
+  error = zlib_decompress(&data, &size, in, insize, settings);
+  if(!error && !ucvector_resize(out, size)) error = 83; /*alloc fail*/
+  if(!error) for(i = 0; i != size; ++i) out->data[i] = data[i];
+  lodepng_free(data);
+  return error;
+}
+
+/*reads the chunks and decompresses the data of the IDAT chunks (the filtered scanlines) into scanlines, which
+must be initialized by the caller and can be a fixed buffer*/
+static void decodeScanlines(ucvector* scanlines, unsigned* w, unsigned* h,
+                            LodePNGState* state,
+                            const unsigned char* in, size_t insize)
 {
   unsigned char IEND = 0;
   const unsigned char* chunk;
   size_t i;
   ucvector idat; /*the data from idat chunks*/
-  ucvector scanlines;
   size_t predict;
   size_t numpixels;
-  size_t outsize = 0;
 
   /*for unknown chunk order*/
   unsigned unknown = 0;
@@ -4540,9 +4886,6 @@ static void decodeGeneric(unsigned char** out, unsigned* w, unsigned* h,
   unsigned critical_pos = 1; /*1 = after IHDR, 2 = after PLTE, 3 = after IDAT*/
 #endif /*LODEPNG_COMPILE_ANCILLARY_CHUNKS*/
 
-  /*provide some proper output values if error will happen*/
-  *out = 0;
-
   state->error = lodepng_inspect(w, h, state, in, insize); /*reads header and resets other parameters in state->info_png*/
   if(state->error) return;
 
@@ -4689,7 +5032,6 @@ static void decodeGeneric(unsigned char** out, unsigned* w, unsigned* h,
     if(!IEND) chunk = lodepng_chunk_next_const(chunk);
   }
 
-  ucvector_init(&scanlines);
   /*predict output size, to allocate exact size for output buffer to avoid more dynamic allocation.
   If the decompressed size does not match the prediction, the image must be corrupt.*/
   if(state->info_png.interlace_method == 0)
@@ -4710,14 +5052,28 @@ static void decodeGeneric(unsigned char** out, unsigned* w, unsigned* h,
     if(*w > 1) predict += lodepng_get_raw_size_idat((*w + 0) >> 1, (*h + 1) >> 1, color) + ((*h + 1) >> 1);
     predict += lodepng_get_raw_size_idat((*w + 0), (*h + 0) >> 1, color) + ((*h + 0) >> 1);
   }
-  if(!state->error && !ucvector_reserve(&scanlines, predict)) state->error = 83; /*alloc fail*/
+  if(!state->error && !ucvector_reserve(scanlines, predict)) state->error = 83; /*alloc fail*/
   if(!state->error)
   {
-    state->error = zlib_decompress(&scanlines.data, &scanlines.size, idat.data,
-                                   idat.size, &state->decoder.zlibsettings);
-    if(!state->error && scanlines.size != predict) state->error = 91; /*decompressed size doesn't match prediction*/
+    state->error = zlib_decompressv(scanlines, idat.data, idat.size, &state->decoder.zlibsettings);
+    if(!state->error && scanlines->size != predict) state->error = 91; /*decompressed size doesn't match prediction*/
   }
   ucvector_cleanup(&idat);
+}
+
+static void decodeGeneric(unsigned char** out, unsigned* w, unsigned* h,
+                          LodePNGState* state,
+                          const unsigned char* in, size_t insize)
+{
+  ucvector scanlines;
+  size_t outsize = 0;
+  size_t i;
+
+  /*provide some proper output values if error will happen*/
+  *out = 0;
+
+  ucvector_init(&scanlines);
+  decodeScanlines(&scanlines, w, h, state, in, insize);
 
   if(!state->error)
   {
@@ -4778,6 +5134,55 @@ unsigned lodepng_decode(unsigned char** out, unsigned* w, unsigned* h,
   return state->error;
 }
 
+size_t lodepng_get_decode_into_size(unsigned w, unsigned h, const LodePNGState* state)
+{
+  /*the scanlines are decompressed in place, so besides the raw image there must be room for the filter byte
+  that every scanline starts with*/
+  size_t rawsize = lodepng_get_raw_size(w, h, &state->info_raw);
+  size_t scanlinesize = lodepng_get_raw_size_idat(w, h, &state->info_png.color) + h;
+  return rawsize > scanlinesize ? rawsize : scanlinesize;
+}
+
+unsigned lodepng_decode_into(unsigned char* out, size_t outsize, unsigned* w, unsigned* h,
+                             LodePNGState* state,
+                             const unsigned char* in, size_t insize)
+{
+  unsigned char* data = 0;
+  size_t datasize, i;
+
+  state->error = lodepng_inspect(w, h, state, in, insize);
+  if(state->error) return state->error;
+
+  if(state->info_png.interlace_method == 0 && lodepng_get_bpp(&state->info_png.color) >= 8
+     && (!state->decoder.color_convert || lodepng_color_mode_equal(&state->info_raw, &state->info_png.color)))
+  {
+    /*the scanlines are inflated directly into out and unfiltered in place, without any intermediate buffer*/
+    ucvector scanlines;
+    if(outsize < lodepng_get_decode_into_size(*w, *h, state)) return state->error = 95;
+    ucvector_init_buffer(&scanlines, out, outsize);
+    scanlines.size = 0;
+    scanlines.fixed = 1;
+    decodeScanlines(&scanlines, w, h, state, in, insize);
+    if(!state->error) state->error = unfilter(out, out, *w, *h, lodepng_get_bpp(&state->info_png.color));
+    if(!state->error && !state->decoder.color_convert)
+    {
+      state->error = lodepng_color_mode_copy(&state->info_raw, &state->info_png.color);
+    }
+    return state->error;
+  }
+
+  /*interlaced, less than 8 bits per pixel or converted images go through the generic path and are copied*/
+  state->error = lodepng_decode(&data, w, h, state, in, insize);
+  if(!state->error)
+  {
+    datasize = lodepng_get_raw_size(*w, *h, &state->info_raw);
+    if(outsize < datasize) state->error = 95;
+    else for(i = 0; i != datasize; ++i) out[i] = data[i];
+  }
+  lodepng_free(data);
+  return state->error;
+}
+
 unsigned lodepng_decode_memory(unsigned char** out, unsigned* w, unsigned* h, const unsigned char* in,
                                size_t insize, LodePNGColorType colortype, unsigned bitdepth)
 {
@@ -6013,6 +6418,7 @@ const char* lodepng_error_text(unsigned code)
     case 92: return "too many pixels, not supported";
     case 93: return "zero width or height is invalid";
     case 94: return "header chunk must have a size of 13 bytes";
+    case 95: return "output buffer too small for the decoded image";
   }
   return "unknown error code";
 }
@@ -74,6 +74,11 @@ source files with custom allocators.*/
 #ifndef LODEPNG_NO_COMPILE_ALLOCATORS
 #define LODEPNG_COMPILE_ALLOCATORS
 #endif
+/*unfilter the decoded scanlines with SSE2 or NEON when the target supports them. If you disable this, the
+portable code is used on every target*/
+#ifndef LODEPNG_NO_COMPILE_SIMD
+#define LODEPNG_COMPILE_SIMD
+#endif
 /*compile the C++ version (you can disable the C++ wrapper here even when compiling for C++)*/
 #ifdef __cplusplus
 #ifndef LODEPNG_NO_COMPILE_CPP
@@ -663,6 +668,23 @@ information is placed in the info_png field of the LodePNGState.
 unsigned lodepng_inspect(unsigned* w, unsigned* h,
                          LodePNGState* state,
                          const unsigned char* in, size_t insize);
+
+/*
+Returns the size in bytes that the buffer given to lodepng_decode_into must have for an image of w*h
+pixels (as read by lodepng_inspect) with the color modes of the state. It can be slightly bigger than
+the raw image, because the filter byte of every scanline is also stored there while decoding.
+*/
+size_t lodepng_get_decode_into_size(unsigned w, unsigned h, const LodePNGState* state);
+
+/*
+Same as lodepng_decode, but the image is decoded into a buffer given by the caller (of at least
+lodepng_get_decode_into_size bytes) instead of allocating one. Non interlaced images of 8 or more bits
+per pixel which don't need a color conversion are decompressed and unfiltered in place in that buffer,
+so no other buffer of the size of the image is allocated. Returns 95 if the buffer is too small.
+*/
+unsigned lodepng_decode_into(unsigned char* out, size_t outsize, unsigned* w, unsigned* h,
+                             LodePNGState* state,
+                             const unsigned char* in, size_t insize);
 #endif /*LODEPNG_COMPILE_DECODER*/
 
 
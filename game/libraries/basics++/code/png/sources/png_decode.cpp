@@ -12,6 +12,7 @@
 
 #include "lodepng.h"
 #include <basics/png_decode>
+#include <basics/Profiler>
 
 namespace basics
 {
@@ -24,32 +25,47 @@ namespace basics
         unsigned & height
     )
     {
-        std::vector< byte > decoded_data;
-
-        int error = lodepng::decode
-        (
-            decoded_data,
-            width,
-            height,
-            encoded_data,
-            LCT_RGBA,
-            8
-        );
+        BASICS_PROFILE_ZONE ("png_decode");
+
+        // Se decodifica directamente en el buffer de colores, cuyo tamaño se conoce por la cabecera,
+        // en lugar de hacerlo en un buffer temporal y copiarlo después:
+
+        LodePNGState state;
+
+        lodepng_state_init (&state);
+
+        state.info_raw.colortype = LCT_RGBA;
+        state.info_raw.bitdepth  = 8;
+
+        unsigned error = lodepng_inspect (&width, &height, &state, encoded_data.data (), encoded_data.size ());
 
         if (!error)
         {
-            color_buffer.resize (width, height);
+            // Mientras se decodifica se necesita algo más que la imagen (un byte por fila que indica
+            // el filtro usado en ella):
+
+            size_t size = lodepng_get_decode_into_size (width, height, &state);
 
-            byte * buffer = color_buffer;
+            color_buffer.buffer.resize ((size + sizeof(Rgba8888) - 1) / sizeof(Rgba8888));
 
-            for (auto i = decoded_data.begin (); i != decoded_data.end (); ++i)
-            {
-                *buffer++ = *i;
-            }
+            error = lodepng_decode_into (color_buffer, size, &width, &height, &state, encoded_data.data (), encoded_data.size ());
+        }
+
+        lodepng_state_cleanup (&state);
+
+        if (!error)
+        {
+            // Los bytes sobrantes se descartan sin liberar la memoria para evitar otra copia:
+
+            color_buffer.width  = width;
+            color_buffer.height = height;
+            color_buffer.buffer.resize (width * height);
 
             return true;
         }
 
+        color_buffer = Color_Buffer< Rgba8888 >();
+
         return false;
     }
 
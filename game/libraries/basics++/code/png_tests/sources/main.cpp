@@ -0,0 +1,413 @@
+/*
+ * PNG TESTS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <basics/Asset>
+#include <basics/Color_Buffer>
+#include <basics/Log>
+#include <basics/png_decode>
+#include "lodepng.h"
+#include "reference_lodepng.hpp"
+
+using namespace basics;
+using namespace basics::png_tests;
+
+namespace
+{
+
+    const char * const image_paths[] =
+    {
+        "game-scene/game.png",
+        "game-scene/pause-spritesheet.png",
+        "menu-scene/menu.png",
+        "intro_image.png",
+        "test.png",
+    };
+
+    // Todas las combinaciones de tipo de color y profundidad que admite el formato PNG:
+
+    const Png_Format formats[] =
+    {
+        { 0,  1 }, { 0,  2 }, { 0,  4 }, { 0,  8 }, { 0, 16 },
+        { 2,  8 }, { 2, 16 },
+        { 3,  1 }, { 3,  2 }, { 3,  4 }, { 3,  8 },
+        { 4,  8 }, { 4, 16 },
+        { 6,  8 }, { 6, 16 },
+    };
+
+    // Anchuras que dejan filas de menos de un byte, de menos de un bloque SIMD y con restos de
+    // todos los tamaños tras los bloques completos:
+
+    const unsigned widths[] = { 1, 3, 4, 7, 16, 17, 33, 70 };
+
+    const unsigned mixed_filters = 5;
+
+    unsigned checked_images = 0;
+    unsigned failures       = 0;
+
+    void fail (const std::string & what)
+    {
+        basics::log.e (("ERROR: " + what).c_str ());
+
+        ++failures;
+    }
+
+    unsigned get_channel_count (unsigned color_type)
+    {
+        switch (color_type)
+        {
+            case 2:  return 3;
+            case 4:  return 2;
+            case 6:  return 4;
+            default: return 1;
+        }
+    }
+
+    std::string describe (const Png_Encoding & encoding, unsigned width, unsigned height)
+    {
+        return "type "     + std::to_string (encoding.format.color_type)
+             + ", depth "  + std::to_string (encoding.format.bit_depth )
+             + ", "        + std::to_string (width) + "x" + std::to_string (height)
+             + ", filter " + std::to_string (encoding.filters.empty () ? 0u : unsigned(encoding.filters[0]))
+             + (encoding.interlaced ? ", interlaced" : "")
+             + ", btype "  + std::to_string (encoding.block_type)
+             + (encoding.use_lz77   ? ", lz77" : "");
+    }
+
+    /**
+     * Compara dos imágenes de las que solo cuentan los primeros bits (el último byte puede tener
+     * bits sobrantes cuando los píxeles ocupan menos de un byte).
+     */
+    bool same_bits (const Buffer & a, const Buffer & b, size_t bit_count)
+    {
+        size_t full_bytes = bit_count / 8;
+        size_t rest       = bit_count % 8;
+
+        if (a.size () < full_bytes + (rest ? 1 : 0) || b.size () < full_bytes + (rest ? 1 : 0))
+        {
+            return false;
+        }
+
+        if (std::memcmp (a.data (), b.data (), full_bytes) != 0)
+        {
+            return false;
+        }
+
+        byte mask = byte(0xFF << (8 - rest));
+
+        return rest == 0 || (a[full_bytes] & mask) == (b[full_bytes] & mask);
+    }
+
+    /**
+     * Decodifica la imagen con la versión actual (con el formato del archivo, en RGBA y con
+     * png_decode()) y con la de referencia, y comprueba que todas coinciden.
+     * @param original Si no es nullptr, píxeles que se codificaron.
+     */
+    void check_decoding (const Buffer & png, const Buffer * original, const Png_Format & format, unsigned width, unsigned height, const std::string & name)
+    {
+        ++checked_images;
+
+        Buffer   expected;
+        unsigned expected_width, expected_height;
+
+        if (reference_decode (png, false, expected, expected_width, expected_height) != 0)
+        {
+            return fail (name + ": the reference decoder rejected the image");
+        }
+
+        if (expected_width != width || expected_height != height)
+        {
+            return fail (name + ": the reference decoder read a different size");
+        }
+
+        // Con el formato del archivo, tal como salen del descompresor y de los filtros:
+
+        lodepng::State state;
+
+        state.decoder.color_convert = 0;
+
+        Buffer   raw;
+        unsigned raw_width, raw_height;
+        unsigned error = lodepng::decode (raw, raw_width, raw_height, state, png);
+
+        if (error)
+        {
+            fail (name + ": " + lodepng_error_text (error));
+        }
+        else
+        {
+            Buffer   reference_raw;
+            unsigned reference_width, reference_height;
+
+            reference_decode (png, true, reference_raw, reference_width, reference_height);
+
+            size_t bit_count = size_t(width) * height * get_channel_count (format.color_type) * format.bit_depth;
+
+            if (raw_width != width || raw_height != height || !same_bits (raw, reference_raw, bit_count))
+            {
+                fail (name + ": the raw pixels differ from the reference decoder");
+            }
+            else
+            if (original && !same_bits (raw, *original, bit_count))
+            {
+                fail (name + ": the raw pixels differ from the encoded ones");
+            }
+        }
+
+        // Convertidos a RGBA:
+
+        Buffer   rgba;
+        unsigned rgba_width, rgba_height;
+
+        error = lodepng::decode (rgba, rgba_width, rgba_height, png);
+
+        if (error || rgba != expected)
+        {
+            fail (name + ": the RGBA pixels differ from the reference decoder");
+        }
+
+        // Directamente en el buffer de colores, como hacen las texturas:
+
+        Color_Buffer< Rgba8888 > color_buffer;
+        unsigned                 buffer_width, buffer_height;
+
+        if
+        (
+            !png_decode (png, color_buffer, buffer_width, buffer_height) ||
+            buffer_width  != width  ||
+            buffer_height != height ||
+            std::memcmp (color_buffer.buffer.data (), expected.data (), expected.size ()) != 0
+        )
+        {
+            fail (name + ": png_decode() differs from the reference decoder");
+        }
+    }
+
+    void check_game_images ()
+    {
+        for (const char * path : image_paths)
+        {
+            std::shared_ptr< Asset > asset = Asset::open (path);
+            Buffer                   png;
+
+            if (!asset->good () || !asset->read_all (png))
+            {
+                fail (std::string(path) + ": failed to read the image");
+
+                continue;
+            }
+
+            lodepng::State state;
+            unsigned       width, height;
+
+            if (lodepng_inspect (&width, &height, &state, png.data (), png.size ()) != 0)
+            {
+                fail (std::string(path) + ": failed to read the header");
+
+                continue;
+            }
+
+            Png_Format format{ unsigned(state.info_png.color.colortype), state.info_png.color.bitdepth };
+
+            check_decoding (png, nullptr, format, width, height, path);
+        }
+    }
+
+    /**
+     * Genera los píxeles de una imagen de prueba empaquetados como los deja LodePNG (las muestras
+     * de 16 bits en big-endian y las de menos de 8 bits seguidas, sin relleno al final de las
+     * filas). Se mezclan zonas de ruido, que generan muchos símbolos distintos y códigos largos,
+     * con degradados, para los que los filtros sí reducen el tamaño, y zonas lisas, que producen
+     * repeticiones largas en LZ77.
+     */
+    Buffer make_image (const Png_Format & format, unsigned width, unsigned height, std::mt19937 & random)
+    {
+        unsigned channels  = get_channel_count (format.color_type);
+        unsigned depth     = format.bit_depth;
+        uint32_t max_value = depth == 16 ? 0xFFFF : (1u << depth) - 1;
+        size_t   bit_count = size_t(width) * height * channels * depth;
+        Buffer   image ((bit_count + 7) / 8, 0);
+        size_t   bit       = 0;
+
+        for (unsigned y = 0; y < height; ++y)
+        {
+            for (unsigned x = 0; x < width; ++x)
+            {
+                unsigned zone = (x / 5 + y / 3) % 3;
+
+                for (unsigned channel = 0; channel < channels; ++channel, bit += depth)
+                {
+                    uint32_t value;
+
+                    switch (zone)
+                    {
+                        case 0:  value = random ();                          break;
+                        case 1:  value = x * (channel + 1) * 37 + y * 23;    break;
+                        default: value = 200 + channel;                      break;
+                    }
+
+                    if (zone == 1 && depth == 16)
+                    {
+                        value *= 257;                   // Degradado con los dos bytes.
+                    }
+
+                    value &= max_value;
+
+                    if (depth >= 8)
+                    {
+                        if (depth == 16) image[bit / 8] = byte(value >> 8);
+
+                        image[(bit + depth) / 8 - 1] = byte(value);
+                    }
+                    else
+                    {
+                        image[bit / 8] |= byte(value << (8 - depth - bit % 8));
+                    }
+                }
+            }
+        }
+
+        return image;
+    }
+
+    void check_encoding (const Buffer & image, unsigned width, unsigned height, const Png_Encoding & encoding)
+    {
+        Buffer      png;
+        std::string name = describe (encoding, width, height);
+
+        unsigned error = reference_encode (image, width, height, encoding, png);
+
+        if (error)
+        {
+            return fail (name + ": the reference encoder failed (" + std::to_string (error) + ")");
+        }
+
+        check_decoding (png, &image, encoding.format, width, height, name);
+    }
+
+    /**
+     * Codifica con la versión de referencia imágenes con todos los formatos, filtros y tipos de
+     * bloque deflate, entrelazadas o no, y comprueba que se decodifican igual que con ella.
+     */
+    void check_generated_images ()
+    {
+        std::mt19937 random(1801);
+        unsigned     index = 0;
+
+        for (const Png_Format & format : formats)
+        {
+            Png_Encoding encoding;
+
+            encoding.format = format;
+
+            if (format.color_type == 3)
+            {
+                for (unsigned color = 0; color < (1u << format.bit_depth); ++color)
+                {
+                    for (unsigned component = 0; component < 4; ++component)
+                    {
+                        encoding.palette.push_back (byte(random ()));
+                    }
+                }
+            }
+
+            for (unsigned width : widths)
+            {
+                unsigned height = 1 + width * 7 % 13;
+                Buffer   image  = make_image (format, width, height, random);
+
+                for (unsigned filter = 0; filter <= mixed_filters; ++filter)
+                {
+                    encoding.filters.resize (height);
+
+                    for (unsigned y = 0; y < height; ++y)
+                    {
+                        encoding.filters[y] = byte(filter == mixed_filters ? (y + width) % 5 : filter);
+                    }
+
+                    for (unsigned interlaced = 0; interlaced < 2; ++interlaced, ++index)
+                    {
+                        encoding.interlaced = interlaced == 1;
+                        encoding.block_type = index % 3;
+                        encoding.use_lz77   = index / 3 % 2 == 0;
+
+                        check_encoding (image, width, height, encoding);
+                    }
+                }
+            }
+        }
+
+        // Imágenes mayores, que ocupan varios bloques deflate y necesitan códigos de más de 10 bits
+        // (las tablas de segundo nivel del descompresor):
+
+        const Png_Format large_formats[] = { { 6, 8 }, { 2, 16 }, { 0, 8 }, { 3, 8 } };
+
+        for (const Png_Format & format : large_formats)
+        {
+            unsigned     width  = 317;
+            unsigned     height = 211;
+            Buffer       image  = make_image (format, width, height, random);
+            Png_Encoding encoding;
+
+            encoding.format = format;
+
+            if (format.color_type == 3)
+            {
+                for (unsigned component = 0; component < 256 * 4; ++component)
+                {
+                    encoding.palette.push_back (byte(random ()));
+                }
+            }
+
+            for (unsigned y = 0; y < height; ++y)
+            {
+                encoding.filters.push_back (byte(y % 5));
+            }
+
+            for (unsigned block_type = 0; block_type < 3; ++block_type)
+            {
+                encoding.interlaced = block_type == 1;
+                encoding.block_type = block_type;
+                encoding.use_lz77   = true;
+
+                check_encoding (image, width, height, encoding);
+            }
+        }
+    }
+
+}
+
+/**
+ * Uso: basics-png-tests
+ *
+ * Comprueba que la versión de LodePNG que usa basics++ decodifica igual que la versión de
+ * referencia (la anterior a las optimizaciones) las imágenes del juego y un conjunto de imágenes
+ * generadas con todos los formatos y filtros. Los assets se buscan en la misma carpeta que usa el
+ * juego, que se puede cambiar con la variable de entorno BASICS_ASSETS_PATH.
+ * @return 0 si todas las imágenes coinciden.
+ */
+int main ()
+{
+    #ifdef LODEPNG_NO_COMPILE_SIMD
+        basics::log.i ("unfiltering: portable code");
+    #else
+        basics::log.i ("unfiltering: SIMD when the target supports it");
+    #endif
+
+    check_game_images      ();
+    check_generated_images ();
+
+    basics::log.i ((std::to_string (checked_images) + " images checked, " + std::to_string (failures) + " failures").c_str ());
+
+    return failures == 0 ? 0 : 1;
+}
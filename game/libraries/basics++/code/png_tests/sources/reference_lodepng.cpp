@@ -0,0 +1,98 @@
+/*
+ * REFERENCE LODEPNG
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include "reference_lodepng.hpp"
+
+// La copia de referencia de LodePNG (la que había antes de reescribir las tablas de Huffman y de
+// vectorizar los filtros) se compila dentro de su propio espacio de nombres para que pueda convivir
+// en el mismo ejecutable con la versión que se prueba. Las cabeceras estándar que usa se incluyen
+// antes para que queden fuera de ese espacio de nombres:
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace reference
+{
+    #include "../reference/lodepng.cpp"
+}
+
+namespace basics { namespace png_tests
+{
+
+    unsigned reference_encode
+    (
+        const Buffer       & image,
+        unsigned             width,
+        unsigned             height,
+        const Png_Encoding & encoding,
+        Buffer             & png
+    )
+    {
+        using namespace reference;
+
+        lodepng::State state;
+
+        LodePNGColorType color_type = LodePNGColorType(encoding.format.color_type);
+
+        state.info_raw.colortype       = color_type;
+        state.info_raw.bitdepth        = encoding.format.bit_depth;
+        state.info_png.color.colortype = color_type;
+        state.info_png.color.bitdepth  = encoding.format.bit_depth;
+
+        for (size_t index = 0; index + 3 < encoding.palette.size (); index += 4)
+        {
+            const byte * color = &encoding.palette[index];
+
+            lodepng_palette_add (&state.info_raw,       color[0], color[1], color[2], color[3]);
+            lodepng_palette_add (&state.info_png.color, color[0], color[1], color[2], color[3]);
+        }
+
+        // Se respetan el formato, los filtros y el tipo de bloque indicados en lugar de dejar que el
+        // codificador elija los que ocupen menos:
+
+        state.info_png.interlace_method     = encoding.interlaced ? 1 : 0;
+        state.encoder.auto_convert          = 0;
+        state.encoder.filter_palette_zero   = 0;
+        state.encoder.filter_strategy       = LFS_PREDEFINED;
+        state.encoder.predefined_filters    = encoding.filters.data ();
+        state.encoder.zlibsettings.btype    = encoding.block_type;
+        state.encoder.zlibsettings.use_lz77 = encoding.use_lz77;
+        state.encoder.add_id                = 0;
+
+        png.clear ();
+
+        return lodepng::encode (png, image, width, height, state);
+    }
+
+    unsigned reference_decode
+    (
+        const Buffer & png,
+        bool           keep_format,
+        Buffer       & image,
+        unsigned     & width,
+        unsigned     & height
+    )
+    {
+        using namespace reference;
+
+        lodepng::State state;
+
+        state.decoder.color_convert = keep_format ? 0 : 1;
+
+        image.clear ();
+
+        return lodepng::decode (image, width, height, state, png);
+    }
+
+}}
@@ -0,0 +1,78 @@
+/*
+ * REFERENCE LODEPNG
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_REFERENCE_LODEPNG_HEADER
+#define BASICS_REFERENCE_LODEPNG_HEADER
+
+    #include <vector>
+    #include <basics/types>
+
+    namespace basics { namespace png_tests
+    {
+
+        typedef std::vector< byte > Buffer;
+
+        /**
+         * Formato de una imagen PNG. Los tipos de color usan los mismos valores que LodePNGColorType
+         * (0 gris, 2 RGB, 3 paleta, 4 gris con alfa y 6 RGBA).
+         */
+        struct Png_Format
+        {
+            unsigned color_type;
+            unsigned bit_depth;
+        };
+
+        /**
+         * Opciones con las que se codifica una imagen de prueba.
+         */
+        struct Png_Encoding
+        {
+            Png_Format format;
+            Buffer     palette;                 ///< Colores RGBA de la paleta (solo con el tipo 3).
+            Buffer     filters;                 ///< Filtro (0 a 4) de cada fila.
+            bool       interlaced;              ///< Si se usa Adam7.
+            unsigned   block_type;              ///< Tipo de los bloques deflate (0, 1 o 2).
+            bool       use_lz77;
+        };
+
+        /**
+         * Codifica una imagen con la versión de LodePNG anterior a las optimizaciones del
+         * descompresor y de los filtros.
+         * @param image Píxeles en el formato indicado en las opciones, sin relleno al final de las
+         *     filas cuando ocupan menos de un byte.
+         * @return 0 si se pudo codificar o el código de error de LodePNG.
+         */
+        unsigned reference_encode
+        (
+            const Buffer       & image,
+            unsigned             width,
+            unsigned             height,
+            const Png_Encoding & encoding,
+            Buffer             & png
+        );
+
+        /**
+         * Decodifica una imagen con la versión de referencia de LodePNG.
+         * @param keep_format Si es true los píxeles se dejan en el formato del archivo. En otro
+         *     caso se convierten a RGBA de 8 bits.
+         * @return 0 si se pudo decodificar o el código de error de LodePNG.
+         */
+        unsigned reference_decode
+        (
+            const Buffer & png,
+            bool           keep_format,
+            Buffer       & image,
+            unsigned     & width,
+            unsigned     & height
+        );
+
+    }}
+
+#endif
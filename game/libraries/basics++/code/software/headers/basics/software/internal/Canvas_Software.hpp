@@ -0,0 +1,170 @@
+/*
+ * SOFTWARE CANVAS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_SOFTWARE_CANVAS_SOFTWARE_HEADER
+#define BASICS_SOFTWARE_CANVAS_SOFTWARE_HEADER
+
+    #include <cstdint>
+    #include <vector>
+    #include <basics/Canvas>
+    #include <basics/Color_Buffer>
+    #include <basics/Thread_Pool>
+    #include <basics/Transformation>
+
+    namespace basics { namespace software
+    {
+
+        class Context;
+
+        /**
+         * Canvas que rasteriza en la CPU sobre el Color_Buffer de un software::Context.
+         *
+         * Las operaciones de dibujado no se ejecutan de inmediato: se registran junto con el estado
+         * vigente (transformación, color, opacidad y blending) y en flush() se reparten entre
+         * baldosas (tiles) de la pantalla. Cada baldosa se rasteriza de forma independiente en un
+         * Thread_Pool respetando el orden en que se registraron las operaciones.
+         */
+        class Canvas_Software : public basics::Canvas
+        {
+        public:
+
+            static constexpr unsigned tile_size = 64;
+
+        public:
+
+            static Canvas * create (Id id, Graphics_Context::Accessor & context, const Options & options);
+
+        public:
+
+            static void enable ()
+            {
+                register_factory (ID(software), Canvas_Software::create);
+            }
+
+        private:
+
+            typedef Color_Buffer< Rgba8888 > Frame_Buffer;
+
+            /**
+             * Función lineal a·x + b·y + c evaluada en coordenadas de dispositivo (en píxeles, con
+             * el origen en la esquina superior izquierda).
+             */
+            struct Plane
+            {
+                float a, b, c;
+            };
+
+            /**
+             * Operación de dibujado registrada. Las formas se reducen a paralelogramos (quads,
+             * segmentos y puntos), cuyo interior cumple 0 <= s < 1 y 0 <= t < 1, o a triángulos,
+             * cuyo interior cumple que las tres ecuaciones de arista son >= 0.
+             */
+            struct Command
+            {
+                enum Shape
+                {
+                    CLEAR,
+                    PARALLELOGRAM,
+                    TRIANGLE
+                };
+
+                Shape                shape;
+                unsigned             layer;
+                Blending             blending;
+                const Frame_Buffer * texture;           ///< nullptr si se rellena con color.
+                Rgba8888             color;             ///< Color de relleno (opacidad incluida en alfa).
+                unsigned             opacity;           ///< Opacidad en el rango [0, 256].
+                Plane                planes[3];         ///< s y t (paralelogramo) o las aristas (triángulo).
+                Plane                texel_u;           ///< Columna del texel en función de la posición.
+                Plane                texel_v;           ///< Fila del texel en función de la posición.
+                int                  left, top;         ///< Rectángulo de píxeles afectados
+                int                  right, bottom;     ///< (right y bottom excluidos).
+            };
+
+            typedef std::vector< Command  > Command_List;
+            typedef std::vector< unsigned > Tile_Bin;
+
+        private:
+
+            Context        * context;
+            Thread_Pool      thread_pool;
+
+            Size2f           size;
+            Transformation2f transform;
+            Transformation2f device_transform;          ///< transform seguida del paso a píxeles.
+            unsigned         surface_width;
+            unsigned         surface_height;
+
+            Rgba8888         clear_color;
+            float            color[3];
+            float            opacity;
+            Blending         blending;
+            unsigned         layer;
+
+            Command_List            commands;
+            std::vector< Tile_Bin > tile_bins;
+            Tile_Bin                busy_tiles;         ///< Índices de las baldosas con trabajo.
+            unsigned                tile_columns;
+            unsigned                tile_rows;
+
+        public:
+
+            Canvas_Software(Graphics_Context::Accessor & context, const Size2u & viewport_size);
+
+        public:
+
+            void reset_state     () override;
+            void flush           () override;
+
+        public:
+
+            void set_size        (const Size2u & size) override;
+
+        public:
+
+            void set_clear_color (float r, float g, float b) override;
+            void set_color       (float r, float g, float b) override;
+            void set_opacity     (float opacity) override;
+            void set_blending    (Blending blending) override;
+            void set_layer       (unsigned layer) override;
+            void set_transform   (const Transformation2f & transform) override;
+            void apply_transform (const Transformation2f & transform) override;
+
+        public:
+
+            void clear           () override;
+            void draw_point      (const Point2f & position) override;
+            void draw_segment    (const Point2f & a, const Point2f & b) override;
+            void draw_triangle   (const Point2f & a, const Point2f & b, const Point2f & c) override;
+            void fill_triangle   (const Point2f & a, const Point2f & b, const Point2f & c) override;
+            void draw_rectangle  (const Point2f & bottom_left, const Size2f & size) override;
+            void fill_rectangle  (const Point2f & bottom_left, const Size2f & size) override;
+            void fill_rectangle  (const Point2f & where, const Size2f & size, const basics::Texture_2D * texture, int handling = CENTER) override;
+            void fill_rectangle  (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling = CENTER) override;
+
+        private:
+
+            void    update_device_transform ();
+            Point2f to_device               (const Point2f & point) const;
+            Command make_command            () const;
+
+            bool add_parallelogram  (Command & command, const Point2f & origin, const Point2f & s_edge, const Point2f & t_edge);
+            void add_textured_quad  (const Frame_Buffer & texture, const Point2f * coordinates, const Point2f * texture_uvs);
+            void add_device_segment (const Point2f & a, const Point2f & b);
+
+            void bin_commands       ();
+            void rasterize_tile     (unsigned tile_index);
+            void rasterize          (const Command & command, int left, int top, int right, int bottom, Rgba8888 * span);
+
+        };
+
+    }}
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * SOFTWARE CONTEXT
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_SOFTWARE_CONTEXT_HEADER
+#define BASICS_SOFTWARE_CONTEXT_HEADER
+
+    #include <atomic>
+    #include <basics/Color_Buffer>
+    #include <basics/Graphics_Context>
+    #include <basics/Window>
+
+    namespace basics { namespace software
+    {
+
+        /**
+         * Contexto gráfico que no necesita GPU: su superficie de dibujo es un Color_Buffer en memoria
+         * (la fila 0 corresponde al borde superior). Se puede usar como factoría del Director en
+         * lugar de opengles::Context::create.
+         */
+        class Context : public basics::Graphics_Context
+        {
+        public:
+
+            typedef Color_Buffer< Rgba8888 > Frame_Buffer;
+
+        public:
+
+            static bool create (basics::Window::Accessor & window, Graphics_Resource_Cache * cache);
+
+        private:
+
+            Frame_Buffer           frame_buffer;
+            unsigned               frame_count;
+            std::atomic< bool >    available;
+
+        public:
+
+            Context(Window & window, Graphics_Resource_Cache * cache);
+
+           ~Context()
+            {
+                finalize ();
+            }
+
+        public:
+
+            Frame_Buffer & get_frame_buffer ()
+            {
+                return frame_buffer;
+            }
+
+            /**
+             * Retorna el número de fotogramas presentados desde que se creó el contexto.
+             */
+            unsigned get_frame_count () const
+            {
+                return frame_count;
+            }
+
+        public:
+
+            Id get_id () const override
+            {
+                return ID(software);
+            }
+
+            bool is_available () const override
+            {
+                return available;
+            }
+
+            bool is_current () const override
+            {
+                return available;
+            }
+
+            void invalidate () override
+            {
+                available = false;
+            }
+
+            void suspend () override
+            {
+                available = false;
+            }
+
+            bool resume () override
+            {
+                return available = true;
+            }
+
+            unsigned get_surface_width () override
+            {
+                return frame_buffer.get_width ();
+            }
+
+            unsigned get_surface_height () override
+            {
+                return frame_buffer.get_height ();
+            }
+
+            bool set_sync_swap (bool ) override
+            {
+                return false;
+            }
+
+            bool make_current () override
+            {
+                return available;
+            }
+
+            bool release_current () override
+            {
+                return true;
+            }
+
+            void reset_viewport () override;
+            void set_viewport   (const Point2u & bottom_left, const Size2u & size) override;
+            bool flush_and_display () override;
+
+        };
+
+    }}
+
+#endif
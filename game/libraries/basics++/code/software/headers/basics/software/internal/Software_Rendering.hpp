@@ -0,0 +1,19 @@
+/*
+ * SOFTWARE RENDERING
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_SOFTWARE_RENDERING_HEADER
+#define BASICS_SOFTWARE_RENDERING_HEADER
+
+    namespace basics
+    {
+        class Software_Rendering;
+    }
+
+#endif
@@ -0,0 +1,75 @@
+/*
+ * SOFTWARE TEXTURE 2D
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version 1.0
+ * See the LICENSE file or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#ifndef BASICS_SOFTWARE_TEXTURE_2D_HEADER
+#define BASICS_SOFTWARE_TEXTURE_2D_HEADER
+
+    #include <basics/Color_Buffer>
+    #include <basics/Texture_2D>
+
+    namespace basics { namespace software
+    {
+
+        /**
+         * Textura que se muestrea directamente desde la memoria de la CPU.
+         */
+        class Texture_2D : public basics::Texture_2D
+        {
+        public:
+
+            static std::shared_ptr< basics::Texture_2D > create (Id id, Color_Buffer< Rgba8888 > & color_buffer, const Options & options = {});
+
+        public:
+
+            static void enable ()
+            {
+                register_factory (ID(software), basics::software::Texture_2D::create);
+            }
+
+        private:
+
+            Color_Buffer< Rgba8888 > color_buffer;
+
+        public:
+
+            Texture_2D(Color_Buffer< Rgba8888 > & color_buffer, unsigned width, unsigned height)
+            :
+                basics::Texture_2D(width, height)
+            {
+                this->color_buffer.width  = color_buffer.width;
+                this->color_buffer.height = color_buffer.height;
+                this->color_buffer.buffer.swap (color_buffer.buffer);
+            }
+
+            Texture_2D(const Texture_2D & ) = delete;
+
+        public:
+
+            bool initialize () override
+            {
+                return initialized = color_buffer.size () > 0;
+            }
+
+            void finalize () override
+            {
+            }
+
+        public:
+
+            const Color_Buffer< Rgba8888 > & get_color_buffer () const
+            {
+                return color_buffer;
+            }
+
+        };
+
+    }}
+
+#endif
@@ -0,0 +1,971 @@
+/*
+ * SOFTWARE CANVAS
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <basics/software/Canvas_Software>
+#include <basics/software/Context>
+#include <basics/software/Texture_2D>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+#endif
+
+namespace basics { namespace software
+{
+
+    static const Point2f normal_texture_uvs[] =
+    {
+        { 0.f, 1.f },
+        { 0.f, 0.f },
+        { 1.f, 1.f },
+        { 1.f, 0.f },
+    };
+
+    static const Point2f h_flip_texture_uvs[] =
+    {
+        { 1.f, 1.f },
+        { 1.f, 0.f },
+        { 0.f, 1.f },
+        { 0.f, 0.f },
+    };
+
+    static const Point2f v_flip_texture_uvs[] =
+    {
+        { 0.f, 0.f },
+        { 0.f, 1.f },
+        { 1.f, 0.f },
+        { 1.f, 1.f },
+    };
+
+    static const Point2f d_flip_texture_uvs[] =
+    {
+        { 1.f, 0.f },
+        { 1.f, 1.f },
+        { 0.f, 0.f },
+        { 0.f, 1.f },
+    };
+
+    // ---------------------------------------------------------------------------------------------
+    // Mezcla de tramos horizontales de píxeles. Los componentes se guardan en memoria en el orden
+    // R, G, B, A. La opacidad va en el rango [0, 256] y multiplica el alfa de cada píxel de origen.
+
+    static inline Rgba8888 pack (unsigned r, unsigned g, unsigned b, unsigned a)
+    {
+        return Rgba8888(r | (g << 8) | (b << 16) | (a << 24));
+    }
+
+    static inline unsigned component (Rgba8888 color, unsigned index)
+    {
+        return (color >> (index * 8)) & 0xFF;
+    }
+
+    static inline unsigned scaled_alpha (Rgba8888 color, unsigned opacity)
+    {
+        unsigned alpha = (component (color, 3) * opacity) >> 8;
+
+        return alpha + (alpha >> 7);                    // Lleva 255 a 256 para que opaco sea exacto
+    }
+
+    static void blend_transparency (Rgba8888 * target, const Rgba8888 * source, unsigned count, unsigned opacity)
+    {
+        unsigned index = 0;
+
+        #if defined(__SSE2__)
+
+            const __m128i zero        = _mm_setzero_si128 ();
+            const __m128i full        = _mm_set1_epi16    (256);
+            const __m128i opacity_x8  = _mm_set1_epi16    (short(opacity));
+
+            for ( ; index + 4 <= count; index += 4)
+            {
+                __m128i src    = _mm_loadu_si128 (reinterpret_cast< const __m128i * >(source + index));
+                __m128i dst    = _mm_loadu_si128 (reinterpret_cast< const __m128i * >(target + index));
+                __m128i src_lo = _mm_unpacklo_epi8 (src, zero);
+                __m128i src_hi = _mm_unpackhi_epi8 (src, zero);
+                __m128i dst_lo = _mm_unpacklo_epi8 (dst, zero);
+                __m128i dst_hi = _mm_unpackhi_epi8 (dst, zero);
+
+                __m128i alpha_lo = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (src_lo, 0xFF), 0xFF);
+                __m128i alpha_hi = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (src_hi, 0xFF), 0xFF);
+
+                alpha_lo = _mm_srli_epi16 (_mm_mullo_epi16 (alpha_lo, opacity_x8), 8);
+                alpha_hi = _mm_srli_epi16 (_mm_mullo_epi16 (alpha_hi, opacity_x8), 8);
+                alpha_lo = _mm_add_epi16  (alpha_lo, _mm_srli_epi16 (alpha_lo, 7));
+                alpha_hi = _mm_add_epi16  (alpha_hi, _mm_srli_epi16 (alpha_hi, 7));
+
+                __m128i lo = _mm_add_epi16 (_mm_mullo_epi16 (src_lo, alpha_lo), _mm_mullo_epi16 (dst_lo, _mm_sub_epi16 (full, alpha_lo)));
+                __m128i hi = _mm_add_epi16 (_mm_mullo_epi16 (src_hi, alpha_hi), _mm_mullo_epi16 (dst_hi, _mm_sub_epi16 (full, alpha_hi)));
+
+                _mm_storeu_si128 (reinterpret_cast< __m128i * >(target + index), _mm_packus_epi16 (_mm_srli_epi16 (lo, 8), _mm_srli_epi16 (hi, 8)));
+            }
+
+        #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+            const uint16x8_t full       = vdupq_n_u16 (256);
+            const uint16x8_t opacity_x8 = vdupq_n_u16 (uint16_t(opacity));
+
+            for ( ; index + 8 <= count; index += 8)
+            {
+                uint8x8x4_t src = vld4_u8 (reinterpret_cast< const uint8_t * >(source + index));
+                uint8x8x4_t dst = vld4_u8 (reinterpret_cast< const uint8_t * >(target + index));
+
+                uint16x8_t  alpha = vshrq_n_u16 (vmulq_u16 (vmovl_u8 (src.val[3]), opacity_x8), 8);
+                            alpha = vaddq_u16   (alpha, vshrq_n_u16 (alpha, 7));
+                uint16x8_t  inverse_alpha = vsubq_u16 (full, alpha);
+
+                for (int channel = 0; channel < 4; ++channel)
+                {
+                    dst.val[channel] = vshrn_n_u16
+                    (
+                        vmlaq_u16 (vmulq_u16 (vmovl_u8 (src.val[channel]), alpha), vmovl_u8 (dst.val[channel]), inverse_alpha),
+                        8
+                    );
+                }
+
+                vst4_u8 (reinterpret_cast< uint8_t * >(target + index), dst);
+            }
+
+        #endif
+
+        for ( ; index < count; ++index)
+        {
+            Rgba8888 src     = source[index];
+            Rgba8888 dst     = target[index];
+            unsigned alpha   = scaled_alpha (src, opacity);
+            unsigned inverse = 256 - alpha;
+
+            target[index] = pack
+            (
+                (component (src, 0) * alpha + component (dst, 0) * inverse) >> 8,
+                (component (src, 1) * alpha + component (dst, 1) * inverse) >> 8,
+                (component (src, 2) * alpha + component (dst, 2) * inverse) >> 8,
+                (component (src, 3) * alpha + component (dst, 3) * inverse) >> 8
+            );
+        }
+    }
+
+    static void blend_add (Rgba8888 * target, const Rgba8888 * source, unsigned count, unsigned opacity)
+    {
+        unsigned index = 0;
+
+        #if defined(__SSE2__)
+
+            const __m128i zero       = _mm_setzero_si128 ();
+            const __m128i opacity_x8 = _mm_set1_epi16    (short(opacity));
+
+            for ( ; index + 4 <= count; index += 4)
+            {
+                __m128i src    = _mm_loadu_si128 (reinterpret_cast< const __m128i * >(source + index));
+                __m128i dst    = _mm_loadu_si128 (reinterpret_cast< const __m128i * >(target + index));
+                __m128i src_lo = _mm_unpacklo_epi8 (src, zero);
+                __m128i src_hi = _mm_unpackhi_epi8 (src, zero);
+
+                __m128i alpha_lo = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (src_lo, 0xFF), 0xFF);
+                __m128i alpha_hi = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (src_hi, 0xFF), 0xFF);
+
+                alpha_lo = _mm_srli_epi16 (_mm_mullo_epi16 (alpha_lo, opacity_x8), 8);
+                alpha_hi = _mm_srli_epi16 (_mm_mullo_epi16 (alpha_hi, opacity_x8), 8);
+                alpha_lo = _mm_add_epi16  (alpha_lo, _mm_srli_epi16 (alpha_lo, 7));
+                alpha_hi = _mm_add_epi16  (alpha_hi, _mm_srli_epi16 (alpha_hi, 7));
+
+                __m128i lo = _mm_srli_epi16 (_mm_mullo_epi16 (src_lo, alpha_lo), 8);
+                __m128i hi = _mm_srli_epi16 (_mm_mullo_epi16 (src_hi, alpha_hi), 8);
+
+                _mm_storeu_si128 (reinterpret_cast< __m128i * >(target + index), _mm_adds_epu8 (dst, _mm_packus_epi16 (lo, hi)));
+            }
+
+        #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+            const uint16x8_t opacity_x8 = vdupq_n_u16 (uint16_t(opacity));
+
+            for ( ; index + 8 <= count; index += 8)
+            {
+                uint8x8x4_t src = vld4_u8 (reinterpret_cast< const uint8_t * >(source + index));
+                uint8x8x4_t dst = vld4_u8 (reinterpret_cast< const uint8_t * >(target + index));
+
+                uint16x8_t  alpha = vshrq_n_u16 (vmulq_u16 (vmovl_u8 (src.val[3]), opacity_x8), 8);
+                            alpha = vaddq_u16   (alpha, vshrq_n_u16 (alpha, 7));
+
+                for (int channel = 0; channel < 4; ++channel)
+                {
+                    dst.val[channel] = vqadd_u8 (dst.val[channel], vshrn_n_u16 (vmulq_u16 (vmovl_u8 (src.val[channel]), alpha), 8));
+                }
+
+                vst4_u8 (reinterpret_cast< uint8_t * >(target + index), dst);
+            }
+
+        #endif
+
+        for ( ; index < count; ++index)
+        {
+            Rgba8888 src   = source[index];
+            Rgba8888 dst   = target[index];
+            unsigned alpha = scaled_alpha (src, opacity);
+
+            target[index] = pack
+            (
+                std::min (255u, component (dst, 0) + ((component (src, 0) * alpha) >> 8)),
+                std::min (255u, component (dst, 1) + ((component (src, 1) * alpha) >> 8)),
+                std::min (255u, component (dst, 2) + ((component (src, 2) * alpha) >> 8)),
+                std::min (255u, component (dst, 3) + ((component (src, 3) * alpha) >> 8))
+            );
+        }
+    }
+
+    static void blend_multiply (Rgba8888 * target, const Rgba8888 * source, unsigned count, unsigned opacity)
+    {
+        // Equivale a glBlendFunc (GL_DST_COLOR, GL_ONE_MINUS_SRC_ALPHA):
+
+        for (unsigned index = 0; index < count; ++index)
+        {
+            Rgba8888 src     = source[index];
+            Rgba8888 dst     = target[index];
+            unsigned inverse = 256 - scaled_alpha (src, opacity);
+            unsigned result[4];
+
+            for (unsigned channel = 0; channel < 4; ++channel)
+            {
+                unsigned d = component (dst, channel);
+
+                result[channel] = std::min (255u, (((component (src, channel) + 1) * d) >> 8) + ((d * inverse) >> 8));
+            }
+
+            target[index] = pack (result[0], result[1], result[2], result[3]);
+        }
+    }
+
+    static void blend_none (Rgba8888 * target, const Rgba8888 * source, unsigned count, unsigned opacity)
+    {
+        if (opacity >= 256)
+        {
+            std::copy_n (source, count, target);
+        }
+        else for (unsigned index = 0; index < count; ++index)
+        {
+            Rgba8888 src = source[index];
+
+            target[index] = (src & 0x00FFFFFF) | Rgba8888(((component (src, 3) * opacity) >> 8) << 24);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    /**
+     * Recorta el intervalo [x0, x1) de modo que low <= plane(x, y) < high.
+     */
+    static inline void clip_interval (float a, float b, float c, float y, float low, float high, float & x0, float & x1)
+    {
+        float k = b * y + c;
+
+        if (a > 0.f)
+        {
+            x0 = std::max (x0, (low  - k) / a);
+            x1 = std::min (x1, (high - k) / a);
+        }
+        else if (a < 0.f)
+        {
+            x0 = std::max (x0, (high - k) / a);
+            x1 = std::min (x1, (low  - k) / a);
+        }
+        else if (k < low || k >= high)
+        {
+            x1 = x0;
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Canvas * Canvas_Software::create (Id id, Graphics_Context::Accessor & context, const Options & options)
+    {
+        if (dynamic_cast< software::Context * >(context.operator -> ()))
+        {
+            std::shared_ptr< Canvas > canvas(new Canvas_Software(context, options.size));
+
+            context->add (id, canvas);
+
+            return canvas.get ();
+        }
+
+        return nullptr;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Canvas_Software::Canvas_Software(Graphics_Context::Accessor & context, const Size2u & size)
+    :
+        context       (static_cast< software::Context * >(context.operator -> ())),
+        size          { float(size.width), float(size.height) },
+        surface_width (0),
+        surface_height(0),
+        clear_color   (pack (0, 0, 0, 255)),
+        opacity       (1.f),
+        blending      (TRANSPARENCY),
+        layer         (0),
+        tile_columns  (0),
+        tile_rows     (0)
+    {
+        color[0] = color[1] = color[2] = 1.f;
+
+        reset_state ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Canvas_Software::reset_state ()
+    {
+        blending    = TRANSPARENCY;
+        layer       = 0;
+        clear_color = pack (0, 0, 0, 255);
+
+        set_size      ({ unsigned(size.width), unsigned(size.height) });
+        set_transform (Transformation2f());
+        set_color     (1.f, 1.f, 1.f);
+        set_opacity   (1.f);
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Canvas_Software::flush ()
+    {
+        if (!commands.empty ())
+        {
+            // Las capas se respetan reordenando las operaciones de forma estable antes de repartirlas:
+
+            auto layered = [] (const Command & command) { return command.layer != 0; };
+
+            if (std::any_of (commands.begin (), commands.end (), layered))
+            {
+                std::stable_sort
+                (
+                    commands.begin (),
+                    commands.end   (),
+                    [] (const Command & a, const Command & b) { return a.layer < b.layer; }
+                );
+            }
+
+            bin_commands ();
+
+            busy_tiles.clear ();
+
+            for (unsigned index = 0; index < tile_bins.size (); ++index)
+            {
+                if (!tile_bins[index].empty ()) busy_tiles.push_back (index);
+            }
+
+            thread_pool.parallel_for
+            (
+                unsigned(busy_tiles.size ()),
+                [this] (unsigned index) { rasterize_tile (busy_tiles[index]); }
+            );
+
+            frame_statistics.draw_calls += unsigned(commands.size   ());
+            frame_statistics.batches    += unsigned(busy_tiles.size ());
+
+            commands.clear ();
+        }
+
+        Canvas::flush ();
+
+        // La superficie puede haber cambiado de tamaño entre un fotograma y el siguiente:
+
+        update_device_transform ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Canvas_Software::set_size (const Size2u & new_size)
+    {
+        size.width  = float(new_size.width );
+        size.height = float(new_size.height);
+
+        update_device_transform ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Canvas_Software::set_clear_color (float r, float g, float b)
+    {
+        clear_color = pack (unsigned(r * 255.f), unsigned(g * 255.f), unsigned(b * 255.f), 255);
+    }
+
+    void Canvas_Software::set_color (float r, float g, float b)
+    {
+        color[0] = r;
+        color[1] = g;
+        color[2] = b;
+    }
+
+    void Canvas_Software::set_opacity (float new_opacity)
+    {
+        opacity = std::max (0.f, std::min (1.f, new_opacity));
+    }
+
+    void Canvas_Software::set_blending (Blending new_blending)
+    {
+        blending = new_blending;
+    }
+
+    void Canvas_Software::set_layer (unsigned new_layer)
+    {
+        layer = new_layer;
+    }
+
+    void Canvas_Software::set_transform (const Transformation2f & new_transform)
+    {
+        transform = new_transform;
+
+        update_device_transform ();
+    }
+
+    void Canvas_Software::apply_transform (const Transformation2f & t)
+    {
+        transform = t * transform;
+
+        update_device_transform ();
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Canvas_Software::clear ()
+    {
+        // Todo lo registrado antes quedaría tapado por completo, así que se descarta:
+
+        commands.clear ();
+
+        Command command = make_command ();
+
+        command.shape    = Command::CLEAR;
+        command.layer    = 0;
+        command.blending = NONE;
+        command.color    = clear_color;
+        command.right    = int(surface_width );
+        command.bottom   = int(surface_height);
+
+        commands.push_back (command);
+    }
+
+    void Canvas_Software::draw_point (const Point2f & position)
+    {
+        Point2f device = to_device (position);
+        Command command = make_command ();
+
+        add_parallelogram (command, { device[0] - 0.5f, device[1] - 0.5f }, { 1.f, 0.f }, { 0.f, 1.f });
+    }
+
+    void Canvas_Software::draw_segment (const Point2f & a, const Point2f & b)
+    {
+        add_device_segment (to_device (a), to_device (b));
+    }
+
+    void Canvas_Software::draw_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
+    {
+        Point2f device_a = to_device (a);
+        Point2f device_b = to_device (b);
+        Point2f device_c = to_device (c);
+
+        add_device_segment (device_a, device_b);
+        add_device_segment (device_b, device_c);
+        add_device_segment (device_c, device_a);
+    }
+
+    void Canvas_Software::fill_triangle (const Point2f & a, const Point2f & b, const Point2f & c)
+    {
+        const Point2f points[] = { to_device (a), to_device (b), to_device (c) };
+
+        float area = (points[1][0] - points[0][0]) * (points[2][1] - points[0][1])
+                   - (points[1][1] - points[0][1]) * (points[2][0] - points[0][0]);
+
+        if (area == 0.f) return;
+
+        Command command = make_command ();
+
+        command.shape = Command::TRIANGLE;
+
+        // Cada arista p->q define un semiplano. El signo se ajusta para que el interior sea >= 0:
+
+        float sign = area > 0.f ? 1.f : -1.f;
+
+        for (unsigned index = 0; index < 3; ++index)
+        {
+            const Point2f & p = points[index];
+            const Point2f & q = points[(index + 1) % 3];
+
+            Plane & plane = command.planes[index];
+
+            plane.a = -(q[1] - p[1]) * sign;
+            plane.b =  (q[0] - p[0]) * sign;
+            plane.c = -(plane.a * p[0] + plane.b * p[1]);
+        }
+
+        command.left   = std::max (int(std::floor (std::min ({ points[0][0], points[1][0], points[2][0] }))), 0);
+        command.top    = std::max (int(std::floor (std::min ({ points[0][1], points[1][1], points[2][1] }))), 0);
+        command.right  = std::min (int(std::ceil  (std::max ({ points[0][0], points[1][0], points[2][0] }))), int(surface_width ));
+        command.bottom = std::min (int(std::ceil  (std::max ({ points[0][1], points[1][1], points[2][1] }))), int(surface_height));
+
+        if (command.left < command.right && command.top < command.bottom)
+        {
+            commands.push_back (command);
+        }
+    }
+
+    void Canvas_Software::draw_rectangle (const Point2f & bottom_left, const Size2f & size)
+    {
+        float left   = bottom_left[0];
+        float bottom = bottom_left[1];
+        float right  = left   + size.width;
+        float top    = bottom + size.height;
+
+        const Point2f corners[] =
+        {
+            to_device ({ left,  bottom }),
+            to_device ({ right, bottom }),
+            to_device ({ right, top    }),
+            to_device ({ left,  top    }),
+        };
+
+        for (unsigned index = 0; index < 4; ++index)
+        {
+            add_device_segment (corners[index], corners[(index + 1) % 4]);
+        }
+    }
+
+    void Canvas_Software::fill_rectangle (const Point2f & bottom_left, const Size2f & size)
+    {
+        Point2f origin       = to_device (bottom_left);
+        Point2f bottom_right = to_device ({ bottom_left[0] + size.width, bottom_left[1] });
+        Point2f top_left     = to_device ({ bottom_left[0], bottom_left[1] + size.height });
+        Command command      = make_command ();
+
+        add_parallelogram
+        (
+            command,
+            origin,
+            { bottom_right[0] - origin[0], bottom_right[1] - origin[1] },
+            { top_left    [0] - origin[0], top_left    [1] - origin[1] }
+        );
+    }
+
+    void Canvas_Software::fill_rectangle (const Point2f & where, const Size2f & size, const basics::Texture_2D * texture, int handling)
+    {
+        const software::Texture_2D * software_texture = dynamic_cast< const software::Texture_2D * >(texture);
+
+        if (software_texture)
+        {
+                  Point2f   bottom_left;
+            const Point2f * texture_uvs;
+
+            switch (handling & 0x03)
+            {
+                case LEFT:   bottom_left[0] = where[0];                  break;
+                case CENTER: bottom_left[0] = where[0] - size[0] * 0.5f; break;
+                case RIGHT:  bottom_left[0] = where[0] - size[0];        break;
+            }
+
+            switch (handling & 0x0C)
+            {
+                case TOP:    bottom_left[1] = where[1] - size[1];        break;
+                case CENTER: bottom_left[1] = where[1] - size[1] * 0.5f; break;
+                case BOTTOM: bottom_left[1] = where[1];                  break;
+            }
+
+            switch (handling & 0xF0)
+            {
+                case FLIP_HORIZONTAL:  texture_uvs = h_flip_texture_uvs; break;
+                case FLIP_VERTICAL:    texture_uvs = v_flip_texture_uvs; break;
+                case FLIP_HORIZONTAL | FLIP_VERTICAL:
+                                       texture_uvs = d_flip_texture_uvs; break;
+                default:               texture_uvs = normal_texture_uvs; break;
+            }
+
+            const Point2f coordinates[] =
+            {
+                  bottom_left,
+                { bottom_left[0],              bottom_left[1] + size.height },
+                { bottom_left[0] + size.width, bottom_left[1]               },
+                { bottom_left[0] + size.width, bottom_left[1] + size.height },
+            };
+
+            add_textured_quad (software_texture->get_color_buffer (), coordinates, texture_uvs);
+        }
+    }
+
+    void Canvas_Software::fill_rectangle (const Point2f & where, const Size2f & size, const Atlas::Slice * slice, int handling)
+    {
+        if (!slice || !slice->atlas)
+        {
+            return;
+        }
+
+        const software::Texture_2D * software_texture = dynamic_cast< const software::Texture_2D * >(slice->atlas->get_texture ().get ());
+
+        if (software_texture)
+        {
+            // Las coordenadas normalizadas del slice se calculan al asignar la textura al atlas:
+
+            Point2f bottom_left;
+            Point2f texture_uvs[] =
+            {
+                { slice->normalized_left,  slice->normalized_top    },
+                { slice->normalized_left,  slice->normalized_bottom },
+                { slice->normalized_right, slice->normalized_top    },
+                { slice->normalized_right, slice->normalized_bottom },
+            };
+
+            switch (handling & 0x03)
+            {
+                case LEFT:   bottom_left[0] = where[0];                  break;
+                case CENTER: bottom_left[0] = where[0] - size[0] * 0.5f; break;
+                case RIGHT:  bottom_left[0] = where[0] - size[0];        break;
+            }
+
+            switch (handling & 0x0C)
+            {
+                case TOP:    bottom_left[1] = where[1] - size[1];        break;
+                case CENTER: bottom_left[1] = where[1] - size[1] * 0.5f; break;
+                case BOTTOM: bottom_left[1] = where[1];                  break;
+            }
+
+            if (handling & FLIP_HORIZONTAL)
+            {
+                std::swap (texture_uvs[0][0], texture_uvs[2][0]);
+                std::swap (texture_uvs[1][0], texture_uvs[3][0]);
+            }
+
+            if (handling & FLIP_VERTICAL)
+            {
+                std::swap (texture_uvs[0][1], texture_uvs[1][1]);
+                std::swap (texture_uvs[2][1], texture_uvs[3][1]);
+            }
+
+            const Point2f coordinates[] =
+            {
+                  bottom_left,
+                { bottom_left[0],              bottom_left[1] + size.height },
+                { bottom_left[0] + size.width, bottom_left[1]               },
+                { bottom_left[0] + size.width, bottom_left[1] + size.height },
+            };
+
+            add_textured_quad (software_texture->get_color_buffer (), coordinates, texture_uvs);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Canvas_Software::update_device_transform ()
+    {
+        Frame_Buffer & frame_buffer = context->get_frame_buffer ();
+
+        surface_width  = frame_buffer.get_width  ();
+        surface_height = frame_buffer.get_height ();
+
+        // Las coordenadas del canvas tienen el origen abajo a la izquierda y las del Color_Buffer
+        // arriba a la izquierda, por lo que además de escalar se invierte el eje Y:
+
+        float scale_x = size.width  > 0.f ? surface_width  / size.width  : 1.f;
+        float scale_y = size.height > 0.f ? surface_height / size.height : 1.f;
+
+        device_transform = scale_then_translate_2d (scale_x, -scale_y, Vector2f{ 0.f, float(surface_height) }) * transform;
+    }
+
+    Point2f Canvas_Software::to_device (const Point2f & point) const
+    {
+        const Transformation2f::Matrix & matrix = device_transform.matrix;
+
+        return Point2f
+        {
+            matrix[0][0] * point[0] + matrix[0][1] * point[1] + matrix[0][2],
+            matrix[1][0] * point[0] + matrix[1][1] * point[1] + matrix[1][2]
+        };
+    }
+
+    Canvas_Software::Command Canvas_Software::make_command () const
+    {
+        Command command;
+
+        command.shape    = Command::PARALLELOGRAM;
+        command.layer    = layer;
+        command.blending = blending;
+        command.texture  = nullptr;
+        command.opacity  = 256;
+        command.color    = pack
+        (
+            unsigned(std::max (0.f, std::min (1.f, color[0])) * 255.f),
+            unsigned(std::max (0.f, std::min (1.f, color[1])) * 255.f),
+            unsigned(std::max (0.f, std::min (1.f, color[2])) * 255.f),
+            unsigned(opacity * 255.f)
+        );
+        command.texel_u  = { 0.f, 0.f, 0.f };
+        command.texel_v  = { 0.f, 0.f, 0.f };
+        command.left     = 0;
+        command.top      = 0;
+        command.right    = 0;
+        command.bottom   = 0;
+
+        return command;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Canvas_Software::add_parallelogram (Command & command, const Point2f & origin, const Point2f & s_edge, const Point2f & t_edge)
+    {
+        float determinant = s_edge[0] * t_edge[1] - s_edge[1] * t_edge[0];
+
+        if (std::abs (determinant) < 1e-6f) return false;
+
+        // Se invierte la transformación (s, t) -> origin + s * s_edge + t * t_edge:
+
+        float inverse = 1.f / determinant;
+
+        Plane & s = command.planes[0];
+        Plane & t = command.planes[1];
+
+        s.a =  t_edge[1] * inverse;
+        s.b = -t_edge[0] * inverse;
+        s.c = -(s.a * origin[0] + s.b * origin[1]);
+        t.a = -s_edge[1] * inverse;
+        t.b =  s_edge[0] * inverse;
+        t.c = -(t.a * origin[0] + t.b * origin[1]);
+
+        float xs[] = { origin[0], origin[0] + s_edge[0], origin[0] + t_edge[0], origin[0] + s_edge[0] + t_edge[0] };
+        float ys[] = { origin[1], origin[1] + s_edge[1], origin[1] + t_edge[1], origin[1] + s_edge[1] + t_edge[1] };
+
+        command.shape  = Command::PARALLELOGRAM;
+        command.left   = std::max (int(std::floor (*std::min_element (xs, xs + 4))), 0);
+        command.top    = std::max (int(std::floor (*std::min_element (ys, ys + 4))), 0);
+        command.right  = std::min (int(std::ceil  (*std::max_element (xs, xs + 4))), int(surface_width ));
+        command.bottom = std::min (int(std::ceil  (*std::max_element (ys, ys + 4))), int(surface_height));
+
+        if (command.left < command.right && command.top < command.bottom)
+        {
+            commands.push_back (command);
+
+            return true;
+        }
+
+        return false;
+    }
+
+    void Canvas_Software::add_textured_quad (const Frame_Buffer & texture, const Point2f * coordinates, const Point2f * texture_uvs)
+    {
+        frame_statistics.quads++;
+
+        if (texture.size () == 0) return;
+
+        // Los vértices llegan en el orden bottom_left, top_left, bottom_right, top_right. La
+        // coordenada s avanza de bottom_left a bottom_right y t de bottom_left a top_left:
+
+        Point2f origin       = to_device (coordinates[0]);
+        Point2f top_left     = to_device (coordinates[1]);
+        Point2f bottom_right = to_device (coordinates[2]);
+
+        Command command = make_command ();
+
+        command.texture = &texture;
+        command.color   = pack (255, 255, 255, 255);
+        command.opacity = unsigned(opacity * 256.f);
+
+        Point2f s_edge{ bottom_right[0] - origin[0], bottom_right[1] - origin[1] };
+        Point2f t_edge{ top_left    [0] - origin[0], top_left    [1] - origin[1] };
+
+        float width  = float(texture.get_width  ());
+        float height = float(texture.get_height ());
+
+        float u0 = texture_uvs[0][0] * width,  u_s = (texture_uvs[2][0] - texture_uvs[0][0]) * width,  u_t = (texture_uvs[1][0] - texture_uvs[0][0]) * width;
+        float v0 = texture_uvs[0][1] * height, v_s = (texture_uvs[2][1] - texture_uvs[0][1]) * height, v_t = (texture_uvs[1][1] - texture_uvs[0][1]) * height;
+
+        // add_parallelogram () calcula los planos s y t y registra la operación. Las coordenadas del
+        // texel se obtienen después como combinación lineal de esos planos:
+
+        if (add_parallelogram (command, origin, s_edge, t_edge))
+        {
+            Command & added = commands.back ();
+            const Plane & s = added.planes[0];
+            const Plane & t = added.planes[1];
+
+            added.texel_u = { u_s * s.a + u_t * t.a, u_s * s.b + u_t * t.b, u_s * s.c + u_t * t.c + u0 };
+            added.texel_v = { v_s * s.a + v_t * t.a, v_s * s.b + v_t * t.b, v_s * s.c + v_t * t.c + v0 };
+        }
+    }
+
+    void Canvas_Software::add_device_segment (const Point2f & a, const Point2f & b)
+    {
+        float dx     = b[0] - a[0];
+        float dy     = b[1] - a[1];
+        float length = std::sqrt (dx * dx + dy * dy);
+
+        Command command = make_command ();
+
+        if (length < 1e-6f)
+        {
+            add_parallelogram (command, { a[0] - 0.5f, a[1] - 0.5f }, { 1.f, 0.f }, { 0.f, 1.f });
+        }
+        else
+        {
+            // Las líneas se dibujan como paralelogramos de un píxel de grosor:
+
+            float nx = -dy / length;
+            float ny =  dx / length;
+
+            add_parallelogram (command, { a[0] - nx * 0.5f, a[1] - ny * 0.5f }, { dx, dy }, { nx, ny });
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Canvas_Software::bin_commands ()
+    {
+        unsigned columns = (surface_width  + tile_size - 1) / tile_size;
+        unsigned rows    = (surface_height + tile_size - 1) / tile_size;
+
+        if (columns != tile_columns || rows != tile_rows)
+        {
+            tile_columns = columns;
+            tile_rows    = rows;
+
+            tile_bins.resize (columns * rows);
+        }
+
+        // Los contenedores se vacían sin liberar su memoria para reutilizarla en cada fotograma:
+
+        for (auto & bin : tile_bins) bin.clear ();
+
+        for (unsigned index = 0, count = unsigned(commands.size ()); index < count; ++index)
+        {
+            const Command & command = commands[index];
+
+            if (command.right <= command.left || command.bottom <= command.top) continue;
+
+            unsigned first_column = unsigned(command.left) / tile_size;
+            unsigned first_row    = unsigned(command.top ) / tile_size;
+            unsigned last_column  = std::min (unsigned(command.right  - 1) / tile_size, columns - 1);
+            unsigned last_row     = std::min (unsigned(command.bottom - 1) / tile_size, rows    - 1);
+
+            for (unsigned row = first_row; row <= last_row; ++row)
+            {
+                for (unsigned column = first_column; column <= last_column; ++column)
+                {
+                    tile_bins[row * columns + column].push_back (index);
+                }
+            }
+        }
+    }
+
+    void Canvas_Software::rasterize_tile (unsigned tile_index)
+    {
+        Rgba8888 span[tile_size];
+
+        int left   = int(tile_index % tile_columns * tile_size);
+        int top    = int(tile_index / tile_columns * tile_size);
+        int right  = std::min (left + int(tile_size), int(context->get_frame_buffer ().get_width  ()));
+        int bottom = std::min (top  + int(tile_size), int(context->get_frame_buffer ().get_height ()));
+
+        for (unsigned index : tile_bins[tile_index])
+        {
+            const Command & command = commands[index];
+
+            rasterize
+            (
+                command,
+                std::max (left,   command.left  ),
+                std::max (top,    command.top   ),
+                std::min (right,  command.right ),
+                std::min (bottom, command.bottom),
+                span
+            );
+        }
+    }
+
+    void Canvas_Software::rasterize (const Command & command, int left, int top, int right, int bottom, Rgba8888 * span)
+    {
+        Frame_Buffer & frame_buffer = context->get_frame_buffer ();
+        unsigned       stride       = frame_buffer.get_width ();
+        const float    infinity     = std::numeric_limits< float >::infinity ();
+
+        for (int y = top; y < bottom; ++y)
+        {
+            Rgba8888 * row = frame_buffer.buffer.data () + y * stride;
+
+            if (command.shape == Command::CLEAR)
+            {
+                std::fill (row + left, row + right, command.color);
+                continue;
+            }
+
+            // Se buscan los píxeles de la fila cuyo centro cae dentro de la forma:
+
+            float center_y = float(y) + 0.5f;
+            float x0       = float(left );
+            float x1       = float(right);
+
+            if (command.shape == Command::PARALLELOGRAM)
+            {
+                for (unsigned index = 0; index < 2; ++index)
+                {
+                    const Plane & plane = command.planes[index];
+
+                    clip_interval (plane.a, plane.b, plane.c, center_y, 0.f, 1.f, x0, x1);
+                }
+            }
+            else
+            {
+                for (unsigned index = 0; index < 3; ++index)
+                {
+                    const Plane & plane = command.planes[index];
+
+                    clip_interval (plane.a, plane.b, plane.c, center_y, 0.f, infinity, x0, x1);
+                }
+            }
+
+            if (x1 <= x0) continue;
+
+            int first = std::max (left,  int(std::ceil (x0 - 0.5f)));
+            int last  = std::min (right, int(std::ceil (x1 - 0.5f)));
+            int count = last - first;
+
+            if (count <= 0) continue;
+
+            if (command.texture)
+            {
+                const Frame_Buffer & texture = *command.texture;
+
+                int   max_u    = int(texture.get_width  ()) - 1;
+                int   max_v    = int(texture.get_height ()) - 1;
+                float center_x = float(first) + 0.5f;
+                float u        = command.texel_u.a * center_x + command.texel_u.b * center_y + command.texel_u.c;
+                float v        = command.texel_v.a * center_x + command.texel_v.b * center_y + command.texel_v.c;
+
+                for (int index = 0; index < count; ++index, u += command.texel_u.a, v += command.texel_v.a)
+                {
+                    int texel_u = std::min (std::max (int(u), 0), max_u);
+                    int texel_v = std::min (std::max (int(v), 0), max_v);
+
+                    span[index] = texture.buffer[texel_v * (max_u + 1) + texel_u];
+                }
+            }
+            else
+            {
+                std::fill_n (span, count, command.color);
+            }
+
+            switch (command.blending)
+            {
+                case NONE:         blend_none         (row + first, span, unsigned(count), command.opacity); break;
+                case TRANSPARENCY: blend_transparency (row + first, span, unsigned(count), command.opacity); break;
+                case MULTIPLY:     blend_multiply     (row + first, span, unsigned(count), command.opacity); break;
+                case ADD:          blend_add          (row + first, span, unsigned(count), command.opacity); break;
+            }
+        }
+    }
+
+}}
@@ -0,0 +1,85 @@
+/*
+ * SOFTWARE CONTEXT
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <basics/software/Context>
+
+namespace basics { namespace software
+{
+
+    bool Context::create (basics::Window::Accessor & window, Graphics_Resource_Cache * cache)
+    {
+        if (window && window->is_available () && !window->has_graphics_context ())
+        {
+            std::shared_ptr< Graphics_Context > context(new Context(*window.operator -> (), cache));
+
+            if (window->set_graphics_context (context))
+            {
+                context->initialize ();
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    Context::Context(Window & window, Graphics_Resource_Cache * cache)
+    :
+        Graphics_Context(window, cache),
+        frame_buffer    (window.get_width (), window.get_height ()),
+        frame_count     (0)
+    {
+        available = true;
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Context::reset_viewport ()
+    {
+        unsigned width  = window.get_width  ();
+        unsigned height = window.get_height ();
+
+        if (width != frame_buffer.get_width () || height != frame_buffer.get_height ())
+        {
+            frame_buffer.resize (width, height);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    void Context::set_viewport (const Point2u & , const Size2u & size)
+    {
+        // El buffer de color siempre cubre la superficie completa, así que solo se ajusta su tamaño:
+
+        if (size.width != frame_buffer.get_width () || size.height != frame_buffer.get_height ())
+        {
+            frame_buffer.resize (size.width, size.height);
+        }
+    }
+
+    // ---------------------------------------------------------------------------------------------
+
+    bool Context::flush_and_display ()
+    {
+        if (available)
+        {
+            flush_renderers ();
+
+            frame_count++;
+
+            return true;
+        }
+
+        return false;
+    }
+
+}}
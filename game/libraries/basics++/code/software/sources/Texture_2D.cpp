@@ -0,0 +1,21 @@
+/*
+ * SOFTWARE TEXTURE 2D
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version 1.0
+ * See the LICENSE file or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <basics/software/Texture_2D>
+
+namespace basics { namespace software
+{
+
+    std::shared_ptr< basics::Texture_2D > Texture_2D::create (Id , Color_Buffer< Rgba8888 > & color_buffer, const Options & options)
+    {
+        return std::shared_ptr< Texture_2D >(new Texture_2D(color_buffer, options.width, options.height));
+    }
+
+}}
@@ -0,0 +1,28 @@
+/*
+ * ENABLE
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version 1.0
+ * See the LICENSE file or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <basics/enable>
+#include <basics/software/Canvas_Software>
+#include <basics/software/Software_Rendering>
+#include <basics/software/Texture_2D>
+
+namespace basics
+{
+
+    template< >
+    bool enable< Software_Rendering > ()
+    {
+        software::Canvas_Software::enable ();
+        software::Texture_2D::enable ();
+
+        return true;
+    }
+
+}
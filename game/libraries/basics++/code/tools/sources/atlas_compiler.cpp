@@ -0,0 +1,310 @@
+/*
+ * ATLAS COMPILER
+ * Copyright © 2018+ Ángel Rodríguez Ballesteros
+ *
+ * Distributed under the Boost Software License, version  1.0
+ * See documents/LICENSE.TXT or www.boost.org/LICENSE_1_0.txt
+ *
+ * angel.rodriguez@esne.edu
+ */
+
+#include <cctype>
+#include <cstdio>
+#include <set>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <rapidxml.hpp>
+#include <basics/Asset>
+#include <basics/Atlas>
+#include <basics/fnv>
+#include <basics/Log>
+
+using namespace basics;
+using namespace rapidxml;
+
+namespace
+{
+
+    /**
+     * Las rutas relativas de Asset se resuelven desde la carpeta de assets, pero en la línea de
+     * comandos se esperan relativas a la carpeta actual.
+     */
+    std::string get_absolute_path (const std::string & path)
+    {
+        char folder[4096];
+
+        if (path.empty () || path[0] == '/' || !getcwd (folder, sizeof(folder))) return path;
+
+        return std::string(folder) + '/' + path;
+    }
+
+    std::string replace_extension (const std::string & path, const std::string & extension)
+    {
+        size_t dot   = path.find_last_of ('.');
+        size_t slash = path.find_last_of ('/');
+
+        return (dot != std::string::npos && (slash == std::string::npos || dot > slash) ? path.substr (0, dot) : path) + extension;
+    }
+
+    bool write_file (const std::string & path, const void * data, size_t size)
+    {
+        std::FILE * file    = std::fopen (path.c_str (), "wb");
+        bool        written = file && std::fwrite (data, 1, size, file) == size;
+
+        if (file && std::fclose (file) != 0) written = false;
+
+        if (!written) log.e (std::string("ERROR: ") + path + " could not be written.");
+
+        return written;
+    }
+
+    /**
+     * Recorre los tags "dir" y "spr" igual que Atlas::parse_dir() para obtener los nombres de los
+     * slices, que el atlas no guarda (solo sus ids).
+     */
+    void collect_names (xml_node<> * dir_tag, const std::string & prefix, std::vector< std::string > & names)
+    {
+        for (xml_node<> * child = dir_tag->first_node (); child; child = child->next_sibling ())
+        {
+            xml_attribute<> * name_attribute = child->first_attribute ("name");
+
+            if (child->type () == node_element && name_attribute)
+            {
+                std::string name = prefix + name_attribute->value ();
+
+                if (child->name () == std::string("dir"))
+                {
+                    if (name == "/") name.clear (); else name += ".";
+
+                    collect_names (child, name, names);
+                }
+                else
+                if (child->name () == std::string("spr"))
+                {
+                    names.push_back (name);
+                }
+            }
+        }
+    }
+
+    bool read_names (const std::string & path, std::vector< std::string > & names)
+    {
+        std::shared_ptr< Asset > file = Asset::open (path);
+        Atlas::Buffer            data;
+
+        if (!file || !file->good () || !file->read_all (data)) return false;
+
+        data.push_back (0);
+
+        xml_document<> xml;
+
+        xml.parse< 0 > (reinterpret_cast< char * >(data.data ()));
+
+        xml_node<> *         img_tag = xml.first_node ("img");
+        xml_node<> * definitions_tag = img_tag ? img_tag->first_node ("definitions") : nullptr;
+
+        for (xml_node<> * dir_tag = definitions_tag ? definitions_tag->first_node ("dir") : nullptr; dir_tag; dir_tag = dir_tag->next_sibling ("dir"))
+        {
+            collect_names (dir_tag, std::string(), names);
+        }
+
+        return true;
+    }
+
+    /**
+     * Convierte un nombre en un identificador de C++ válido: los caracteres que no lo son se
+     * cambian por '_' y se añade '_' a los que empiezan por un dígito o son palabras reservadas.
+     */
+    std::string get_identifier (const std::string & name)
+    {
+        static const std::set< std::string > reserved
+        {
+            "and", "auto", "bool", "break", "case", "catch", "char", "class", "const", "continue",
+            "default", "delete", "do", "double", "else", "enum", "explicit", "extern", "false",
+            "float", "for", "friend", "goto", "if", "inline", "int", "long", "namespace", "new",
+            "not", "operator", "or", "private", "protected", "public", "register", "return",
+            "short", "signed", "sizeof", "static", "struct", "switch", "template", "this", "throw",
+            "true", "try", "typedef", "union", "unsigned", "using", "virtual", "void", "volatile",
+            "while", "slice_count", "slices", "matches",
+        };
+
+        std::string identifier;
+
+        for (char c : name)
+        {
+            identifier += std::isalnum (static_cast< unsigned char >(c)) ? c : '_';
+        }
+
+        if (identifier.empty () || std::isdigit (static_cast< unsigned char >(identifier[0])) || reserved.count (identifier))
+        {
+            identifier += '_';
+
+            if (std::isdigit (static_cast< unsigned char >(identifier[0]))) identifier = '_' + identifier;
+        }
+
+        return identifier;
+    }
+
+    std::string get_literal (float value)
+    {
+        char number[32];
+
+        std::snprintf (number, sizeof(number), "%.9g", value);
+
+        std::string literal(number);
+
+        if (literal.find_first_of (".e") == std::string::npos) literal += '.';
+
+        return literal + 'f';
+    }
+
+    /**
+     * Genera una cabecera con un enum con el handle de cada slice del atlas compilado y un array
+     * constexpr con sus rectángulos, en el mismo orden. Los slices se leen del atlas ya compilado
+     * para que los handles coincidan con los que tendrá al cargarlo.
+     */
+    bool write_header (const std::string & input, const std::string & atlas_path, const std::string & header_path)
+    {
+        Atlas                      atlas(atlas_path);
+        std::vector< std::string > names;
+
+        if (!read_names (input, names)) return false;
+
+        std::vector< std::string > identifiers(atlas.get_slice_count ());
+        std::vector< Id >          ids        (atlas.get_slice_count ());
+        std::set< std::string >    used;
+
+        for (const std::string & name : names)
+        {
+            Atlas::Slice_Handle handle = atlas.get_slice_handle (fnv32 (name));
+
+            if (handle != Atlas::no_slice)
+            {
+                identifiers[handle] = get_identifier (name);
+                ids        [handle] = fnv32 (name);
+            }
+        }
+
+        for (const std::string & identifier : identifiers)
+        {
+            if (identifier.empty () || !used.insert (identifier).second)
+            {
+                log.e (std::string("ERROR: the slice names of ") + input + " do not give unique identifiers.");
+
+                return false;
+            }
+        }
+
+        // El espacio de nombres se toma del nombre de la cabecera:
+
+        size_t      slash      = header_path.find_last_of ('/');
+        std::string file_name  = slash == std::string::npos ? header_path : header_path.substr (slash + 1);
+        std::string space      = get_identifier (replace_extension (file_name, ""));
+        std::string guard      = space;
+        std::string input_name = input.substr (input.find_last_of ('/') + 1);
+
+        for (char & c : guard) c = char(std::toupper (static_cast< unsigned char >(c)));
+
+        std::string text;
+        char        line[256];
+
+        text += "/*\n * Generado por basics-atlas-compiler a partir de " + input_name + ". No se debe editar.\n */\n\n";
+        text += "#ifndef " + guard + "_HEADER\n#define " + guard + "_HEADER\n\n";
+        text += "    #include <basics/Atlas>\n\n";
+        text += "    namespace " + space + "\n    {\n\n";
+        text += "        enum Slice_Index : basics::Atlas::Slice_Handle\n        {\n";
+
+        for (const std::string & identifier : identifiers)
+        {
+            text += "            " + identifier + ",\n";
+        }
+
+        text += "        };\n\n";
+        text += "        constexpr unsigned slice_count = " + std::to_string (identifiers.size ()) + ";\n\n";
+        text += "        constexpr basics::Atlas::Slice_Definition slices[slice_count] =\n        {\n";
+
+        for (Atlas::Slice_Handle handle = 0; handle < identifiers.size (); ++handle)
+        {
+            const Atlas::Slice & slice = atlas[handle];
+
+            std::snprintf
+            (
+                line, sizeof(line), "            { 0x%08xu, %s, %s, %s, %s },", ids[handle],
+                get_literal (slice.left ).c_str (), get_literal (slice.bottom).c_str (),
+                get_literal (slice.width).c_str (), get_literal (slice.height).c_str ()
+            );
+
+            text += line + std::string("    // ") + identifiers[handle] + '\n';
+        }
+
+        text += "        };\n\n";
+        text += "        inline bool matches (const basics::Atlas & atlas)\n        {\n";
+        text += "            return atlas.matches (slices, slice_count);\n        }\n\n";
+        text += "    }\n\n#endif\n";
+
+        return write_file (header_path, text.data (), text.size ());
+    }
+
+}
+
+/**
+ * Uso: basics-atlas-compiler entrada.sprites [salida.atlas] [--header salida.hpp]
+ *
+ * Convierte la definición XML de un atlas (.sprites) al formato binario que Atlas carga sin
+ * parsear. Si no se indica la salida, se guarda junto a la entrada con la extensión .atlas.
+ * La textura no se convierte: el atlas compilado guarda el mismo nombre de archivo.
+ *
+ * Con --header se genera además una cabecera con índices constantes para acceder a los slices
+ * del atlas compilado sin buscar sus ids (ver write_header()).
+ */
+int main (int argc, char * argv[])
+{
+    std::vector< std::string > arguments(argv + 1, argv + argc);
+    std::string                header;
+
+    for (size_t index = 0; index + 1 < arguments.size (); ++index)
+    {
+        if (arguments[index] == "--header")
+        {
+            header = arguments[index + 1];
+
+            arguments.erase (arguments.begin () + index, arguments.begin () + index + 2);
+
+            break;
+        }
+    }
+
+    if (arguments.empty () || arguments.size () > 2 || arguments[0] == "--header")
+    {
+        log.e ("usage: basics-atlas-compiler input.sprites [output.atlas] [--header output.hpp]");
+
+        return 2;
+    }
+
+    std::string input  = get_absolute_path (arguments[0]);
+    std::string output = arguments.size () > 1 ? get_absolute_path (arguments[1]) : replace_extension (input, ".atlas");
+
+    Atlas         atlas(input);
+    Atlas::Buffer data;
+
+    if (!atlas.write_binary (data))
+    {
+        log.e ("ERROR: " + arguments[0] + " is not a valid atlas definition.");
+
+        return 1;
+    }
+
+    if (!write_file (output, data.data (), data.size ())) return 1;
+
+    log.i (output + " written (" + std::to_string (data.size ()) + " bytes).");
+
+    if (!header.empty ())
+    {
+        if (!write_header (input, output, get_absolute_path (header))) return 1;
+
+        log.i (header + " written.");
+    }
+
+    return 0;
+}
@@ -0,0 +1,12 @@
+# Compara un archivo generado al compilar con la copia que se guarda en el repositorio (la que usan
+# las compilaciones que no lo pueden generar, como la de Android) y termina con error si difieren.
+# Uso: cmake -DGENERATED=<archivo> -DCOMMITTED=<archivo> -DSOURCE=<archivo> -DUPDATE_TARGET=<target> -P compare_generated.cmake
+
+execute_process (
+    COMMAND          ${CMAKE_COMMAND} -E compare_files ${GENERATED} ${COMMITTED}
+    RESULT_VARIABLE  DIFFERENT
+)
+
+if ( DIFFERENT )
+    message ( FATAL_ERROR "${COMMITTED} is out of date with ${SOURCE}. Run 'cmake --build <build folder> --target ${UPDATE_TARGET}' and commit the result." )
+endif ()